@@ -0,0 +1,239 @@
+// ****************************************************************************************
+/**
+ * @file   cache-bench.c
+ * @brief  Benchmarks of Clib Cache on Zipfian traces
+ *
+ * @details Every benchmark can be run alone giving its name as first argument, and the
+ *          number of distinct keys as second argument: ./cache-bench [benchmark] [keys]
+ *          Traces are 4 times longer than the number of keys. A get missing its key puts
+ *          it, as a read-through cache in front of slower storage would.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+#include "Clib.h"
+#include <math.h>
+#include <time.h>
+
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define DEFAULT_KEYS            (1000000u)
+#define KEY_LEN                 (24)
+#define TRACE_FACTOR            (4)
+
+/// Benchmark function definition
+typedef void (*BenchFunction)(unsigned int n);
+
+/// Named benchmark
+typedef struct {
+    const char *name;
+    BenchFunction run;
+} Bench;
+
+/// Trace of key indexes, with the keys they index
+typedef struct {
+    char *keys;                 //< Distinct keys, KEY_LEN bytes each
+    unsigned int *ops;          //< Key index of every get
+    size_t length;              //< Number of gets
+} Trace;
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t bench_rand(uint64_t *state) {
+    // splitmix64
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/// Fill #trace with #n * TRACE_FACTOR gets over #n keys, key of rank r drawn with weight 1 / r^#alpha
+static void make_zipf_trace(Trace *trace, unsigned int n, double alpha) {
+    trace->keys = malloc((size_t)n * KEY_LEN);
+    trace->length = (size_t)n * TRACE_FACTOR;
+    double *cdf = malloc(n * sizeof(double));
+    unsigned int *rank_key = malloc(n * sizeof(unsigned int));
+    uint64_t state = 17;
+
+    double sum = 0;
+    for (unsigned int r = 0; r < n; ++r) {
+        sum += 1.0 / pow((double)(r + 1), alpha);
+        cdf[r] = sum;
+        rank_key[r] = r;
+        snprintf(trace->keys + (size_t)r * KEY_LEN, KEY_LEN, "obj-%08x", r * 2654435761u);
+    }
+    // Ranks are given to random keys, so hot keys are spread over the key space
+    for (unsigned int r = n - 1; r > 0; --r) {
+        unsigned int j = (unsigned int)(bench_rand(&state) % (r + 1)), t = rank_key[r];
+        rank_key[r] = rank_key[j];
+        rank_key[j] = t;
+    }
+
+    trace->ops = malloc(trace->length * sizeof(unsigned int));
+    for (size_t i = 0; i < trace->length; ++i) {
+        double u = (double)(bench_rand(&state) >> 11) * 0x1.0p-53 * sum;
+        unsigned int low = 0, high = n - 1;
+        while (low < high) {
+            unsigned int mid = low + (high - low) / 2;
+            if (cdf[mid] < u)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        trace->ops[i] = rank_key[low];
+    }
+    free(rank_key);
+    free(cdf);
+}
+
+static void free_trace(Trace *trace) {
+    free(trace->keys);
+    free(trace->ops);
+}
+
+
+// ****************************************************************************************
+// run_cache
+// ****************************************************************************************
+/**
+ *  Replay #trace on a cache of #capacity entries, printing hit rate and throughput
+ */
+// ****************************************************************************************
+static void run_cache(const Trace *trace, unsigned int capacity, CachePolicy policy) {
+    Cache *cache = create_cache(capacity, policy, NULL, NULL);
+    double start = now_seconds();
+    for (size_t i = 0; i < trace->length; ++i) {
+        char *key = trace->keys + (size_t)trace->ops[i] * KEY_LEN;
+        if (!cache_get(cache, key))
+            cache_put(cache, key, key);
+    }
+    double elapsed = now_seconds() - start;
+    printf("%-6s %8u entries   hit rate %6.2f %%   %7.2f Mops/s\n",
+           policy == CACHE_LRU ? "lru" : "sieve", capacity,
+           100.0 * (double)cache->hits / (double)trace->length, (double)trace->length / elapsed * 1e-6);
+    cache_destroy(cache, NULL);
+}
+
+
+// ****************************************************************************************
+// run_by_hand
+// ****************************************************************************************
+/**
+ *  Replay #trace on an LRU built from a Hash Map and a Linked List of keys, which searches
+ *  the list on every hit to move the key to the front
+ */
+// ****************************************************************************************
+static void run_by_hand(const Trace *trace, unsigned int capacity, size_t length) {
+    HashMap *map = create_hash_map((int)capacity);
+    LinkedList *recent = create_linked_list();
+    unsigned long hits = 0;
+    double start = now_seconds();
+    for (size_t i = 0; i < length; ++i) {
+        char *key = trace->keys + (size_t)trace->ops[i] * KEY_LEN;
+        if (hash_map_get(map, key)) {
+            hits++;
+            list_move_front(recent, list_find_node(recent, key, COMPARE_STRING));
+            continue;
+        }
+        if (map->count >= capacity)
+            hash_map_remove(map, list_pop_back(recent), NULL);
+        hash_map_set(map, key, key);
+        list_push_front(recent, key);
+    }
+    double elapsed = now_seconds() - start;
+    printf("%-6s %8u entries   hit rate %6.2f %%   %7.2f Mops/s   (first %zu gets)\n",
+           "manual", capacity, 100.0 * (double)hits / (double)length,
+           (double)length / elapsed * 1e-6, length);
+    list_destroy(recent);
+    hash_map_destroy(map, NULL);
+}
+
+
+// ****************************************************************************************
+// bench_zipf
+// ****************************************************************************************
+/**
+ *  Compare LRU and SIEVE hit rates and throughput on Zipfian traces of 0.8 and 1.0
+ *  skew, with room for 0.1 %, 1 % and 10 % of the keys
+ */
+// ****************************************************************************************
+static void bench_zipf(unsigned int n) {
+    static const double ALPHAS[] = { 0.8, 1.0 };
+    static const unsigned int RATIOS[] = { 1000, 100, 10 };
+    for (size_t a = 0; a < sizeof(ALPHAS) / sizeof(ALPHAS[0]); ++a) {
+        Trace trace;
+        make_zipf_trace(&trace, n, ALPHAS[a]);
+        printf("\n-- zipf %.1f: %zu gets over %u keys --\n", ALPHAS[a], trace.length, n);
+        for (size_t r = 0; r < sizeof(RATIOS) / sizeof(RATIOS[0]); ++r) {
+            unsigned int capacity = n / RATIOS[r] ? n / RATIOS[r] : 1;
+            run_cache(&trace, capacity, CACHE_LRU);
+            run_cache(&trace, capacity, CACHE_SIEVE);
+        }
+        free_trace(&trace);
+    }
+}
+
+
+// ****************************************************************************************
+// bench_by_hand
+// ****************************************************************************************
+/**
+ *  Compare the cache against an LRU built by hand from a Hash Map and a Linked List, on
+ *  a Zipfian 1.0 trace with room for 0.1 % of the keys (the list search of the hand built
+ *  LRU limits the trace it can replay in reasonable time)
+ */
+// ****************************************************************************************
+static void bench_by_hand(unsigned int n) {
+    Trace trace;
+    make_zipf_trace(&trace, n, 1.0);
+    unsigned int capacity = n / 1000 ? n / 1000 : 1;
+    size_t length = trace.length < 200000 ? trace.length : 200000;
+    printf("\n-- by hand: zipf 1.0 over %u keys --\n", n);
+    run_by_hand(&trace, capacity, length);
+    run_cache(&trace, capacity, CACHE_LRU);
+    run_cache(&trace, capacity, CACHE_SIEVE);
+    free_trace(&trace);
+}
+
+
+static const Bench BENCHMARKS[] = {
+    { "zipf", bench_zipf },
+    { "by-hand", bench_by_hand },
+};
+
+
+int main(int argc, char *argv[]) {
+    unsigned int n = argc > 2 ? (unsigned int)strtoul(argv[2], NULL, 10) : DEFAULT_KEYS;
+    bool ran = false;
+
+    for (size_t i = 0; i < sizeof(BENCHMARKS) / sizeof(Bench); ++i) {
+        if (argc > 1 && strcmp(argv[1], "all") != 0 && strcmp(argv[1], BENCHMARKS[i].name) != 0)
+            continue;
+        BENCHMARKS[i].run(n);
+        ran = true;
+    }
+    if (!ran) {
+        fprintf(stderr, "Unknown benchmark %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,1240 @@
+// ****************************************************************************************
+/**
+ * @file   hash-map-bench.c
+ * @brief  Benchmarks of Clib Hash Map
+ *
+ * @details Every benchmark can be run alone giving its name as first argument, and the
+ *          number of keys as second argument: ./hash-map-bench [benchmark] [keys]
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+#include "Clib.h"
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define DEFAULT_KEYS            (1000000u)
+#define KEY_LEN                 (32)
+
+/// Benchmark function definition
+typedef void (*BenchFunction)(unsigned int n);
+
+/// Named benchmark
+typedef struct {
+    const char *name;
+    BenchFunction run;
+} Bench;
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t bench_rand(uint64_t *state) {
+    // splitmix64
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/// qsort comparator of doubles
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/// Generate #n session identifier like keys ("sess-" followed by 16 hex digits)
+static char *make_session_keys(unsigned int n) {
+    char *keys = malloc((size_t)n * KEY_LEN);
+    uint64_t state = 42;
+    for (unsigned int i = 0; i < n; ++i)
+        snprintf(keys + (size_t)i * KEY_LEN, KEY_LEN, "sess-%016llx",
+                 (unsigned long long)bench_rand(&state));
+    return keys;
+}
+
+/// Generate #n sequential keys ("user:0", "user:1", ...)
+static char *make_sequential_keys(unsigned int n) {
+    char *keys = malloc((size_t)n * KEY_LEN);
+    for (unsigned int i = 0; i < n; ++i)
+        snprintf(keys + (size_t)i * KEY_LEN, KEY_LEN, "user:%u", i);
+    return keys;
+}
+
+/// Resident set size of the process in bytes
+static size_t resident_bytes(void) {
+    unsigned long size = 0, resident = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm) {
+        if (fscanf(statm, "%lu %lu", &size, &resident) != 2)
+            resident = 0;
+        fclose(statm);
+    }
+    return (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/// Hash function of Clib 1.1, kept to compare against it
+static int legacy_hash_code(int size, char *key) {
+    int pos = 0;
+    for (int i = 0; i < (int)strlen(key); ++i)
+        pos += key[i];
+    return pos % size;
+}
+
+/// Report bucket distribution of #keys on #buckets buckets given a hash function
+static void report_distribution(const char *name, const char *set, char *keys,
+                                unsigned int n, unsigned int buckets, bool legacy) {
+    unsigned int *chains = calloc(buckets, sizeof(unsigned int));
+    double start = now_seconds();
+    for (unsigned int i = 0; i < n; ++i) {
+        char *key = keys + (size_t)i * KEY_LEN;
+        unsigned int pos = legacy
+            ? (unsigned int)legacy_hash_code((int)buckets, key)
+            : (unsigned int)(hash_bytes(key, strlen(key), 0x1234) % buckets);
+        chains[pos]++;
+    }
+    double elapsed = now_seconds() - start;
+
+    unsigned int max_chain = 0, empty = 0;
+    double expected = (double)n / buckets, chi = 0;
+    for (unsigned int i = 0; i < buckets; ++i) {
+        if (chains[i] > max_chain)
+            max_chain = chains[i];
+        if (!chains[i])
+            empty++;
+        chi += ((double)chains[i] - expected) * ((double)chains[i] - expected) / expected;
+    }
+    printf("%-10s %-12s max chain %8u  empty buckets %6.2f%%  chi2/dof %10.2f  %6.1f ns/key\n",
+           name, set, max_chain, 100.0 * empty / buckets, chi / (buckets - 1),
+           elapsed * 1e9 / n);
+    free(chains);
+}
+
+
+/******************************************************************************/
+/*************************** Benchmark Implementations ************************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// bench_distribution
+// ****************************************************************************************
+/**
+ *  Compare bucket distribution of the legacy additive hash against #hash_bytes
+ *
+ * A good hash gives a max chain close to the load factor and a chi2/dof close to 1.
+ */
+// ****************************************************************************************
+static void bench_distribution(unsigned int n) {
+    unsigned int buckets = n / 4 ? n / 4 : 1;
+    char *session = make_session_keys(n);
+    char *sequential = make_sequential_keys(n);
+
+    printf("\n-- distribution: %u keys on %u buckets --\n", n, buckets);
+    report_distribution("legacy", "session-id", session, n, buckets, true);
+    report_distribution("hash_bytes", "session-id", session, n, buckets, false);
+    report_distribution("legacy", "sequential", sequential, n, buckets, true);
+    report_distribution("hash_bytes", "sequential", sequential, n, buckets, false);
+
+    free(session);
+    free(sequential);
+}
+
+
+// ****************************************************************************************
+// bench_set_get
+// ****************************************************************************************
+/**
+ *  Measure insertion and lookup throughput of a Hash Map sized to the key count
+ */
+// ****************************************************************************************
+static void bench_set_get(unsigned int n) {
+    char *keys = make_session_keys(n);
+    HashMap *map = create_hash_map((int)n);
+    double start, set_time, get_time;
+    unsigned long found = 0;
+
+    start = now_seconds();
+    for (unsigned int i = 0; i < n; ++i)
+        hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+    set_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (unsigned int i = 0; i < n; ++i)
+        found += hash_map_get(map, keys + (size_t)i * KEY_LEN) != NULL;
+    get_time = now_seconds() - start;
+
+    printf("\n-- set/get: %u keys --\n", n);
+    printf("set %6.1f ns/op   get %6.1f ns/op   (found %lu)\n",
+           set_time * 1e9 / n, get_time * 1e9 / n, found);
+
+    hash_map_destroy(map, NULL);
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_set_latency
+// ****************************************************************************************
+/**
+ *  Measure per insertion latency percentiles of a map starting with a single table entry
+ *
+ * With incremental rehashing the max latency stays far from the cost of a full rehash.
+ */
+// ****************************************************************************************
+static void bench_set_latency(unsigned int n) {
+    char *keys = make_session_keys(n);
+    double *latency = malloc(n * sizeof(double));
+    HashMap *map = create_hash_map(1);
+
+    for (unsigned int i = 0; i < n; ++i) {
+        double start = now_seconds();
+        hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+        latency[i] = now_seconds() - start;
+    }
+    qsort(latency, n, sizeof(double), compare_doubles);
+
+    printf("\n-- set latency: %u keys from an empty map --\n", n);
+    printf("p50 %6.0f ns   p99 %6.0f ns   p99.9 %8.0f ns   max %10.0f ns   (%d entries)\n",
+           latency[n / 2] * 1e9, latency[(size_t)n * 99 / 100] * 1e9,
+           latency[(size_t)n * 999 / 1000] * 1e9, latency[n - 1] * 1e9, map->size);
+
+    hash_map_destroy(map, NULL);
+    free(latency);
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_engines
+// ****************************************************************************************
+/**
+ *  Compare hit and miss lookups of every Hash Map engine with the same keys
+ */
+// ****************************************************************************************
+static void bench_engines(unsigned int n) {
+    static const char *ENGINE_NAMES[] = { "chained", "swiss", "compact", "cuckoo" };
+    static const HashMapEngine ENGINES[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    char *keys = make_session_keys(2 * n);   // Second half is used for misses
+    unsigned int *order = malloc(n * sizeof(unsigned int));
+    uint64_t state = 7;
+
+    // Random lookup order, so lookups do not follow insertion order
+    for (unsigned int i = 0; i < n; ++i)
+        order[i] = i;
+    for (unsigned int i = n - 1; i > 0; --i) {
+        unsigned int j = (unsigned int)(bench_rand(&state) % (i + 1)), t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+
+    printf("\n-- engines: %u keys --\n", n);
+    for (size_t e = 0; e < sizeof(ENGINES) / sizeof(ENGINES[0]); ++e) {
+        HashMap *map = create_hash_map_engine(1, ENGINES[e]);
+        double start, set_time, hit_time, miss_time;
+        unsigned long found = 0;
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i)
+            hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+        set_time = now_seconds() - start;
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i)
+            found += hash_map_get(map, keys + (size_t)order[i] * KEY_LEN) != NULL;
+        hit_time = now_seconds() - start;
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i)
+            found += hash_map_get(map, keys + (size_t)(n + order[i]) * KEY_LEN) != NULL;
+        miss_time = now_seconds() - start;
+
+        printf("%-8s load %4.2f   set %6.1f ns/op   hit %6.1f ns/op   miss %6.1f ns/op   (found %lu)\n",
+               ENGINE_NAMES[e], (double)map->count / map->size, set_time * 1e9 / n,
+               hit_time * 1e9 / n, miss_time * 1e9 / n, found);
+        hash_map_destroy(map, NULL);
+    }
+    free(order);
+    free(keys);
+}
+
+
+/// Node layout of Clib 1.1 (key allocated apart), kept to compare against it
+typedef struct legacy_node {
+    char *key;
+    void *value;
+    struct legacy_node *next;
+} LegacyNode;
+
+/// Measure on a child process the RSS growth of storing #n keys of #key_len bytes
+static void report_memory(const char *name, unsigned int n, int key_len, bool legacy,
+                          HashMapEngine engine) {
+    pid_t pid = fork();
+    if (pid != 0) {
+        waitpid(pid, NULL, 0);
+        return;
+    }
+
+    char key[64];
+    LegacyNode **list = legacy ? calloc(n, sizeof(LegacyNode *)) : NULL;
+    HashMap *map = legacy ? NULL : create_hash_map_engine((int)n, engine);
+    size_t before = resident_bytes();
+    for (unsigned int i = 0; i < n; ++i) {
+        snprintf(key, sizeof(key), "%0*u", key_len, i);
+        if (legacy) {
+            // Two allocations per pair, as hash_map_set did
+            LegacyNode *node = malloc(sizeof(LegacyNode));
+            node->key = malloc((size_t)key_len + 1);
+            memcpy(node->key, key, (size_t)key_len + 1);
+            node->next = list[i];
+            list[i] = node;
+        } else {
+            hash_map_set(map, key, key);
+        }
+    }
+    size_t after = resident_bytes();
+    printf("%-8s key %2d bytes   %6.1f MiB per million pairs (table included)\n",
+           name, key_len, (double)(after - before) / (1024.0 * 1024.0) * 1e6 / n);
+    exit(0);
+}
+
+
+// ****************************************************************************************
+// bench_memory
+// ****************************************************************************************
+/**
+ *  Compare RSS per million pairs of Clib 1.1 node layout against current nodes and the
+ *  compact engine
+ */
+// ****************************************************************************************
+static void bench_memory(unsigned int n) {
+    static const int KEY_LENGTHS[] = { 8, 16, 24, 40 };
+    fflush(stdout);
+    printf("\n-- memory: %u pairs --\n", n);
+    fflush(stdout);
+    for (size_t i = 0; i < sizeof(KEY_LENGTHS) / sizeof(int); ++i) {
+        report_memory("legacy", n, KEY_LENGTHS[i], true, HASH_MAP_CHAINED);
+        report_memory("current", n, KEY_LENGTHS[i], false, HASH_MAP_CHAINED);
+        report_memory("compact", n, KEY_LENGTHS[i], false, HASH_MAP_COMPACT);
+    }
+}
+
+
+/// Key hash and comparator of 64 bit integer keys for the Generic Hash Map
+static uint64_t hash_uint64(const void *key) {
+    return *(const uint64_t *)key;
+}
+
+static int compare_uint64(void *pattern, void *current) {
+    return *(uint64_t *)pattern != *(uint64_t *)current;
+}
+
+
+// ****************************************************************************************
+// bench_int_keys
+// ****************************************************************************************
+/**
+ *  Compare lookups of 64 bit ids printed as strings against generic and integer maps
+ */
+// ****************************************************************************************
+static void bench_int_keys(unsigned int n) {
+    uint64_t *ids = malloc(n * sizeof(uint64_t));
+    unsigned int *order = malloc(n * sizeof(unsigned int));
+    uint64_t state = 11;
+    char key[24];
+    unsigned long found = 0;
+    double start, times[3];
+
+    for (unsigned int i = 0; i < n; ++i) {
+        ids[i] = bench_rand(&state) >> 16;
+        order[i] = i;
+    }
+    for (unsigned int i = n - 1; i > 0; --i) {
+        unsigned int j = (unsigned int)(bench_rand(&state) % (i + 1)), t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+
+    HashMap *strings = create_hash_map((int)n);
+    GenericHashMap *generic = create_generic_hash_map((int)n, hash_uint64, compare_uint64);
+    IntHashMap *ints = create_int_hash_map((int)n);
+    for (unsigned int i = 0; i < n; ++i) {
+        snprintf(key, sizeof(key), "%llu", (unsigned long long)ids[i]);
+        hash_map_set(strings, key, &ids[i]);
+        generic_hash_map_set(generic, &ids[i], &ids[i]);
+        int_hash_map_set(ints, ids[i], &ids[i]);
+    }
+
+    start = now_seconds();
+    for (unsigned int i = 0; i < n; ++i) {
+        snprintf(key, sizeof(key), "%llu", (unsigned long long)ids[order[i]]);
+        found += hash_map_get(strings, key) != NULL;
+    }
+    times[0] = now_seconds() - start;
+
+    start = now_seconds();
+    for (unsigned int i = 0; i < n; ++i)
+        found += generic_hash_map_get(generic, &ids[order[i]]) != NULL;
+    times[1] = now_seconds() - start;
+
+    start = now_seconds();
+    for (unsigned int i = 0; i < n; ++i)
+        found += int_hash_map_get(ints, ids[order[i]]) != NULL;
+    times[2] = now_seconds() - start;
+
+    printf("\n-- int-keys: %u random 48 bit ids, hits (found %lu) --\n", n, found);
+    printf("sprintf + hash_map_get   %6.1f ns/op\n", times[0] * 1e9 / n);
+    printf("generic_hash_map_get     %6.1f ns/op\n", times[1] * 1e9 / n);
+    printf("int_hash_map_get         %6.1f ns/op\n", times[2] * 1e9 / n);
+
+    hash_map_destroy(strings, NULL);
+    generic_hash_map_destroy(generic, NULL);
+    int_hash_map_destroy(ints, NULL);
+    free(order);
+    free(ids);
+}
+
+
+// ****************************************************************************************
+// bench_upsert
+// ****************************************************************************************
+/**
+ *  Compare counting events per key with get + set against a single probe get_or_insert
+ */
+// ****************************************************************************************
+static void bench_upsert(unsigned int n) {
+    static const char *ENGINE_NAMES[] = { "chained", "swiss", "compact", "cuckoo" };
+    static const HashMapEngine ENGINES[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    unsigned int distinct = n / 8 > 0 ? n / 8 : 1;
+    char *keys = make_session_keys(distinct);
+    unsigned int *events = malloc(n * sizeof(unsigned int));
+    uint64_t state = 13;
+
+    for (unsigned int i = 0; i < n; ++i)
+        events[i] = (unsigned int)(bench_rand(&state) % distinct);
+
+    printf("\n-- upsert: %u events on %u keys --\n", n, distinct);
+    for (size_t e = 0; e < sizeof(ENGINES) / sizeof(ENGINES[0]); ++e) {
+        HashMap *two_probes = create_hash_map_engine(1, ENGINES[e]);
+        HashMap *one_probe = create_hash_map_engine(1, ENGINES[e]);
+        double start, get_set_time, upsert_time;
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i) {
+            char *key = keys + (size_t)events[i] * KEY_LEN;
+            uintptr_t count = (uintptr_t)hash_map_get(two_probes, key);
+            hash_map_set(two_probes, key, (void *)(count + 1));
+        }
+        get_set_time = now_seconds() - start;
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i) {
+            void **slot = hash_map_get_or_insert(one_probe, keys + (size_t)events[i] * KEY_LEN);
+            *slot = (void *)((uintptr_t)*slot + 1);
+        }
+        upsert_time = now_seconds() - start;
+
+        printf("%-8s get + set %6.1f ns/op   get_or_insert %6.1f ns/op\n",
+               ENGINE_NAMES[e], get_set_time * 1e9 / n, upsert_time * 1e9 / n);
+        hash_map_destroy(two_probes, NULL);
+        hash_map_destroy(one_probe, NULL);
+    }
+    free(events);
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_get_many
+// ****************************************************************************************
+/**
+ *  Compare random hits with a loop of hash_map_get against hash_map_get_many
+ *
+ * @details      Use key counts whose table does not fit on L3 (a few millions) to see
+ *               the effect of overlapping cache misses.
+ */
+// ****************************************************************************************
+static void bench_get_many(unsigned int n) {
+    static const char *ENGINE_NAMES[] = { "chained", "swiss", "compact", "cuckoo" };
+    static const HashMapEngine ENGINES[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    char *keys = make_session_keys(n);
+    const char **lookups = malloc(n * sizeof(char *));
+    void **out = malloc(n * sizeof(void *));
+    uint64_t state = 17;
+
+    for (unsigned int i = 0; i < n; ++i)
+        lookups[i] = keys + (bench_rand(&state) % n) * KEY_LEN;
+
+    printf("\n-- get-many: %u keys, random hits --\n", n);
+    for (size_t e = 0; e < sizeof(ENGINES) / sizeof(ENGINES[0]); ++e) {
+        HashMap *map = create_hash_map_engine((int)n, ENGINES[e]);
+        double start, single_time, many_time;
+        unsigned long found = 0;
+
+        for (unsigned int i = 0; i < n; ++i)
+            hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i)
+            found += hash_map_get(map, lookups[i]) != NULL;
+        single_time = now_seconds() - start;
+
+        start = now_seconds();
+        hash_map_get_many(map, lookups, n, out);
+        many_time = now_seconds() - start;
+        for (unsigned int i = 0; i < n; ++i)
+            found += out[i] != NULL;
+
+        printf("%-8s get %6.1f ns/op   get_many %6.1f ns/op   (found %lu)\n",
+               ENGINE_NAMES[e], single_time * 1e9 / n, many_time * 1e9 / n, found);
+        hash_map_destroy(map, NULL);
+    }
+    free(out);
+    free(lookups);
+    free(keys);
+}
+
+
+/// Work of one thread of the concurrent benchmark
+typedef struct {
+    ConcurrentHashMap *striped;     //< Map under test, NULL to use #locked with #mutex
+    HashMap *locked;
+    pthread_mutex_t *mutex;
+    char *keys;
+    unsigned int n;                 //< Number of keys and of operations
+    unsigned int read_percent;
+    uint64_t seed;
+} ConcurrentWork;
+
+static void * concurrent_bench_worker(void *arg) {
+    ConcurrentWork *work = arg;
+    uint64_t state = work->seed;
+    unsigned long found = 0;
+    for (unsigned int i = 0; i < work->n; ++i) {
+        uint64_t r = bench_rand(&state);
+        char *key = work->keys + (r % work->n) * KEY_LEN;
+        bool read = (r >> 40) % 100 < work->read_percent;
+        if (work->striped) {
+            if (read)
+                found += concurrent_hash_map_get(work->striped, key) != NULL;
+            else
+                concurrent_hash_map_set(work->striped, key, key);
+        } else {
+            pthread_mutex_lock(work->mutex);
+            if (read)
+                found += hash_map_get(work->locked, key) != NULL;
+            else
+                hash_map_set(work->locked, key, key);
+            pthread_mutex_unlock(work->mutex);
+        }
+    }
+    return (void *)(uintptr_t)found;
+}
+
+
+// ****************************************************************************************
+// bench_concurrent
+// ****************************************************************************************
+/**
+ *  Compare throughput of a Hash Map behind one mutex against a Concurrent Hash Map,
+ *  from 1 to the number of CPUs threads, for several read/write mixes
+ */
+// ****************************************************************************************
+static void bench_concurrent(unsigned int n) {
+    static const unsigned int READ_PERCENTS[] = { 100, 90, 50 };
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int max_threads = cpus > 1 ? (unsigned int)cpus : 1;
+    char *keys = make_session_keys(n);
+    pthread_t *threads = malloc(max_threads * sizeof(pthread_t));
+    ConcurrentWork *works = malloc(max_threads * sizeof(ConcurrentWork));
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    printf("\n-- concurrent: %u keys, %u operations per thread, Mops/s --\n", n, n);
+    for (size_t r = 0; r < sizeof(READ_PERCENTS) / sizeof(READ_PERCENTS[0]); ++r) {
+        for (unsigned int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+            double mops[2];
+            for (int striped = 0; striped < 2; ++striped) {
+                ConcurrentHashMap *striped_map = striped ? create_concurrent_hash_map((int)n) : NULL;
+                HashMap *locked_map = striped ? NULL : create_hash_map((int)n);
+                for (unsigned int i = 0; i < n; i += 2) {
+                    if (striped)
+                        concurrent_hash_map_set(striped_map, keys + (size_t)i * KEY_LEN, keys);
+                    else
+                        hash_map_set(locked_map, keys + (size_t)i * KEY_LEN, keys);
+                }
+
+                double start = now_seconds();
+                for (unsigned int t = 0; t < nthreads; ++t) {
+                    works[t] = (ConcurrentWork){ striped_map, locked_map, &mutex, keys, n,
+                                                 READ_PERCENTS[r], t + 1 };
+                    pthread_create(&threads[t], NULL, concurrent_bench_worker, &works[t]);
+                }
+                for (unsigned int t = 0; t < nthreads; ++t)
+                    pthread_join(threads[t], NULL);
+                mops[striped] = (double)n * nthreads / (now_seconds() - start) / 1e6;
+
+                if (striped)
+                    concurrent_hash_map_destroy(striped_map, NULL);
+                else
+                    hash_map_destroy(locked_map, NULL);
+            }
+            printf("reads %3u%%  threads %2u   mutex %7.2f   striped %7.2f\n",
+                   READ_PERCENTS[r], nthreads, mops[0], mops[1]);
+        }
+    }
+    free(works);
+    free(threads);
+    free(keys);
+}
+
+
+/// Work of one reader thread of the RCU benchmark
+typedef struct {
+    RcuHashMap *rcu;            //< Map under test, NULL to use #striped
+    ConcurrentHashMap *striped;
+    char *keys;
+    unsigned int n;
+    uint64_t seed;
+} ReaderWork;
+
+static void * rcu_bench_reader(void *arg) {
+    ReaderWork *work = arg;
+    RcuReader *reader = work->rcu ? rcu_hash_map_register_reader(work->rcu) : NULL;
+    uint64_t state = work->seed;
+    unsigned long found = 0;
+    for (unsigned int i = 0; i < work->n; ++i) {
+        char *key = work->keys + (bench_rand(&state) % work->n) * KEY_LEN;
+        if (reader) {
+            found += rcu_hash_map_get(work->rcu, key) != NULL;
+            if ((i & 63) == 0)
+                rcu_hash_map_quiescent(work->rcu, reader);
+        } else {
+            found += concurrent_hash_map_get(work->striped, key) != NULL;
+        }
+    }
+    if (reader)
+        rcu_hash_map_unregister_reader(work->rcu, reader);
+    return (void *)(uintptr_t)found;
+}
+
+
+// ****************************************************************************************
+// bench_rcu
+// ****************************************************************************************
+/**
+ *  Compare read throughput of lock free RCU gets against striped rwlock gets, from 1 to
+ *  the number of CPUs reader threads
+ */
+// ****************************************************************************************
+static void bench_rcu(unsigned int n) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned int max_threads = cpus > 1 ? (unsigned int)cpus : 1;
+    char *keys = make_session_keys(n);
+    pthread_t *threads = malloc(max_threads * sizeof(pthread_t));
+    ReaderWork *works = malloc(max_threads * sizeof(ReaderWork));
+    RcuHashMap *rcu = create_rcu_hash_map((int)n, NULL);
+    ConcurrentHashMap *striped = create_concurrent_hash_map((int)n);
+
+    for (unsigned int i = 0; i < n; ++i) {
+        rcu_hash_map_set(rcu, keys + (size_t)i * KEY_LEN, keys);
+        concurrent_hash_map_set(striped, keys + (size_t)i * KEY_LEN, keys);
+    }
+
+    printf("\n-- rcu: %u keys, %u gets per thread, Mops/s --\n", n, n);
+    for (unsigned int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+        double mops[2];
+        for (int use_rcu = 0; use_rcu < 2; ++use_rcu) {
+            double start = now_seconds();
+            for (unsigned int t = 0; t < nthreads; ++t) {
+                works[t] = (ReaderWork){ use_rcu ? rcu : NULL, striped, keys, n, t + 1 };
+                pthread_create(&threads[t], NULL, rcu_bench_reader, &works[t]);
+            }
+            for (unsigned int t = 0; t < nthreads; ++t)
+                pthread_join(threads[t], NULL);
+            mops[use_rcu] = (double)n * nthreads / (now_seconds() - start) / 1e6;
+        }
+        printf("threads %2u   striped rwlock %7.2f   rcu %7.2f\n", nthreads, mops[0], mops[1]);
+    }
+    rcu_hash_map_destroy(rcu);
+    concurrent_hash_map_destroy(striped, NULL);
+    free(works);
+    free(threads);
+    free(keys);
+}
+
+
+static void count_visitor(const char *key, size_t key_len, void *value, void *ctx) {
+    (void)key;
+    (void)key_len;
+    (void)value;
+    ++*(unsigned long *)ctx;
+}
+
+
+// ****************************************************************************************
+// bench_scan
+// ****************************************************************************************
+/**
+ *  Compare full scans of a sparse table (#n / 64 pairs on #n entries) walking every
+ *  table entry by hand against the bitmap driven iterator and foreach
+ */
+// ****************************************************************************************
+static void bench_scan(unsigned int n) {
+    unsigned int pairs = n / 64 > 0 ? n / 64 : 1;
+    char *keys = make_session_keys(pairs);
+    HashMap *map = create_hash_map((int)n);
+    unsigned long visited[3] = { 0, 0, 0 };
+    double start, times[3];
+    HashMapIter it;
+
+    for (unsigned int i = 0; i < pairs; ++i)
+        hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+
+    start = now_seconds();
+    for (int i = 0; i < map->size; ++i) {
+        for (MapNode *node = map->list[i]; node; node = node->next)
+            visited[0]++;
+    }
+    times[0] = now_seconds() - start;
+
+    start = now_seconds();
+    hash_map_iter_begin(map, &it);
+    while (hash_map_iter_next(&it))
+        visited[1]++;
+    times[1] = now_seconds() - start;
+
+    start = now_seconds();
+    hash_map_foreach(map, count_visitor, &visited[2]);
+    times[2] = now_seconds() - start;
+
+    printf("\n-- scan: %u pairs on %d entries --\n", pairs, map->size);
+    printf("walk map->list   %8.3f ms   (%lu pairs)\n", times[0] * 1e3, visited[0]);
+    printf("iterator         %8.3f ms   (%lu pairs)\n", times[1] * 1e3, visited[1]);
+    printf("foreach          %8.3f ms   (%lu pairs)\n", times[2] * 1e3, visited[2]);
+    hash_map_destroy(map, NULL);
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_stats
+// ****************************************************************************************
+/**
+ *  Report occupancy of both engines after inserting #n session keys and looking each up
+ *  twice (one hit, one miss). Per operation counters need a build with `make STATS=1`.
+ */
+// ****************************************************************************************
+static void bench_stats(unsigned int n) {
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    static const char *names[] = { "chained", "swiss", "compact", "cuckoo" };
+    char *keys = make_session_keys(n);
+    char *misses = make_sequential_keys(n);
+
+    printf("\n-- stats: %u keys --\n", n);
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e) {
+        HashMap *map = create_hash_map_engine(16, engines[e]);
+        HashMapStats stats;
+        double start, elapsed;
+
+        for (unsigned int i = 0; i < n; ++i)
+            hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i) {
+            hash_map_get(map, keys + (size_t)i * KEY_LEN);
+            hash_map_get(map, misses + (size_t)i * KEY_LEN);
+        }
+        elapsed = now_seconds() - start;
+        hash_map_stats(map, &stats);
+
+        printf("%-8s count %u  size %d  load %.2f  max chain %u  get %.1f ns\n", names[e],
+               stats.count, stats.size, (double)stats.load_factor, stats.max_chain,
+               elapsed * 1e9 / (2.0 * n));
+        printf("         histogram");
+        for (int i = 0; i < HASH_MAP_STATS_HISTOGRAM; ++i)
+            printf(" %u", stats.chain_histogram[i]);
+        printf("\n");
+        if (stats.counters)
+            printf("         per get: %.2f probes %.2f compares   per set: %.2f probes %.2f compares\n",
+                   stats.probes_per_get, stats.compares_per_get,
+                   stats.probes_per_set, stats.compares_per_set);
+        hash_map_destroy(map, NULL);
+    }
+    free(keys);
+    free(misses);
+}
+
+
+// ****************************************************************************************
+// bench_mapped
+// ****************************************************************************************
+/**
+ *  Compare rebuilding a map of #n pairs from source keys against saving it once and
+ *  opening the mapped image, and compare lookups on both
+ */
+// ****************************************************************************************
+static void bench_mapped(unsigned int n) {
+    static const char *path = "bin/hash-map-bench.img";
+    char *keys = make_session_keys(n);
+    double start, build, save, open, get_memory, get_mapped;
+    unsigned long found = 0;
+
+    start = now_seconds();
+    HashMap *map = create_hash_map((int)n);
+    for (unsigned int i = 0; i < n; ++i)
+        hash_map_set(map, keys + (size_t)i * KEY_LEN, keys + (size_t)i * KEY_LEN);
+    build = now_seconds() - start;
+
+    start = now_seconds();
+    if (hash_map_save(map, path, &VALUE_CODEC_STRING) != CLIB_OK) {
+        fprintf(stderr, "Can not write %s\n", path);
+        hash_map_destroy(map, NULL);
+        free(keys);
+        return;
+    }
+    save = now_seconds() - start;
+
+    start = now_seconds();
+    HashMap *mapped = hash_map_open_mapped(path);
+    open = now_seconds() - start;
+
+    start = now_seconds();
+    for (unsigned int i = 0; i < n; ++i)
+        found += hash_map_get(map, keys + (size_t)i * KEY_LEN) != NULL;
+    get_memory = now_seconds() - start;
+    start = now_seconds();
+    for (unsigned int i = 0; i < n; ++i)
+        found += hash_map_get(mapped, keys + (size_t)i * KEY_LEN) != NULL;
+    get_mapped = now_seconds() - start;
+
+    printf("\n-- mapped: %u pairs --\n", n);
+    printf("build from keys  %10.3f ms\n", build * 1e3);
+    printf("save image       %10.3f ms\n", save * 1e3);
+    printf("open image       %10.3f ms\n", open * 1e3);
+    printf("get in memory    %10.1f ns/op\n", get_memory * 1e9 / n);
+    printf("get mapped       %10.1f ns/op   (%lu found)\n", get_mapped * 1e9 / n, found);
+
+    hash_map_destroy(mapped, NULL);
+    hash_map_destroy(map, NULL);
+    remove(path);
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_iterate
+// ****************************************************************************************
+/**
+ *  Compare full iterations of #n pairs, inserted in random order, on every engine
+ */
+// ****************************************************************************************
+static void bench_iterate(unsigned int n) {
+    static const char *ENGINE_NAMES[] = { "chained", "swiss", "compact", "cuckoo" };
+    static const HashMapEngine ENGINES[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    char *keys = make_session_keys(n);
+
+    printf("\n-- iterate: %u pairs --\n", n);
+    for (size_t e = 0; e < sizeof(ENGINES) / sizeof(ENGINES[0]); ++e) {
+        HashMap *map = create_hash_map_engine(16, ENGINES[e]);
+        unsigned long bytes = 0;
+        HashMapIter it;
+        for (unsigned int i = 0; i < n; ++i)
+            hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+
+        double start = now_seconds();
+        for (int round = 0; round < 10; ++round) {
+            hash_map_iter_begin(map, &it);
+            // Read every key, as a real scan would
+            while (hash_map_iter_next(&it))
+                bytes += (unsigned char)it.key[it.key_len - 1];
+        }
+        double elapsed = (now_seconds() - start) / 10;
+        printf("%-8s %8.3f ms   %6.2f ns/pair   (%lu)\n", ENGINE_NAMES[e],
+               elapsed * 1e3, elapsed * 1e9 / n, bytes);
+        hash_map_destroy(map, NULL);
+    }
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_freeze
+// ****************************************************************************************
+/**
+ *  Measure #hash_map_freeze build time, and random order lookups of the frozen table
+ *  against the chained table it was built from
+ */
+// ****************************************************************************************
+static void bench_freeze(unsigned int n) {
+    char *keys = make_session_keys(2 * n);   // Second half is used for misses
+    unsigned int *order = malloc(n * sizeof(unsigned int));
+    HashMap *map = create_hash_map_engine(1, HASH_MAP_CHAINED);
+    double start, times[2][2], freeze_time = 0;
+    uint64_t state = 13;
+
+    for (unsigned int i = 0; i < n; ++i) {
+        hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+        order[i] = i;
+    }
+    // Random lookup order, so lookups do not follow insertion order
+    for (unsigned int i = n - 1; i > 0; --i) {
+        unsigned int j = (unsigned int)(bench_rand(&state) % (i + 1)), t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+
+    printf("\n-- freeze: %u keys --\n", n);
+    for (int frozen = 0; frozen < 2; ++frozen) {
+        unsigned long found = 0;
+        if (frozen) {
+            start = now_seconds();
+            if (hash_map_freeze(map) != CLIB_OK)
+                fprintf(stderr, "Can not freeze map\n");
+            freeze_time = now_seconds() - start;
+        }
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i)
+            found += hash_map_get(map, keys + (size_t)order[i] * KEY_LEN) != NULL;
+        times[frozen][0] = now_seconds() - start;
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i)
+            found += hash_map_get(map, keys + (size_t)(n + order[i]) * KEY_LEN) != NULL;
+        times[frozen][1] = now_seconds() - start;
+        printf("%-8s hit %6.1f ns/op   miss %6.1f ns/op   (found %lu)\n", frozen ? "frozen" : "chained",
+               times[frozen][0] * 1e9 / n, times[frozen][1] * 1e9 / n, found);
+    }
+    printf("freeze   %8.3f ms\n", freeze_time * 1e3);
+    hash_map_destroy(map, NULL);
+    free(order);
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_get_latency
+// ****************************************************************************************
+/**
+ *  Measure per lookup latency percentiles of every engine, hits in random order
+ *
+ * Tail latency follows the longest probe sequence: cuckoo bounds it to two buckets.
+ */
+// ****************************************************************************************
+static void bench_get_latency(unsigned int n) {
+    static const char *ENGINE_NAMES[] = { "chained", "swiss", "compact", "cuckoo" };
+    static const HashMapEngine ENGINES[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    char *keys = make_session_keys(n);
+    double *latency = malloc(n * sizeof(double));
+    unsigned int *order = malloc(n * sizeof(unsigned int));
+    uint64_t state = 17;
+
+    // Random lookup order, so lookups do not follow insertion order
+    for (unsigned int i = 0; i < n; ++i)
+        order[i] = i;
+    for (unsigned int i = n - 1; i > 0; --i) {
+        unsigned int j = (unsigned int)(bench_rand(&state) % (i + 1)), t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+
+    printf("\n-- get latency: %u keys --\n", n);
+    for (size_t e = 0; e < sizeof(ENGINES) / sizeof(ENGINES[0]); ++e) {
+        HashMap *map = create_hash_map_engine(1, ENGINES[e]);
+        HashMapStats stats;
+        for (unsigned int i = 0; i < n; ++i)
+            hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+        hash_map_stats(map, &stats);
+
+        for (unsigned int i = 0; i < n; ++i) {
+            double start = now_seconds();
+            hash_map_get(map, keys + (size_t)order[i] * KEY_LEN);
+            latency[i] = now_seconds() - start;
+        }
+        qsort(latency, n, sizeof(double), compare_doubles);
+
+        printf("%-8s load %4.2f   p50 %5.0f ns   p99 %5.0f ns   p99.9 %6.0f ns   max %8.0f ns   (max chain %u)\n",
+               ENGINE_NAMES[e], stats.load_factor, latency[n / 2] * 1e9,
+               latency[(size_t)n * 99 / 100] * 1e9, latency[(size_t)n * 999 / 1000] * 1e9,
+               latency[n - 1] * 1e9, stats.max_chain);
+        hash_map_destroy(map, NULL);
+    }
+    free(order);
+    free(latency);
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_filter
+// ****************************************************************************************
+/**
+ *  Measure gets of every engine with 90% absent keys, without and with a Bloom filter
+ */
+// ****************************************************************************************
+static void bench_filter(unsigned int n) {
+    static const char *ENGINE_NAMES[] = { "chained", "swiss", "compact", "cuckoo" };
+    static const HashMapEngine ENGINES[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    char *keys = make_session_keys(2 * n);   // Second half is never set
+    unsigned int *lookups = malloc(n * sizeof(unsigned int));
+    uint64_t state = 19;
+
+    // One lookup out of ten is a stored key, all of them in random order
+    for (unsigned int i = 0; i < n; ++i) {
+        unsigned int key = (unsigned int)(bench_rand(&state) % n);
+        lookups[i] = bench_rand(&state) % 10 == 0 ? key : n + key;
+    }
+
+    printf("\n-- filter: %u keys, 90%% of gets miss --\n", n);
+    for (size_t e = 0; e < sizeof(ENGINES) / sizeof(ENGINES[0]); ++e) {
+        HashMap *map = create_hash_map_engine(1, ENGINES[e]);
+        for (unsigned int i = 0; i < n; ++i)
+            hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+
+        for (int filtered = 0; filtered < 2; ++filtered) {
+            HashMapStats stats;
+            unsigned long found = 0;
+            if (filtered)
+                hash_map_enable_filter(map, HASH_MAP_FILTER_BITS_PER_KEY);
+            double start = now_seconds();
+            for (unsigned int i = 0; i < n; ++i)
+                found += hash_map_get(map, keys + (size_t)lookups[i] * KEY_LEN) != NULL;
+            double elapsed = now_seconds() - start;
+            hash_map_stats(map, &stats);
+            printf("%-8s %-9s %6.1f ns/op   filter %6.1f MiB   fpr %.4f   (found %lu)\n",
+                   ENGINE_NAMES[e], filtered ? "filter" : "no filter", elapsed * 1e9 / n,
+                   (double)stats.filter_bytes / (1024.0 * 1024.0), stats.filter_fpr, found);
+        }
+        hash_map_destroy(map, NULL);
+    }
+    free(lookups);
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_build
+// ****************************************************************************************
+/**
+ *  Compare filling a map with #hash_map_set against #hash_map_build on 1 to 8 threads,
+ *  and random order lookups of both maps
+ */
+// ****************************************************************************************
+static void bench_build(unsigned int n) {
+    static const int THREADS[] = { 1, 2, 4, 8 };
+    char *keys = make_session_keys(n);
+    char **key_ptrs = malloc(n * sizeof(char *));
+    unsigned int *order = malloc(n * sizeof(unsigned int));
+    uint64_t state = 23;
+
+    for (unsigned int i = 0; i < n; ++i) {
+        key_ptrs[i] = keys + (size_t)i * KEY_LEN;
+        order[i] = i;
+    }
+    // Random lookup order, so lookups do not follow insertion order
+    for (unsigned int i = n - 1; i > 0; --i) {
+        unsigned int j = (unsigned int)(bench_rand(&state) % (i + 1)), t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+
+    printf("\n-- build: %u keys --\n", n);
+    for (size_t t = 0; t <= sizeof(THREADS) / sizeof(THREADS[0]); ++t) {
+        double start = now_seconds(), build_time, get_time;
+        HashMap *map;
+        unsigned long found = 0;
+        if (t == 0) {
+            map = create_hash_map(1);
+            for (unsigned int i = 0; i < n; ++i)
+                hash_map_set(map, key_ptrs[i], key_ptrs[i]);
+        } else {
+            map = hash_map_build((const char * const *)key_ptrs, (void **)key_ptrs, n, THREADS[t - 1]);
+        }
+        build_time = now_seconds() - start;
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i)
+            found += hash_map_get(map, key_ptrs[order[i]]) != NULL;
+        get_time = now_seconds() - start;
+
+        if (t == 0)
+            printf("set loop     %8.1f ms   get %6.1f ns/op   (found %lu)\n",
+                   build_time * 1e3, get_time * 1e9 / n, found);
+        else
+            printf("build %d thr  %8.1f ms   get %6.1f ns/op   (found %lu)\n",
+                   THREADS[t - 1], build_time * 1e3, get_time * 1e9 / n, found);
+        hash_map_destroy(map, NULL);
+    }
+    free(order);
+    free(key_ptrs);
+    free(keys);
+}
+
+
+// ****************************************************************************************
+// bench_compact
+// ****************************************************************************************
+/**
+ *  Remove 90% of #n pairs in random order, then compare foreach scans and random order
+ *  gets of the remaining pairs before and after #hash_map_compact
+ */
+// ****************************************************************************************
+static void bench_compact(unsigned int n) {
+    char *keys = make_session_keys(n);
+    unsigned int *order = malloc(n * sizeof(unsigned int));
+    HashMap *map = create_hash_map(1);
+    uint64_t state = 29;
+
+    for (unsigned int i = 0; i < n; ++i) {
+        hash_map_set(map, keys + (size_t)i * KEY_LEN, keys);
+        order[i] = i;
+    }
+    for (unsigned int i = n - 1; i > 0; --i) {
+        unsigned int j = (unsigned int)(bench_rand(&state) % (i + 1)), t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    // Survivors are the last tenth of the shuffled order, spread over every node block
+    unsigned int removed = n - n / 10;
+    for (unsigned int i = 0; i < removed; ++i)
+        hash_map_remove(map, keys + (size_t)order[i] * KEY_LEN, NULL);
+
+    printf("\n-- compact: %u pairs left of %u --\n", map->count, n);
+    for (int compacted = 0; compacted < 2; ++compacted) {
+        double start, compact_time = 0, scan_time, get_time;
+        unsigned long visited = 0;
+        if (compacted) {
+            start = now_seconds();
+            hash_map_compact(map);
+            compact_time = now_seconds() - start;
+        }
+        start = now_seconds();
+        hash_map_foreach(map, count_visitor, &visited);
+        scan_time = now_seconds() - start;
+        start = now_seconds();
+        for (unsigned int i = removed; i < n; ++i)
+            visited += hash_map_get(map, keys + (size_t)order[i] * KEY_LEN) != NULL;
+        get_time = now_seconds() - start;
+        printf("%-9s %9d entries   scan %7.3f ms   get %6.1f ns/op   compact %7.3f ms   (%lu)\n",
+               compacted ? "compacted" : "removed", map->size, scan_time * 1e3,
+               get_time * 1e9 / (n - removed), compact_time * 1e3, visited);
+    }
+    hash_map_destroy(map, NULL);
+    free(order);
+    free(keys);
+}
+
+
+/// Context of #intersect_visitor: map looked up and map receiving common keys
+typedef struct {
+    HashMap *other;
+    HashMap *result;
+} IntersectContext;
+
+static void intersect_visitor(const char *key, size_t key_len, void *value, void *ctx) {
+    IntersectContext *intersect = ctx;
+    if (hash_map_get_len(intersect->other, key, key_len))
+        hash_map_set_len(intersect->result, key, key_len, value);
+}
+
+
+// ****************************************************************************************
+// bench_join
+// ****************************************************************************************
+/**
+ *  Compare intersecting two maps of #n pairs, sharing half of their keys, with a foreach
+ *  and #hash_map_get loop against #hash_map_intersect and #hash_map_union on 1 to 8 threads
+ */
+// ****************************************************************************************
+static void bench_join(unsigned int n) {
+    static const int THREADS[] = { 1, 2, 4, 8 };
+    char *keys = make_session_keys(n + n / 2);
+    HashMap *a = create_hash_map(1), *b = create_hash_map(1);
+    for (unsigned int i = 0; i < n; ++i) {
+        hash_map_set(a, keys + (size_t)i * KEY_LEN, keys);
+        hash_map_set(b, keys + (size_t)(i + n / 2) * KEY_LEN, keys);
+    }
+
+    printf("\n-- join: two maps of %u keys, %u in common --\n", n, n - n / 2);
+    IntersectContext loop = { b, create_hash_map(1) };
+    double start = now_seconds();
+    hash_map_foreach(a, intersect_visitor, &loop);
+    printf("get loop      intersect %8.1f ms   (%u keys)\n", (now_seconds() - start) * 1e3,
+           loop.result->count);
+    hash_map_destroy(loop.result, NULL);
+
+    for (size_t t = 0; t < sizeof(THREADS) / sizeof(THREADS[0]); ++t) {
+        start = now_seconds();
+        HashMap *both = hash_map_intersect(a, b, NULL, THREADS[t]);
+        double intersect_time = now_seconds() - start;
+        start = now_seconds();
+        HashMap *any = hash_map_union(a, b, NULL, THREADS[t]);
+        double union_time = now_seconds() - start;
+        printf("%d thr         intersect %8.1f ms   union %8.1f ms   (%u / %u keys)\n", THREADS[t],
+               intersect_time * 1e3, union_time * 1e3, both->count, any->count);
+        hash_map_destroy(both, NULL);
+        hash_map_destroy(any, NULL);
+    }
+    hash_map_destroy(a, NULL);
+    hash_map_destroy(b, NULL);
+    free(keys);
+}
+
+
+static const Bench BENCHMARKS[] = {
+    { "distribution", bench_distribution },
+    { "set-get", bench_set_get },
+    { "set-latency", bench_set_latency },
+    { "engines", bench_engines },
+    { "memory", bench_memory },
+    { "int-keys", bench_int_keys },
+    { "upsert", bench_upsert },
+    { "get-many", bench_get_many },
+    { "concurrent", bench_concurrent },
+    { "rcu", bench_rcu },
+    { "scan", bench_scan },
+    { "stats", bench_stats },
+    { "mapped", bench_mapped },
+    { "iterate", bench_iterate },
+    { "freeze", bench_freeze },
+    { "get-latency", bench_get_latency },
+    { "filter", bench_filter },
+    { "build", bench_build },
+    { "compact", bench_compact },
+    { "join", bench_join },
+};
+
+
+int main(int argc, char *argv[]) {
+    unsigned int n = argc > 2 ? (unsigned int)strtoul(argv[2], NULL, 10) : DEFAULT_KEYS;
+    bool ran = false;
+
+    for (size_t i = 0; i < sizeof(BENCHMARKS) / sizeof(Bench); ++i) {
+        if (argc > 1 && strcmp(argv[1], "all") != 0 && strcmp(argv[1], BENCHMARKS[i].name) != 0)
+            continue;
+        BENCHMARKS[i].run(n);
+        ran = true;
+    }
+    if (!ran) {
+        fprintf(stderr, "Unknown benchmark %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
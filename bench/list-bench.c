@@ -0,0 +1,299 @@
+// ****************************************************************************************
+/**
+ * @file   list-bench.c
+ * @brief  Benchmarks of Clib lists
+ *
+ * @details Every benchmark can be run alone giving its name as first argument, and the
+ *          number of values as second argument: ./list-bench [benchmark] [values]
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+#include "Clib.h"
+#include <time.h>
+
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define DEFAULT_VALUES          (1000000u)
+/// Full scans timed per list
+#define SCANS                   (10)
+/// Most values indexed without finger, as every get walks half the list on average
+#define MAX_UNCACHED            (20000u)
+
+/// Benchmark function definition
+typedef void (*BenchFunction)(unsigned int n);
+
+/// Named benchmark
+typedef struct {
+    const char *name;
+    BenchFunction run;
+} Bench;
+
+/// Slab object, linked by an intrusive list or pointed by linked list nodes
+typedef struct {
+    unsigned int id;
+    ListLink link;
+} SlabItem;
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/// Comparator matching only the value given as pattern, so finds scan the whole list
+static int compare_same(void *pattern, void *current) {
+    return pattern != current;
+}
+
+
+// ****************************************************************************************
+// bench_unrolled
+// ****************************************************************************************
+/**
+ *  Compare LinkedList and UnrolledList on #n pushes, full scans with a missing pattern,
+ *  and #n pops, used as a FIFO
+ */
+// ****************************************************************************************
+static void bench_unrolled(unsigned int n) {
+    int *values = malloc(n * sizeof(int));
+    int missing = -1;
+    for (unsigned int i = 0; i < n; ++i)
+        values[i] = (int)i;
+
+    printf("\n-- unrolled: %u values --\n", n);
+    for (int unrolled = 0; unrolled < 2; ++unrolled) {
+        LinkedList *linked = unrolled ? NULL : create_linked_list();
+        UnrolledList *chunks = unrolled ? create_unrolled_list() : NULL;
+        unsigned long popped = 0;
+
+        double start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i) {
+            if (unrolled)
+                unrolled_list_push_back(chunks, &values[i]);
+            else
+                list_push_back(linked, &values[i]);
+        }
+        double push_time = now_seconds() - start;
+
+        start = now_seconds();
+        for (int s = 0; s < SCANS; ++s) {
+            if (unrolled)
+                popped += unrolled_list_find(chunks, &missing, compare_same) != NULL;
+            else
+                popped += list_find_node(linked, &missing, compare_same) != NULL;
+        }
+        double scan_time = (now_seconds() - start) / SCANS;
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i)
+            popped += (unrolled ? unrolled_list_pop_front(chunks) : list_pop_front(linked)) != NULL;
+        double pop_time = now_seconds() - start;
+
+        printf("%-9s push %6.1f ns/op   scan %6.2f ns/value   pop %6.1f ns/op   (%lu)\n",
+               unrolled ? "unrolled" : "linked", push_time * 1e9 / n, scan_time * 1e9 / n,
+               pop_time * 1e9 / n, popped);
+        if (unrolled)
+            unrolled_list_destroy(chunks, NULL);
+        else
+            list_destroy(linked);
+    }
+    free(values);
+}
+
+
+// ****************************************************************************************
+// bench_indexed
+// ****************************************************************************************
+/**
+ *  Compare a loop getting every position of a LinkedList by index, with and without the
+ *  finger of the previous get, against the same loop with an iterator
+ */
+// ****************************************************************************************
+static void bench_indexed(unsigned int n) {
+    int *values = malloc(n * sizeof(int));
+    LinkedList *list = create_linked_list();
+    unsigned int uncached = n < MAX_UNCACHED ? n : MAX_UNCACHED;
+    unsigned long sum = 0;
+    for (unsigned int i = 0; i < n; ++i) {
+        values[i] = (int)i;
+        list_push_back(list, &values[i]);
+    }
+
+    printf("\n-- indexed: %u values --\n", n);
+    double start = now_seconds();
+    for (unsigned int i = 0; i < uncached; ++i) {
+        // Forgetting the finger walks from the nearest end, as gets did before it
+        list->finger = NULL;
+        sum += (unsigned int)*(int *)list_get_element(list, i * (n / uncached));
+    }
+    double elapsed = now_seconds() - start;
+    printf("%-9s %8.1f ns/value   (%u values)\n", "no finger", elapsed * 1e9 / uncached, uncached);
+
+    start = now_seconds();
+    for (unsigned int i = 0; i < n; ++i)
+        sum += (unsigned int)*(int *)list_get_element(list, i);
+    elapsed = now_seconds() - start;
+    printf("%-9s %8.1f ns/value\n", "finger", elapsed * 1e9 / n);
+
+    ListIterator it;
+    start = now_seconds();
+    list_iter_begin(list, &it);
+    while (list_iter_next(&it))
+        sum += (unsigned int)*(int *)it.value;
+    elapsed = now_seconds() - start;
+    printf("%-9s %8.1f ns/value   (%lu)\n", "iterator", elapsed * 1e9 / n, sum);
+
+    while (!list_is_empty(list))
+        list_pop_front(list);
+    list_destroy(list);
+    free(values);
+}
+
+
+// ****************************************************************************************
+// bench_small
+// ****************************************************************************************
+/**
+ *  Create #n small lists of 4 values each, allocated one by one and embedded on an array
+ *  with #list_init, then pop every value and free them
+ */
+// ****************************************************************************************
+static void bench_small(unsigned int n) {
+    int values[4] = { 0, 1, 2, 3 };
+    unsigned long popped = 0;
+
+    printf("\n-- small: %u lists of 4 values --\n", n);
+    for (int embedded = 0; embedded < 2; ++embedded) {
+        LinkedList **lists = embedded ? NULL : malloc(n * sizeof(LinkedList *));
+        LinkedList *storage = embedded ? malloc(n * sizeof(LinkedList)) : NULL;
+
+        double start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i) {
+            LinkedList *list = embedded ? &storage[i] : (lists[i] = create_linked_list());
+            if (embedded)
+                list_init(list);
+            for (int v = 0; v < 4; ++v)
+                list_push_back(list, &values[v]);
+        }
+        double create_time = now_seconds() - start;
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i) {
+            LinkedList *list = embedded ? &storage[i] : lists[i];
+            while (list_pop_front(list))
+                popped++;
+            if (!embedded)
+                list_destroy(list);
+        }
+        double drain_time = now_seconds() - start;
+
+        printf("%-9s create %6.1f ns/list   drain %6.1f ns/list   (%lu)\n",
+               embedded ? "embedded" : "malloced", create_time * 1e9 / n, drain_time * 1e9 / n, popped);
+        free(lists);
+        free(storage);
+    }
+}
+
+
+// ****************************************************************************************
+// bench_intrusive
+// ****************************************************************************************
+/**
+ *  Compare LinkedList and IntrusiveList on #n objects of a slab: pushes, full scans reading
+ *  every object, and pops, used as a FIFO
+ */
+// ****************************************************************************************
+static void bench_intrusive(unsigned int n) {
+    SlabItem *slab = malloc(n * sizeof(SlabItem));
+    for (unsigned int i = 0; i < n; ++i)
+        slab[i].id = i;
+
+    printf("\n-- intrusive: %u objects --\n", n);
+    for (int intrusive = 0; intrusive < 2; ++intrusive) {
+        LinkedList *linked = intrusive ? NULL : create_linked_list();
+        IntrusiveList links;
+        unsigned long sum = 0;
+        intrusive_list_init(&links);
+
+        double start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i) {
+            if (intrusive)
+                intrusive_list_push_back(&links, &slab[i].link);
+            else
+                list_push_back(linked, &slab[i]);
+        }
+        double push_time = now_seconds() - start;
+
+        start = now_seconds();
+        for (int s = 0; s < SCANS; ++s) {
+            if (intrusive) {
+                for (ListLink *l = intrusive_list_get_first(&links); l; l = intrusive_list_next(&links, l))
+                    sum += CONTAINER_OF(l, SlabItem, link)->id;
+            } else {
+                ListIterator it;
+                list_iter_begin(linked, &it);
+                while (list_iter_next(&it))
+                    sum += ((SlabItem *)it.value)->id;
+            }
+        }
+        double scan_time = (now_seconds() - start) / SCANS;
+
+        start = now_seconds();
+        for (unsigned int i = 0; i < n; ++i) {
+            if (intrusive)
+                sum += CONTAINER_OF(intrusive_list_pop_front(&links), SlabItem, link)->id;
+            else
+                sum += ((SlabItem *)list_pop_front(linked))->id;
+        }
+        double pop_time = now_seconds() - start;
+
+        printf("%-9s push %6.1f ns/op   scan %6.2f ns/value   pop %6.1f ns/op   (%lu)\n",
+               intrusive ? "intrusive" : "linked", push_time * 1e9 / n, scan_time * 1e9 / n,
+               pop_time * 1e9 / n, sum);
+        if (!intrusive)
+            list_destroy(linked);
+    }
+    free(slab);
+}
+
+
+static const Bench BENCHMARKS[] = {
+    { "unrolled", bench_unrolled },
+    { "indexed", bench_indexed },
+    { "small", bench_small },
+    { "intrusive", bench_intrusive },
+};
+
+
+int main(int argc, char *argv[]) {
+    unsigned int n = argc > 2 ? (unsigned int)strtoul(argv[2], NULL, 10) : DEFAULT_VALUES;
+    bool ran = false;
+
+    for (size_t i = 0; i < sizeof(BENCHMARKS) / sizeof(Bench); ++i) {
+        if (argc > 1 && strcmp(argv[1], "all") != 0 && strcmp(argv[1], BENCHMARKS[i].name) != 0)
+            continue;
+        BENCHMARKS[i].run(n);
+        ran = true;
+    }
+    if (!ran) {
+        fprintf(stderr, "Unknown benchmark %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -31,6 +31,9 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
 
 // ****************************************************************************************
 // ****************************** Definitions & Constants *********************************
@@ -45,6 +48,10 @@
     (ptr) = NULL;     \
 } while(0)
 
+/// Pointer to the #type structure holding #member at #ptr
+#define CONTAINER_OF(ptr, type, member) \
+    ((type *)(void *)((char *)(ptr) - offsetof(type, member)))
+
 
 
 //=======================================================================================//
@@ -66,6 +73,24 @@ extern ContentComparator COMPARE_DOUBLE;
 extern ContentComparator COMPARE_STRING;
 extern ContentComparator COMPARE_POINTER;
 
+
+// ****************************************************************************************
+// hash_bytes
+// ****************************************************************************************
+/**
+ *  Calculate a 64 bit hash of #len bytes starting at #data
+ * @param[in]    data  Pointer to the bytes to be hashed (no alignment required)
+ * @param[in]    len   Number of bytes to hash
+ * @param[in]    seed  Seed of the hash, different seeds give independent hash functions
+ * @param[out]   none
+ * @return       64 bit hash value
+ *
+ * @details      wyhash based implementation, it consumes the input 8 bytes at a time and
+ *               mixes them with 64x64->128 bit multiplications.
+ */
+// ****************************************************************************************
+uint64_t hash_bytes(const void *data, size_t len, uint64_t seed);
+
 //=======================================================================================//
 //                                                                                       //
 //                               Linked List API                                         //
@@ -85,23 +110,35 @@ struct list_node{
 /// External Linked List node definition
 typedef struct list_node ListNode;
 
-/// Linked List structure
+/// Linked List structure. Nodes point to the sentinels inside it, so an initialiced list
+/// must not be copied or moved
 typedef struct{
-    ListNode* head;             //< Pointer to list head (this will not point to any content)
-    ListNode* tail;             //< Pointer to list tail (this will not point to any content)
+    ListNode head;              //< List head sentinel (this will not point to any content)
+    ListNode tail;              //< List tail sentinel (this will not point to any content)
     unsigned int size;                   //< Current Linked List size (could be calculated but this increase performance)
+    ListNode* finger;           //< Node of the last #list_get_element call (NULL if unknown)
+    unsigned int finger_index;  //< Position of #finger
 } LinkedList;
 
+/// Cursor over the nodes of a Linked List
+typedef struct{
+    LinkedList *list;           //< List being iterated
+    ListNode *node;             //< Current node (head or tail sentinel out of the list)
+    void *value;                //< Value of current node
+    bool removed;               //< Node after #node was just removed, #it sits between both
+} ListIterator;
+
 
 
 // ****************************************************************************************
-// create_linked_list
+// list_init
 // ****************************************************************************************
 /**
- *  Initialice linked list
- * @param[in]    none
+ *  Initialice linked list on caller owned storage (embedded on another structure, on the
+ *  stack...), which must be released with #list_clear instead of #list_destroy
+ * @param[in]    list  Linked list to initialice
  * @param[out]   none
- * @return       valid pointer to linked list structure
+ * @return       none
  *
  * @details
  *
@@ -115,6 +152,22 @@ typedef struct{
  *                 ----------           ----------
  */
 // ****************************************************************************************
+void list_init(LinkedList *list);
+
+
+// ****************************************************************************************
+// create_linked_list
+// ****************************************************************************************
+/**
+ *  Initialice linked list
+ * @param[in]    none
+ * @param[out]   none
+ * @return       valid pointer to linked list structure, NULL if it can not be allocated
+ *
+ * @details      Sentinels are part of the list structure, so this is the only allocation
+ *               made until the first value is inserted.
+ */
+// ****************************************************************************************
 LinkedList *create_linked_list(void);
 
 
@@ -305,6 +358,11 @@ bool list_is_empty(LinkedList *list);
  * @param[in]    position  Position inside list
  * @param[out]   none
  * @return       Element on given position
+ *
+ * @details      The walk starts from the nearest of the first node, the last node and the
+ *               node of the previous call (the finger), so getting positions in order costs
+ *               a single step each. Inserting or removing nodes away from the list ends
+ *               forgets the finger.
  */
 // ****************************************************************************************
 void * list_get_element(LinkedList *list, unsigned int position);
@@ -404,218 +462,2191 @@ void list_print(LinkedList *list, void (*print_func)(void *));
 
 
 
+// ****************************************************************************************
+// list_remove_node
+// ****************************************************************************************
+/**
+ *  Unlink #node from #list and free it, returning its content
+ * @param[in]    list  Linked list owning #node
+ * @param[in]    node  Node to remove (not the head or tail sentinels)
+ * @param[out]   none
+ * @return       Pointer to data stored on #node
+ *
+ * @details      Constant time: neighbours of #node are relinked, no search is done.
+ */
+// ****************************************************************************************
+void * list_remove_node(LinkedList *list, ListNode *node);
+
+
+// ****************************************************************************************
+// list_move_front
+// ****************************************************************************************
+/**
+ *  Move #node to the first position of #list
+ * @param[in]    list  Linked list owning #node
+ * @param[in]    node  Node to move (not the head or tail sentinels)
+ * @param[out]   none
+ * @return       none
+ *
+ * @details      Constant time, #node is relinked instead of freed and allocated again, so
+ *               pointers to it stay valid.
+ */
+// ****************************************************************************************
+void list_move_front(LinkedList *list, ListNode *node);
+
+
+// ****************************************************************************************
+// list_iter_begin
+// ****************************************************************************************
+/**
+ *  Place #it before the first node of #list
+ * @param[in]    list       Linked list to iterate
+ * @param[out]   it         Iterator to initialice
+ * @return       none
+ *
+ * @details      Nodes are visited on list order, one step each:
+ *
+ *                   ListIterator it;
+ *                   list_iter_begin(list, &it);
+ *                   while (list_iter_next(&it))
+ *                       use(it.value);
+ *
+ *               Removing the current node through #list_iter_remove keeps the iterator
+ *               valid, removing any other node of #list may not.
+ */
+// ****************************************************************************************
+void list_iter_begin(LinkedList *list, ListIterator *it);
+
+
+// ****************************************************************************************
+// list_iter_end
+// ****************************************************************************************
+/**
+ *  Place #it after the last node of #list, to iterate it backwards with #list_iter_prev
+ * @param[in]    list       Linked list to iterate
+ * @param[out]   it         Iterator to initialice
+ * @return       none
+ */
+// ****************************************************************************************
+void list_iter_end(LinkedList *list, ListIterator *it);
+
+
+// ****************************************************************************************
+// list_iter_next
+// ****************************************************************************************
+/**
+ *  Move #it to the next node of its list
+ * @param[in]    it         Iterator initialiced by #list_iter_begin or #list_iter_end
+ * @return       true if #it points to a node (value on it->value) \n
+ *               false if #it went past the last node
+ */
+// ****************************************************************************************
+bool list_iter_next(ListIterator *it);
+
+
+// ****************************************************************************************
+// list_iter_prev
+// ****************************************************************************************
+/**
+ *  Move #it to the previous node of its list
+ * @param[in]    it         Iterator initialiced by #list_iter_begin or #list_iter_end
+ * @return       true if #it points to a node (value on it->value) \n
+ *               false if #it went past the first node
+ */
+// ****************************************************************************************
+bool list_iter_prev(ListIterator *it);
+
+
+// ****************************************************************************************
+// list_iter_remove
+// ****************************************************************************************
+/**
+ *  Remove the current node of #it from its list
+ * @param[in]    it         Iterator pointing to a node
+ * @return       Pointer to data stored on the removed node (NULL if #it points to none, or
+ *               its node was already removed)
+ *
+ * @details      #it is left between the neighbours of the removed node, so
+ *               #list_iter_next goes on with the node that followed it and #list_iter_prev
+ *               with the node that preceded it.
+ */
+// ****************************************************************************************
+void * list_iter_remove(ListIterator *it);
+
+
+// ****************************************************************************************
+// list_clear
+// ****************************************************************************************
+/**
+ *  Free every node of #list, leaving it empty
+ * @param[in]    list  Linked list to be cleared
+ * @param[out]   none
+ * @return       none
+ *
+ * @details      Contents are not freed. Lists initialiced by #list_init must be cleared
+ *               before their storage goes away.
+ */
+// ****************************************************************************************
+void list_clear(LinkedList *list);
+
+
 void list_destroy(LinkedList *list);
 
 //=======================================================================================//
 //                                                                                       //
-//                                  Hash Map API                                         //
+//                              Intrusive List API                                       //
 //                                                                                       //
 //=======================================================================================//
 
-/// Private Hash Map node
-struct hashmap_node{
-    char* key;                  //< Key of key-value pair
-    void* value;                //< Value of key-value pair
-    struct hashmap_node* next;  //< Next Node on the single linked list chain
+
+/********************************** STRUCTURES **************************************/
+
+/// Link embedded on every object of an Intrusive List
+struct list_link{
+    struct list_link* prev;     //< Pointer to previous link (towards the first object)
+    struct list_link* next;     //< Pointer to next link (towards the last object)
 };
 
-/// Public definition of Hash Map Node
-typedef struct hashmap_node MapNode;
+/// External Intrusive List link definition
+typedef struct list_link ListLink;
 
-/// Hash Map structure
+/// Intrusive List structure. Links point to the sentinel inside it, so an initialiced list
+/// must not be copied or moved
 typedef struct{
-    int size;                   //< Fixed size of hash map (number of table entries)
-    MapNode **list;             //< Table of list nodes
-} HashMap;
+    ListLink root;              //< Sentinel: #root.next is the first link, #root.prev the last
+    unsigned int size;          //< Current Intrusive List size
+} IntrusiveList;
 
 
 // ****************************************************************************************
-// create_hash_map
+// intrusive_list_init
 // ****************************************************************************************
 /**
- *  Initialice a Hash Map with a fixed #size
- * @param[in]    size  Size for the Hash Map
+ *  Initialice intrusive list on caller owned storage
+ * @param[in]    list  Intrusive list to initialice
  * @param[out]   none
- * @return       Pointer to a valid Hash Map structure
+ * @return       none
  *
- * @details
+ * @details      Objects are linked through a #ListLink member instead of list nodes, so
+ *               no function of this API allocates memory, and objects are reached back
+ *               from their links with #CONTAINER_OF:
  *
- * Hash Map initial state:
+ *                   typedef struct { int id; ListLink link; } Job;
  *
- *  |---------|
- *  |         |
- *  |    x----+-----> NULL
- *  |         |
- *  |---------|
- *  |---------|
- *  |         |
- *  |    x----+-----> NULL
- *  |         |
- *  |---------|
- *  |---------|
- *  |         |
- *  |    x----+-----> NULL
- *  |         |
- *  |---------|
+ *                   intrusive_list_push_back(&queue, &job->link);
+ *                   ListLink *link = intrusive_list_pop_front(&queue);
+ *                   if (link){
+ *                       Job *next = CONTAINER_OF(link, Job, link);
+ *                       ...
+ *                   }
  *
+ *               A link belongs to one list at a time. Objects on several lists need a
+ *               link for each of them.
  */
 // ****************************************************************************************
-HashMap * create_hash_map(int size);
+void intrusive_list_init(IntrusiveList *list);
 
 
 // ****************************************************************************************
-// hash_map_set
+// intrusive_list_push_front
 // ****************************************************************************************
 /**
- *  Set a key-value pair on #map. If key already exist, update its value
- * @param[in]    map        Hash Map to be set
- * @param[in]    key        Key of pair key-value
- * @param[in]    value      Value of pair key-value
- * @return       Pointer to previous value if #key already exists, or NULL in other case
- *
- * @details
- *
- * Hash Map initial state:                          Hash Map after #hash_map_set:
- *
- *  |---------|                                    |---------|
- *  |         |                                    |         |
- *  |    x----+-----> NULL                         |    x----+-----> NULL
- *  |         |                                    |         |
- *  |---------|                                    |---------|
- *  |---------|                                    |---------|       -----------------
- *  |         |                                    |         |       | #Key | #Value |
- *  |    x----+-----> NULL                         |    x----+-----> -----------------
- *  |         |                                    |         |       |   Next  x-----+---> NULL
- *  |---------|                                    |---------|       -----------------
- *  |---------|                                    |---------|
- *  |         |                                    |         |
- *  |    x----+-----> NULL                         |    x----+-----> NULL
- *  |         |                                    |         |
- *  |---------|                                    |---------|
- *
- * Collision case: if a collision happens, new node is inserted in the BEGINING of the list given current position
- *
- * Hash Map initial state:                          Hash Map after #hash_map_set (collision case):
- *
- *  |---------|       ---------------              |---------|       -----------------      ---------------
- *  |         |       | Key | Value |              |         |       | #Key | #Value |      | Key | Value |
- *  |    x----+-----> ---------------              |    x----+-----> -----------------   -->---------------
- *  |         |       |   Next  x---+----> NULL    |         |       |   Next  x-----+---|  |   Next  x---+---> NULL
- *  |---------|       ---------------              |---------|       -----------------      ---------------
- *  |---------|       ---------------              |---------|       ---------------
- *  |         |       | Key | Value |              |         |       | Key | Value |
- *  |    x----+-----> ---------------              |    x----+-----> ---------------
- *  |         |       |   Next  x---+----> NULL    |         |       |   Next  x---+-----> NULL
- *  |---------|       ---------------              |---------|       ---------------
- *  |---------|                                    |---------|
- *  |         |                                    |         |
- *  |    x----+-----> NULL                         |    x----+-----> NULL
- *  |         |                                    |         |
- *  |---------|                                    |---------|
+ *  Link #link on the first position of #list
+ * @param[in]    list  Intrusive list to insert #link
+ * @param[in]    link  Link of the object to insert (not on any list)
+ * @param[out]   none
+ * @return       none
  */
 // ****************************************************************************************
-void * hash_map_set(HashMap *map, char *key, void *value);
+void intrusive_list_push_front(IntrusiveList *list, ListLink *link);
 
 
 // ****************************************************************************************
-// hash_map_remove
+// intrusive_list_push_back
 // ****************************************************************************************
 /**
- *  Remove a key-value pair on #map given a #key
- * @param[in]    map        Hash Map to remove pair
- * @param[in]    key        Key of pair key-value to be removed
- * @param[in]    free_value Function to free value
- * @return       CLIB_OK    if key exist \n
- *               CLIB_ERROR if key does not exist
- *
- * @notes        If value to be removed is needed, use #hash_map_pop insetead
- * @details
- *
- * Hash Map initial state:                          Hash Map after #hash_map_remove:
- *
- *  |---------|                                   |---------|
- *  |         |                                   |         |
- *  |    x----+-----> NULL                        |    x----+-----> NULL
- *  |         |                                   |         |
- *  |---------|                                   |---------|
- *  |---------|       ----------------            |---------|
- *  |         |       | #Key | Value |            |         |
- *  |    x----+-----> ----------------            |    x----+-----> NULL
- *  |         |       |   Next  x----+---> NULL   |         |
- *  |---------|       ----------------            |---------|
- *  |---------|                                   |---------|
- *  |         |                                   |         |
- *  |    x----+-----> NULL                        |    x----+-----> NULL
- *  |         |                                   |         |
- *  |---------|                                   |---------|
- *
- * Collision case: if a collision happens, new node is inserted in the BEGINING of the list given current position
- *
- * Hash Map initial state:                                              Hash Map after #hash_map_remove (collision case):
- *
- *  |---------|       ----------------      ---------------           |---------|       ---------------
- *  |         |       | #Key | Value |      | Key | Value |           |         |       | Key | Value |
- *  |    x----+-----> ----------------   -->---------------           |    x----+-----> ---------------
- *  |         |       |   Next  x----+---|  |   Next  x---+---> NULL  |         |       |   Next  x---+----> NULL
- *  |---------|       ----------------      ---------------           |---------|       ---------------
- *  |---------|       ---------------                                 |---------|       ---------------
- *  |         |       | Key | Value |                                 |         |       | Key | Value |
- *  |    x----+-----> ---------------                                 |    x----+-----> ---------------
- *  |         |       |   Next  x---+-----> NULL                      |         |       |   Next  x---+----> NULL
- *  |---------|       ---------------                                 |---------|       ---------------
- *  |---------|                                                       |---------|
- *  |         |                                                       |         |
- *  |    x----+-----> NULL                                            |    x----+-----> NULL
- *  |         |                                                       |         |
- *  |---------|                                                       |---------|
+ *  Link #link on the last position of #list
+ * @param[in]    list  Intrusive list to insert #link
+ * @param[in]    link  Link of the object to insert (not on any list)
+ * @param[out]   none
+ * @return       none
  */
 // ****************************************************************************************
-int hash_map_remove(HashMap *map, char *key, void (*free_value)(void *));
+void intrusive_list_push_back(IntrusiveList *list, ListLink *link);
 
 
 // ****************************************************************************************
-// hash_map_pop
+// intrusive_list_pop_front
 // ****************************************************************************************
 /**
- *  Remove a key-value pair on #map given a #key and return value
- * @param[in]    map        Hash Map to remove pair
- * @param[in]    key        Key of pair key-value to be removed
- * @param[in]    free_value Function to free value
- * @return       CLIB_OK    if key exist \n
- *               CLIB_ERROR if key does not exist
- *
- * @details      Very similar to #hash_map_remove
+ *  Unlink the first link of #list, returning it
+ * @param[in]    list  Intrusive list to pop first link
+ * @param[out]   none
+ * @return       First link of #list (NULL if list is empty)
  */
 // ****************************************************************************************
-void * hash_map_pop(HashMap *map, char *key);
+ListLink * intrusive_list_pop_front(IntrusiveList *list);
 
 
 // ****************************************************************************************
-// hash_map_get
+// intrusive_list_pop_back
 // ****************************************************************************************
 /**
- *  Get a key-value pair on #map given a #key
- * @param[in]    map        Hash Map to obtain value
- * @param[in]    key        Key of pair key-value to obtain
- * @return       Pointer value if #key exists, or NULL if it does not exist
+ *  Unlink the last link of #list, returning it
+ * @param[in]    list  Intrusive list to pop last link
+ * @param[out]   none
+ * @return       Last link of #list (NULL if list is empty)
  */
 // ****************************************************************************************
-void * hash_map_get(HashMap *map, char *key);
+ListLink * intrusive_list_pop_back(IntrusiveList *list);
 
 
 // ****************************************************************************************
-// hash_map_print
+// intrusive_list_remove
 // ****************************************************************************************
 /**
- *  Print all elements on #map starting from the first position of the map,
- * iterating over every list node on position given a print function
- * @param[in]    map         Hash Map to be printed
- * @param[in]    print_func  Function pointer to print value
+ *  Unlink #link from #list
+ * @param[in]    list  Intrusive list owning #link
+ * @param[in]    link  Link to remove
+ * @param[out]   none
+ * @return       none
+ *
+ * @details      Constant time: neighbours of #link are relinked, no search is done.
+ */
+// ****************************************************************************************
+void intrusive_list_remove(IntrusiveList *list, ListLink *link);
+
+
+// ****************************************************************************************
+// intrusive_list_get_first
+// ****************************************************************************************
+/**
+ *  Get the first link of #list without unlinking it
+ * @param[in]    list  Intrusive list to get first link
+ * @param[out]   none
+ * @return       First link of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_get_first(IntrusiveList *list);
+
+
+// ****************************************************************************************
+// intrusive_list_get_last
+// ****************************************************************************************
+/**
+ *  Get the last link of #list without unlinking it
+ * @param[in]    list  Intrusive list to get last link
+ * @param[out]   none
+ * @return       Last link of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_get_last(IntrusiveList *list);
+
+
+// ****************************************************************************************
+// intrusive_list_next
+// ****************************************************************************************
+/**
+ *  Get the link following #link on #list
+ * @param[in]    list  Intrusive list owning #link
+ * @param[in]    link  Current link
+ * @param[out]   none
+ * @return       Next link (NULL if #link is the last one)
+ *
+ * @details      Visiting every object of #list:
+ *
+ *                   for (ListLink *l = intrusive_list_get_first(list); l; l = intrusive_list_next(list, l))
+ *                       use(CONTAINER_OF(l, Job, link));
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_next(IntrusiveList *list, ListLink *link);
+
+
+// ****************************************************************************************
+// intrusive_list_prev
+// ****************************************************************************************
+/**
+ *  Get the link preceding #link on #list
+ * @param[in]    list  Intrusive list owning #link
+ * @param[in]    link  Current link
+ * @param[out]   none
+ * @return       Previous link (NULL if #link is the first one)
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_prev(IntrusiveList *list, ListLink *link);
+
+
+// ****************************************************************************************
+// intrusive_list_get_size
+// ****************************************************************************************
+/**
+ *  Get the list current size
+ * @param[in]    list  Intrusive list to obtain current size
+ * @param[out]   none
+ * @return       Size of list
+ */
+// ****************************************************************************************
+unsigned int intrusive_list_get_size(IntrusiveList *list);
+
+
+// ****************************************************************************************
+// intrusive_list_is_empty
+// ****************************************************************************************
+/**
+ *  Check if #list is empty
+ * @param[in]    list  Intrusive list to check if is empty
+ * @param[out]   none
+ * @return       List empty
+ */
+// ****************************************************************************************
+bool intrusive_list_is_empty(IntrusiveList *list);
+
+
+
+//=======================================================================================//
+//                                                                                       //
+//                               Unrolled List API                                       //
+//                                                                                       //
+//=======================================================================================//
+
+
+/********************************** STRUCTURES **************************************/
+
+/// Bytes of every chunk of an Unrolled List: 8 cache lines
+#define UNROLLED_LIST_CHUNK_BYTES       (512)
+/// Values per chunk: whatever fits after the chunk links and indexes (61 on 64 bit)
+#define UNROLLED_LIST_CHUNK_ITEMS       ((UNROLLED_LIST_CHUNK_BYTES - 2 * sizeof(void *) - \
+                                          2 * sizeof(uint32_t)) / sizeof(void *))
+
+/// Chunk of consecutive values of an Unrolled List
+struct unrolled_chunk{
+    struct unrolled_chunk* prev;    //< Pointer to previous chunk (towards the first value)
+    struct unrolled_chunk* next;    //< Pointer to next chunk (towards the last value)
+    uint32_t start;                 //< Index of the first value on #items
+    uint32_t count;                 //< Number of values, on #items[start, start + count)
+    void *items[UNROLLED_LIST_CHUNK_ITEMS];
+};
+
+/// External Unrolled List chunk definition
+typedef struct unrolled_chunk UnrolledChunk;
+
+/// Unrolled List structure
+typedef struct{
+    UnrolledChunk* first;       //< Chunk holding the first value (NULL if list is empty)
+    UnrolledChunk* last;        //< Chunk holding the last value (NULL if list is empty)
+    UnrolledChunk* spare;       //< Empty chunk kept for next push needing one (may be NULL)
+    unsigned int size;          //< Current Unrolled List size
+} UnrolledList;
+
+
+// ****************************************************************************************
+// create_unrolled_list
+// ****************************************************************************************
+/**
+ *  Initialice unrolled list
+ * @param[in]    none
+ * @param[out]   none
+ * @return       valid pointer to unrolled list structure, NULL if it can not be allocated
+ *
+ * @details      Same FIFO / LIFO API than #LinkedList, but values are stored on cache
+ *               aligned chunks of #UNROLLED_LIST_CHUNK_ITEMS consecutive pointers instead
+ *               of one node per value:
+ *
+ *                  first                                     last
+ *               ----------------        ----------------        ----------------
+ *               | .. v0 v1 v2  | <----> | v3 ... vN+2  | <----> | vN+3 vN+4 .. |
+ *               ----------------        ----------------        ----------------
+ *                                        N = #UNROLLED_LIST_CHUNK_ITEMS
+ *
+ *               The first chunk fills from its end and the last one from its start, so
+ *               pushes on both sides never move values, and a chunk is allocated every
+ *               #UNROLLED_LIST_CHUNK_ITEMS pushes only. One emptied chunk is kept as spare,
+ *               so pushing and popping around a chunk boundary does not allocate either.
+ *               Scans read values as arrays, one cache miss every 8 values instead of one
+ *               per value.
+ */
+// ****************************************************************************************
+UnrolledList * create_unrolled_list(void);
+
+
+// ****************************************************************************************
+// unrolled_list_push_front
+// ****************************************************************************************
+/**
+ *  Insert #value on the first position of #list
+ * @param[in]    list  Unrolled list to insert #value
+ * @param[in]    value Pointer to data to be stored on the first position of list
+ * @param[out]   none
+ * @return       CLIB_OK    if #value is inserted \n
+ *               CLIB_ERROR if a new chunk can not be allocated
+ */
+// ****************************************************************************************
+int unrolled_list_push_front(UnrolledList *list, void *value);
+
+
+// ****************************************************************************************
+// unrolled_list_push_back
+// ****************************************************************************************
+/**
+ *  Insert #value on the last position of #list
+ * @param[in]    list  Unrolled list to insert #value
+ * @param[in]    value Pointer to data to be stored on the last position of list
+ * @param[out]   none
+ * @return       CLIB_OK    if #value is inserted \n
+ *               CLIB_ERROR if a new chunk can not be allocated
+ */
+// ****************************************************************************************
+int unrolled_list_push_back(UnrolledList *list, void *value);
+
+
+// ****************************************************************************************
+// unrolled_list_pop_front
+// ****************************************************************************************
+/**
+ *  Extract first value of #list, returning it
+ * @param[in]    list  Unrolled list to pop first value
+ * @param[out]   none
+ * @return       Pointer to data stored on the first position of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+void * unrolled_list_pop_front(UnrolledList *list);
+
+
+// ****************************************************************************************
+// unrolled_list_pop_back
+// ****************************************************************************************
+/**
+ *  Extract last value of #list, returning it
+ * @param[in]    list  Unrolled list to pop last value
+ * @param[out]   none
+ * @return       Pointer to data stored on the last position of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+void * unrolled_list_pop_back(UnrolledList *list);
+
+
+// ****************************************************************************************
+// unrolled_list_get_first
+// ****************************************************************************************
+/**
+ *  Get the first value of #list without extracting it
+ * @param[in]    list  Unrolled list to get first value
+ * @param[out]   none
+ * @return       Pointer to data stored on the first position of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+void * unrolled_list_get_first(UnrolledList *list);
+
+
+// ****************************************************************************************
+// unrolled_list_get_last
+// ****************************************************************************************
+/**
+ *  Get the last value of #list without extracting it
+ * @param[in]    list  Unrolled list to get last value
+ * @param[out]   none
+ * @return       Pointer to data stored on the last position of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+void * unrolled_list_get_last(UnrolledList *list);
+
+
+// ****************************************************************************************
+// unrolled_list_get_size
+// ****************************************************************************************
+/**
+ *  Get the list current size
+ * @param[in]    list  Unrolled list to obtain current size
+ * @param[out]   none
+ * @return       Size of list
+ */
+// ****************************************************************************************
+unsigned int unrolled_list_get_size(UnrolledList *list);
+
+
+// ****************************************************************************************
+// unrolled_list_is_empty
+// ****************************************************************************************
+/**
+ *  Check if #list is empty
+ * @param[in]    list  Unrolled list to check if is empty
+ * @param[out]   none
+ * @return       List empty
+ */
+// ****************************************************************************************
+bool unrolled_list_is_empty(UnrolledList *list);
+
+
+// ****************************************************************************************
+// unrolled_list_get_element
+// ****************************************************************************************
+/**
+ *  Get element of list given a #position
+ * @param[in]    list      Unrolled list to get element
+ * @param[in]    position  Position inside list
+ * @param[out]   none
+ * @return       Element on given position (NULL if #position is out of the list)
+ *
+ * @details      Whole chunks are skipped, from the closest end of the list.
+ */
+// ****************************************************************************************
+void * unrolled_list_get_element(UnrolledList *list, unsigned int position);
+
+
+// ****************************************************************************************
+// unrolled_list_find
+// ****************************************************************************************
+/**
+ *  Find and return first #list value which match pattern
+ * @param[in]    list       Unrolled list to find value
+ * @param[in]    pattern    Content to find
+ * @param[in]    comparator Function which compares contents
+ * @param[out]   none
+ * @return       First value matching given #pattern (NULL if there is none)
+ */
+// ****************************************************************************************
+void * unrolled_list_find(UnrolledList *list, void *pattern, ContentComparator comparator);
+
+
+// ****************************************************************************************
+// unrolled_list_print
+// ****************************************************************************************
+/**
+ *  Print all list elements starting from the first element given a print function
+ * @param[in]    list        Unrolled list to be printed
+ * @param[in]    print_func  Function pointer to print value
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void unrolled_list_print(UnrolledList *list, void (*print_func)(void *));
+
+
+// ****************************************************************************************
+// unrolled_list_destroy
+// ****************************************************************************************
+/**
+ *  Delete #list and every chunk of it
+ * @param[in]    list        Unrolled list to be destroyed
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void unrolled_list_destroy(UnrolledList *list, void (*free_value)(void *));
+
+
+
+//=======================================================================================//
+//                                                                                       //
+//                                  Hash Map API                                         //
+//                                                                                       //
+//=======================================================================================//
+
+/// Bytes of key storage inside every Hash Map node (keys shorter than this live inline)
+#define MAP_NODE_INLINE_KEY             (19)
+
+/// Node flag: node is part of a slab owned by the map (#hash_map_build), never freed alone
+#define MAP_NODE_SLAB                   (0x01)
+
+/// Private Hash Map node (56 bytes, so with malloc header it fills one 64 byte cache line)
+struct hashmap_node{
+    char* key;                  //< Key of key-value pair (points to #key_data or to map key arena)
+    void* value;                //< Value of key-value pair
+    struct hashmap_node* next;  //< Next Node on the single linked list chain
+    uint64_t hash;              //< Full hash of key, compared before the key itself
+    uint32_t key_len;           //< Length of key in bytes (key is also NUL terminated)
+    uint8_t flags;              //< MAP_NODE_* flags
+    char key_data[MAP_NODE_INLINE_KEY]; //< Inline storage of short keys
+};
+
+/// Allocator of the long keys of a Hash Map, reusing the space of removed keys
+struct key_arena;
+
+/// Bloom filter of the keys of a Hash Map (#hash_map_enable_filter)
+struct hash_map_filter;
+
+/// Public definition of Hash Map Node
+typedef struct hashmap_node MapNode;
+
+/// Hash Map storage engines
+typedef enum {
+    HASH_MAP_CHAINED,           //< Table of single linked chains of nodes (default)
+    HASH_MAP_SWISS,             //< Open addressing table with 1 byte control tags per slot
+    HASH_MAP_COMPACT,           //< Dense insertion ordered entry array plus 32 bit index table
+    HASH_MAP_CUCKOO,            //< Bucketized cuckoo table, every key on one of two cache lines
+    HASH_MAP_MAPPED,            //< Read only image mapped from a file (#hash_map_open_mapped)
+    HASH_MAP_FROZEN,            //< Read only minimal perfect hash table (#hash_map_freeze)
+} HashMapEngine;
+
+/// Default max load factor of a Hash Map
+#define HASH_MAP_MAX_LOAD_FACTOR        (1.0f)
+/// Number of table entries moved to the new table on every operation while rehashing
+#define HASH_MAP_REHASH_STEP            (4)
+/// Tables this size or smaller are never shrunk by #hash_map_set_min_load_factor
+#define HASH_MAP_MIN_SHRINK_SIZE        (64)
+
+/// Operation counters of a Hash Map (only updated when built with CLIB_HASH_MAP_STATS)
+typedef struct{
+    unsigned long calls;        //< Number of operations
+    unsigned long probes;       //< Nodes (swiss: tag groups) inspected by the operations
+    unsigned long compares;     //< Key comparisons made by the operations
+} HashMapCounters;
+
+/// Hash Map structure
+typedef struct{
+    int size;                   //< Number of table entries (always a power of two)
+    MapNode **list;             //< Table of list nodes
+    uint64_t seed;              //< Per map seed of the hash function
+    unsigned int count;         //< Number of key-value pairs stored
+    float max_load_factor;      //< Max #count / #size ratio before the table doubles
+    float min_load_factor;      //< #count / #size ratio under which removals shrink the table
+    int old_size;               //< Number of entries of the table being rehashed
+    MapNode **old_list;         //< Table being rehashed into #list (NULL if none)
+    int rehash_pos;             //< Next entry of #old_list to move into #list
+    HashMapEngine engine;       //< Storage engine of the map
+    void *engine_data;          //< Private state of engines other than #HASH_MAP_CHAINED
+    struct key_arena *key_arena;        //< Storage of keys which do not fit inline on nodes
+    uint64_t *occupied;         //< Bitmap of non empty entries of #list (#HASH_MAP_CHAINED)
+    HashMapCounters get_counters;   //< Counters of get calls (CLIB_HASH_MAP_STATS)
+    HashMapCounters set_counters;   //< Counters of set calls (CLIB_HASH_MAP_STATS)
+    HashMapCounters *counting;  //< Counters of the operation in progress, NULL if not counted
+    struct hash_map_filter *filter; //< Filter of keys checked before the engine (NULL if disabled)
+} HashMap;
+
+
+// ****************************************************************************************
+// create_hash_map
+// ****************************************************************************************
+/**
+ *  Initialice a Hash Map with an initial #size
+ * @param[in]    size  Initial size for the Hash Map (rounded up to a power of two)
+ * @param[out]   none
+ * @return       Pointer to a valid Hash Map structure
+ *
+ * @details      The table doubles when the number of pairs exceeds the max load factor.
+ *               Nodes are moved to the new table incrementally, #HASH_MAP_REHASH_STEP
+ *               entries on every set, get, remove or pop call, so no single call pays
+ *               for a full table rehash.
+ *
+ * Hash Map initial state:
+ *
+ *  |---------|
+ *  |         |
+ *  |    x----+-----> NULL
+ *  |         |
+ *  |---------|
+ *  |---------|
+ *  |         |
+ *  |    x----+-----> NULL
+ *  |         |
+ *  |---------|
+ *  |---------|
+ *  |         |
+ *  |    x----+-----> NULL
+ *  |         |
+ *  |---------|
+ *
+ */
+// ****************************************************************************************
+HashMap * create_hash_map(int size);
+
+
+// ****************************************************************************************
+// create_hash_map_engine
+// ****************************************************************************************
+/**
+ *  Initialice a Hash Map with an initial #size storing pairs on the given #engine
+ * @param[in]    size    Initial size for the Hash Map
+ * @param[in]    engine  Storage engine of the map
+ * @param[out]   none
+ * @return       Pointer to a valid Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Every hash_map_* function behaves the same with every engine.
+ *
+ * #HASH_MAP_SWISS keeps pairs on a flat slot array with a 1 byte tag per slot (7 bits of
+ * the key hash, or empty/deleted). Lookups compare 16 tags at once (SSE2 when available)
+ * and only compare keys on tag matches, so a lookup usually touches one tag group and one
+ * slot instead of one node per chain entry. The table doubles once 7/8 of its slots are
+ * used, rehashing on the growing call.
+ *
+ * #HASH_MAP_COMPACT appends pairs to a dense array of entries (hash, key, value) and hashes
+ * 32 bit entry numbers on a separate index table kept under 2/3 load. Iteration is a linear
+ * scan of the entry array, in insertion order (updating a key keeps its place, removing and
+ * setting it again moves it to the end). A pair costs an entry plus 1.5 index slots, about
+ * 38 bytes plus its key, instead of a node, its key and a table pointer. Removed entries
+ * are left as holes until the array fills up, then the array is compacted or doubled.
+ *
+ * #HASH_MAP_CUCKOO gives every key two candidate buckets of 4 slots, each bucket a 64 byte
+ * cache line of 32 bit hash fingerprints and record pointers. A key is always on one of
+ * them (or on a stash of 4 keys), so a get reads at most two bucket lines plus the record
+ * of each fingerprint match, with no probe sequence growing with load or bad key luck.
+ * When both buckets are full, a breadth first search moves the fewest keys to their other
+ * bucket. The table doubles at 90% of its slots or when the stash overflows.
+ */
+// ****************************************************************************************
+HashMap * create_hash_map_engine(int size, HashMapEngine engine);
+
+
+// ****************************************************************************************
+// hash_map_set
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map. If key already exist, update its value
+ * @param[in]    map        Hash Map to be set
+ * @param[in]    key        Key of pair key-value
+ * @param[in]    value      Value of pair key-value
+ * @return       Pointer to previous value if #key already exists, or NULL in other case
+ *
+ * @details
+ *
+ * Hash Map initial state:                          Hash Map after #hash_map_set:
+ *
+ *  |---------|                                    |---------|
+ *  |         |                                    |         |
+ *  |    x----+-----> NULL                         |    x----+-----> NULL
+ *  |         |                                    |         |
+ *  |---------|                                    |---------|
+ *  |---------|                                    |---------|       -----------------
+ *  |         |                                    |         |       | #Key | #Value |
+ *  |    x----+-----> NULL                         |    x----+-----> -----------------
+ *  |         |                                    |         |       |   Next  x-----+---> NULL
+ *  |---------|                                    |---------|       -----------------
+ *  |---------|                                    |---------|
+ *  |         |                                    |         |
+ *  |    x----+-----> NULL                         |    x----+-----> NULL
+ *  |         |                                    |         |
+ *  |---------|                                    |---------|
+ *
+ * Keys shorter than #MAP_NODE_INLINE_KEY bytes are copied inside the node, longer keys are
+ * copied to a key arena owned by the map, so a new pair costs a single allocation.
+ * Arena space of removed keys is reused by later keys of a similar length.
+ *
+ * Collision case: if a collision happens, new node is inserted in the BEGINING of the list given current position
+ *
+ * Hash Map initial state:                          Hash Map after #hash_map_set (collision case):
+ *
+ *  |---------|       ---------------              |---------|       -----------------      ---------------
+ *  |         |       | Key | Value |              |         |       | #Key | #Value |      | Key | Value |
+ *  |    x----+-----> ---------------              |    x----+-----> -----------------   -->---------------
+ *  |         |       |   Next  x---+----> NULL    |         |       |   Next  x-----+---|  |   Next  x---+---> NULL
+ *  |---------|       ---------------              |---------|       -----------------      ---------------
+ *  |---------|       ---------------              |---------|       ---------------
+ *  |         |       | Key | Value |              |         |       | Key | Value |
+ *  |    x----+-----> ---------------              |    x----+-----> ---------------
+ *  |         |       |   Next  x---+----> NULL    |         |       |   Next  x---+-----> NULL
+ *  |---------|       ---------------              |---------|       ---------------
+ *  |---------|                                    |---------|
+ *  |         |                                    |         |
+ *  |    x----+-----> NULL                         |    x----+-----> NULL
+ *  |         |                                    |         |
+ *  |---------|                                    |---------|
+ */
+// ****************************************************************************************
+void * hash_map_set(HashMap *map, const char *key, void *value);
+
+
+// ****************************************************************************************
+// hash_map_remove
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key
+ * @param[in]    map        Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    free_value Function to free value
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ *
+ * @notes        If value to be removed is needed, use #hash_map_pop insetead
+ * @details
+ *
+ * Hash Map initial state:                          Hash Map after #hash_map_remove:
+ *
+ *  |---------|                                   |---------|
+ *  |         |                                   |         |
+ *  |    x----+-----> NULL                        |    x----+-----> NULL
+ *  |         |                                   |         |
+ *  |---------|                                   |---------|
+ *  |---------|       ----------------            |---------|
+ *  |         |       | #Key | Value |            |         |
+ *  |    x----+-----> ----------------            |    x----+-----> NULL
+ *  |         |       |   Next  x----+---> NULL   |         |
+ *  |---------|       ----------------            |---------|
+ *  |---------|                                   |---------|
+ *  |         |                                   |         |
+ *  |    x----+-----> NULL                        |    x----+-----> NULL
+ *  |         |                                   |         |
+ *  |---------|                                   |---------|
+ *
+ * Collision case: if a collision happens, new node is inserted in the BEGINING of the list given current position
+ *
+ * Hash Map initial state:                                              Hash Map after #hash_map_remove (collision case):
+ *
+ *  |---------|       ----------------      ---------------           |---------|       ---------------
+ *  |         |       | #Key | Value |      | Key | Value |           |         |       | Key | Value |
+ *  |    x----+-----> ----------------   -->---------------           |    x----+-----> ---------------
+ *  |         |       |   Next  x----+---|  |   Next  x---+---> NULL  |         |       |   Next  x---+----> NULL
+ *  |---------|       ----------------      ---------------           |---------|       ---------------
+ *  |---------|       ---------------                                 |---------|       ---------------
+ *  |         |       | Key | Value |                                 |         |       | Key | Value |
+ *  |    x----+-----> ---------------                                 |    x----+-----> ---------------
+ *  |         |       |   Next  x---+-----> NULL                      |         |       |   Next  x---+----> NULL
+ *  |---------|       ---------------                                 |---------|       ---------------
+ *  |---------|                                                       |---------|
+ *  |         |                                                       |         |
+ *  |    x----+-----> NULL                                            |    x----+-----> NULL
+ *  |         |                                                       |         |
+ *  |---------|                                                       |---------|
+ */
+// ****************************************************************************************
+int hash_map_remove(HashMap *map, const char *key, void (*free_value)(void *));
+
+
+// ****************************************************************************************
+// hash_map_pop
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key and return value
+ * @param[in]    map        Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    free_value Function to free value
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ *
+ * @details      Very similar to #hash_map_remove
+ */
+// ****************************************************************************************
+void * hash_map_pop(HashMap *map, const char *key);
+
+
+// ****************************************************************************************
+// hash_map_get
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key
+ * @param[in]    map        Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ */
+// ****************************************************************************************
+void * hash_map_get(HashMap *map, const char *key);
+
+
+// ****************************************************************************************
+// hash_map_set_len
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key of #len bytes. If key already exist, update its value
+ * @param[in]    map        Hash Map to be set
+ * @param[in]    key        Key of pair key-value (any bytes, it does not need a NUL terminator)
+ * @param[in]    len        Length of #key in bytes
+ * @param[in]    value      Value of pair key-value
+ * @return       Pointer to previous value if #key already exists, or NULL in other case
+ *
+ * @details      Same as #hash_map_set, but keys are hashed and compared by length and
+ *               content, so they can point straight into a receive buffer. Only
+ *               insertions copy the key. Keys must be shorter than 4 GiB.
+ */
+// ****************************************************************************************
+void * hash_map_set_len(HashMap *map, const void *key, size_t len, void *value);
+
+
+// ****************************************************************************************
+// hash_map_get_len
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key of #len bytes
+ * @param[in]    map        Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @param[in]    len        Length of #key in bytes
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ */
+// ****************************************************************************************
+void * hash_map_get_len(HashMap *map, const void *key, size_t len);
+
+
+// ****************************************************************************************
+// hash_map_remove_len
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key of #len bytes
+ * @param[in]    map        Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    len        Length of #key in bytes
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ */
+// ****************************************************************************************
+int hash_map_remove_len(HashMap *map, const void *key, size_t len, void (*free_value)(void *));
+
+
+// ****************************************************************************************
+// hash_map_pop_len
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key of #len bytes and return value
+ * @param[in]    map        Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    len        Length of #key in bytes
+ * @return       Value of removed pair, or NULL if #key does not exist
+ */
+// ****************************************************************************************
+void * hash_map_pop_len(HashMap *map, const void *key, size_t len);
+
+
+// ****************************************************************************************
+// hash_map_get_or_insert
+// ****************************************************************************************
+/**
+ *  Get the value slot of #key on #map, inserting #key with a NULL value if it does not exist
+ * @param[in]    map        Hash Map to search
+ * @param[in]    key        Key of pair key-value
+ * @return       Pointer to the value of #key, NULL if the pair can not be allocated
+ *
+ * @details      Key is hashed and searched only once, so read-modify-write code such as
+ *               counters pays a single probe:
+ *
+ *                   void **slot = hash_map_get_or_insert(map, word);
+ *                   *slot = (void *)((uintptr_t)*slot + 1);
+ *
+ *               Slot is valid until next call inserting or removing keys of #map.
+ */
+// ****************************************************************************************
+void ** hash_map_get_or_insert(HashMap *map, const char *key);
+
+
+// ****************************************************************************************
+// hash_map_get_or_insert_len
+// ****************************************************************************************
+/**
+ *  Get the value slot of #key of #len bytes, inserting #key with a NULL value if it does not exist
+ * @param[in]    map        Hash Map to search
+ * @param[in]    key        Key of pair key-value (any bytes, it does not need a NUL terminator)
+ * @param[in]    len        Length of #key in bytes
+ * @return       Pointer to the value of #key, NULL if the pair can not be allocated
+ *
+ * @details      Same as #hash_map_get_or_insert.
+ */
+// ****************************************************************************************
+void ** hash_map_get_or_insert_len(HashMap *map, const void *key, size_t len);
+
+
+/// Function computing the new value of a pair from its current value (NULL on new pairs)
+typedef void *(*UpdateFunction)(void *value, void *ctx);
+
+// ****************************************************************************************
+// hash_map_update
+// ****************************************************************************************
+/**
+ *  Replace the value of #key on #map with the value returned by #update
+ * @param[in]    map        Hash Map to update
+ * @param[in]    key        Key of pair key-value, inserted if it does not exist
+ * @param[in]    update     Function called with current value (NULL if #key is new) and #ctx
+ * @param[in]    ctx        User pointer given to #update
+ * @return       New value of #key, NULL if the pair can not be allocated
+ *
+ * @details      Key is hashed and searched only once. #update must not modify #map.
+ */
+// ****************************************************************************************
+void * hash_map_update(HashMap *map, const char *key, UpdateFunction update, void *ctx);
+
+
+// ****************************************************************************************
+// hash_map_get_many
+// ****************************************************************************************
+/**
+ *  Get the values of #n keys on #map
+ * @param[in]    map        Hash Map to obtain values
+ * @param[in]    keys       Keys of pairs key-value to obtain
+ * @param[in]    n          Number of keys
+ * @param[out]   out        Value of every key, or NULL for keys that do not exist
+ * @return       none
+ *
+ * @details      Keys are processed on batches: the whole batch is hashed first, then
+ *               the table entries, nodes and keys of every key are prefetched one stage
+ *               at a time, and only then keys are compared. Cache misses of independent
+ *               lookups overlap instead of stalling one after another, which pays off
+ *               on tables bigger than the CPU caches.
+ */
+// ****************************************************************************************
+void hash_map_get_many(HashMap *map, const char * const *keys, size_t n, void **out);
+
+
+// ****************************************************************************************
+// hash_map_set_many
+// ****************************************************************************************
+/**
+ *  Set #n key-value pairs on #map. If a key already exist, update its value
+ * @param[in]    map        Hash Map to be set
+ * @param[in]    keys       Keys of pairs key-value
+ * @param[in]    values     Value of every key
+ * @param[in]    n          Number of pairs
+ * @return       CLIB_OK    if every pair is set \n
+ *               CLIB_ERROR if some pair can not be allocated
+ *
+ * @details      Same batching than #hash_map_get_many. Previous values of existing keys
+ *               are overwritten, use #hash_map_set if they must be freed.
+ */
+// ****************************************************************************************
+int hash_map_set_many(HashMap *map, const char * const *keys, void **values, size_t n);
+
+
+// ****************************************************************************************
+// hash_map_build
+// ****************************************************************************************
+/**
+ *  Create a Hash Map holding #n key-value pairs, built on #nthreads threads
+ * @param[in]    keys       Keys of pairs key-value (NUL terminated)
+ * @param[in]    values     Value of every key (NULL to set every value to NULL)
+ * @param[in]    n          Number of pairs (at most UINT32_MAX)
+ * @param[in]    nthreads   Number of threads building the map (1 to build it on the caller)
+ * @param[out]   none
+ * @return       Pointer to a Hash Map with #HASH_MAP_CHAINED engine, NULL if it can not be
+ *               allocated
+ *
+ * @details      Meant to load big maps at startup, much faster than #n calls to
+ *               #hash_map_set: the table is sized once, and nodes and long keys of every
+ *               pair come from a single allocation instead of one malloc per pair.
+ *               Keys are split by the high bits of their table entry, so each thread owns
+ *               a range of table entries and links its nodes without locks.
+ *               A key given more than once keeps its last value, as with #hash_map_set.
+ *               Thread count is rounded down to a power of two, and small maps use fewer
+ *               threads. The map is a regular chained map afterwards: removed pairs built
+ *               here release their node when the map is destroyed.
+ */
+// ****************************************************************************************
+HashMap * hash_map_build(const char * const *keys, void **values, size_t n, int nthreads);
+
+
+/// Function giving the result value of a key present on both maps of #hash_map_intersect
+/// or #hash_map_union, called from several threads at once
+typedef void *(*CombineFunction)(const char *key, size_t key_len, void *a_value, void *b_value);
+
+/// Function called by #hash_map_join for every key present on both maps, from several
+/// threads at once
+typedef void (*JoinVisitor)(const char *key, size_t key_len, void *a_value, void *b_value, void *ctx);
+
+
+// ****************************************************************************************
+// hash_map_intersect
+// ****************************************************************************************
+/**
+ *  Create a Hash Map with the keys present on both #a and #b, on #nthreads threads
+ * @param[in]    a          First map
+ * @param[in]    b          Second map
+ * @param[in]    combine    Value of every key of the result (NULL for its value on #a)
+ * @param[in]    nthreads   Number of threads (1 to run it on the caller)
+ * @param[out]   none
+ * @return       Pointer to a Hash Map with #HASH_MAP_CHAINED engine, NULL if it can not be
+ *               allocated
+ *
+ * @details      Keys of the smaller map are hashed with the seed of the other one and
+ *               split by the bits picking their table entry there, so every thread looks
+ *               up its own range of the bigger map. Results are built with the same
+ *               partitioning than #hash_map_build. Neither map may change while the call
+ *               runs (a pending incremental rehash of the searched map is finished first).
+ *               Values are not copied: the result holds the same pointers (or the ones
+ *               given by #combine). A key whose value is NULL counts as absent, as with
+ *               #hash_map_get. Maps of any engine can be combined.
+ */
+// ****************************************************************************************
+HashMap * hash_map_intersect(HashMap *a, HashMap *b, CombineFunction combine, int nthreads);
+
+
+// ****************************************************************************************
+// hash_map_union
+// ****************************************************************************************
+/**
+ *  Create a Hash Map with the keys present on #a or #b, on #nthreads threads
+ * @param[in]    a          First map
+ * @param[in]    b          Second map
+ * @param[in]    combine    Value of keys on both maps (NULL for their value on #a)
+ * @param[in]    nthreads   Number of threads (1 to run it on the caller)
+ * @param[out]   none
+ * @return       Pointer to a Hash Map with #HASH_MAP_CHAINED engine, NULL if it can not be
+ *               allocated
+ *
+ * @details      Keys of #a are looked up on #b, then keys of #b on #a, both as on
+ *               #hash_map_intersect. Keys on a single map keep their value.
+ */
+// ****************************************************************************************
+HashMap * hash_map_union(HashMap *a, HashMap *b, CombineFunction combine, int nthreads);
+
+
+// ****************************************************************************************
+// hash_map_join
+// ****************************************************************************************
+/**
+ *  Call #visit for every key present on both #a and #b, on #nthreads threads
+ * @param[in]    a          First map
+ * @param[in]    b          Second map
+ * @param[in]    visit      Function called with the key and its values on #a and #b
+ * @param[in]    ctx        Context given to #visit
+ * @param[in]    nthreads   Number of threads (1 to run it on the caller)
+ * @param[out]   none
+ * @return       CLIB_OK    if every common key is visited \n
+ *               CLIB_ERROR if memory can not be allocated (no key is visited)
+ *
+ * @details      Same partitioning than #hash_map_intersect, without building a result:
+ *               #visit runs on the thread owning the key, so it must be thread safe.
+ */
+// ****************************************************************************************
+int hash_map_join(HashMap *a, HashMap *b, JoinVisitor visit, void *ctx, int nthreads);
+
+
+/// Function called for every pair of a map by #hash_map_foreach
+typedef void (*EntryVisitor)(const char *key, size_t key_len, void *value, void *ctx);
+
+/// Cursor over the pairs of a Hash Map
+typedef struct{
+    HashMap *map;               //< Map being iterated
+    size_t position;            //< Next table entry to visit
+    void *cursor;               //< Next node of the current entry (engine specific)
+    const char *key;            //< Key of current pair (NUL terminated)
+    size_t key_len;             //< Length of current key
+    void *value;                //< Value of current pair
+} HashMapIter;
+
+
+// ****************************************************************************************
+// hash_map_iter_begin
+// ****************************************************************************************
+/**
+ *  Place #it before the first pair of #map
+ * @param[in]    map        Hash Map to iterate
+ * @param[out]   it         Iterator to initialice
+ * @return       none
+ *
+ * @details      Pairs are visited on table order:
+ *
+ *                   HashMapIter it;
+ *                   hash_map_iter_begin(map, &it);
+ *                   while (hash_map_iter_next(&it))
+ *                       use(it.key, it.value);
+ *
+ *               A pending incremental rehash is finished here, so every pair is on a
+ *               single table. The chained engine keeps a bitmap of its non empty table
+ *               entries, so empty entries are skipped 64 at a time.
+ *               Inserting or removing keys invalidates the iterator, getting keys or
+ *               setting values of existing keys does not.
+ */
+// ****************************************************************************************
+void hash_map_iter_begin(HashMap *map, HashMapIter *it);
+
+
+// ****************************************************************************************
+// hash_map_iter_next
+// ****************************************************************************************
+/**
+ *  Move #it to the next pair of its map
+ * @param[in]    it         Iterator initialiced by #hash_map_iter_begin
+ * @return       true if #it points to a pair (on it->key, it->key_len, it->value) \n
+ *               false if every pair was visited
+ */
+// ****************************************************************************************
+bool hash_map_iter_next(HashMapIter *it);
+
+
+// ****************************************************************************************
+// hash_map_foreach
+// ****************************************************************************************
+/**
+ *  Call #visit for every pair of #map
+ * @param[in]    map        Hash Map to traverse
+ * @param[in]    visit      Function called with key, key length, value and #ctx of every pair
+ * @param[in]    ctx        User pointer given to #visit
+ * @return       none
+ *
+ * @details      #visit must not insert or remove keys of #map.
+ */
+// ****************************************************************************************
+void hash_map_foreach(HashMap *map, EntryVisitor visit, void *ctx);
+
+
+// ****************************************************************************************
+// hash_map_print
+// ****************************************************************************************
+/**
+ *  Print all elements on #map starting from the first position of the map,
+ * iterating over every list node on position given a print function
+ * @param[in]    map         Hash Map to be printed
+ * @param[in]    print_func  Function pointer to print value
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void hash_map_print(HashMap *map, void (*print_func)(void *));
+
+
+// ****************************************************************************************
+// hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every node and key, and every value given #free_value
+ * @param[in]    map         Hash Map to be destroyed
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void hash_map_destroy(HashMap *map, void (*free_value)(void *));
+
+
+// ****************************************************************************************
+// hash_map_reserve
+// ****************************************************************************************
+/**
+ *  Grow #map table so it can hold #count pairs without exceeding its max load factor
+ * @param[in]    map        Hash Map to grow
+ * @param[in]    count      Number of pairs expected on the map
+ * @param[out]   none
+ * @return       CLIB_OK    if table is big enough \n
+ *               CLIB_ERROR if table can not be allocated
+ *
+ * @details      Rehash happens on this call, so it should be called before filling the map.
+ */
+// ****************************************************************************************
+int hash_map_reserve(HashMap *map, unsigned int count);
+
+
+// ****************************************************************************************
+// hash_map_set_max_load_factor
+// ****************************************************************************************
+/**
+ *  Set the max ratio of pairs per table entry before #map table doubles
+ * @param[in]    map          Hash Map to configure
+ * @param[in]    load_factor  New max load factor (must be greater than 0)
+ * @param[out]   none
+ * @return       CLIB_OK    if load factor is valid \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+int hash_map_set_max_load_factor(HashMap *map, float load_factor);
+
+
+// ****************************************************************************************
+// hash_map_set_min_load_factor
+// ****************************************************************************************
+/**
+ *  Set the ratio of pairs per table entry under which removals shrink #map table
+ * @param[in]    map          Hash Map to configure
+ * @param[in]    load_factor  New min load factor, 0 to never shrink (default). Must be
+ *                            under half the max load factor
+ * @param[out]   none
+ * @return       CLIB_OK    if load factor is valid \n
+ *               CLIB_ERROR in other case
+ *
+ * @details      A removal leaving the table under #load_factor shrinks it to half its
+ *               max load. Chained tables shrink with an incremental rehash, so no
+ *               removal pays the whole move; other engines are rebuilt on that removal.
+ *               Nodes are not moved, use #hash_map_compact for that.
+ */
+// ****************************************************************************************
+int hash_map_set_min_load_factor(HashMap *map, float load_factor);
+
+
+// ****************************************************************************************
+// hash_map_compact
+// ****************************************************************************************
+/**
+ *  Shrink #map table to the pairs it holds, moving them to new contiguous storage
+ * @param[in]    map        Hash Map to compact
+ * @param[out]   none
+ * @return       CLIB_OK    if #map is compacted (read only maps always are) \n
+ *               CLIB_ERROR if new storage can not be allocated (#map is left unchanged)
+ *
+ * @details      Meant to run after big removal waves, which leave a mostly empty table
+ *               and surviving nodes spread over memory held by removed ones. Chained
+ *               maps get a table sized for their pairs and a single slab holding every
+ *               node and long key, nodes on table order so scans walk memory forward;
+ *               previous nodes and key arena are freed. Other engines are rebuilt with
+ *               storage sized for their pairs (compact engine keeps insertion order).
+ *               Takes time proportional to the pairs and the old table, on this call.
+ */
+// ****************************************************************************************
+int hash_map_compact(HashMap *map);
+
+
+/// Number of entries of the chain length histogram of #HashMapStats
+#define HASH_MAP_STATS_HISTOGRAM        (8)
+
+/// Shape of a Hash Map table and cost of its operations
+typedef struct{
+    unsigned int count;         //< Number of key-value pairs stored
+    int size;                   //< Number of table entries (slots for open addressing engines)
+    float load_factor;          //< #count / #size
+    /// Chained: entries holding i pairs. Swiss: pairs found i groups after their home group.
+    /// Compact: pairs found i index slots after their home slot.
+    /// Cuckoo: pairs on their primary bucket (0), alternate bucket (1) or stash (2).
+    /// Last position also counts every longer chain
+    unsigned int chain_histogram[HASH_MAP_STATS_HISTOGRAM];
+    unsigned int max_chain;     //< Longest chain (swiss: longest probe sequence in groups)
+    size_t key_arena_bytes;     //< Memory reserved for keys by the map, freed space included
+    bool counters;              //< Operation counters below are available
+    unsigned long gets;         //< Number of get calls
+    unsigned long sets;         //< Number of set calls
+    double probes_per_get;      //< Average nodes (swiss: tag groups) inspected per get
+    double compares_per_get;    //< Average key comparisons per get
+    double probes_per_set;      //< Average nodes (swiss: tag groups) inspected per set
+    double compares_per_set;    //< Average key comparisons per set
+    size_t filter_bytes;        //< Memory of the Bloom filter, 0 if it is disabled
+    double filter_fpr;          //< Expected filter false positive rate, from its bits set
+    unsigned long filter_rejects;   //< Gets of absent keys answered by the filter alone
+    double filter_measured_fpr; //< Absent keys gets passing the filter / absent keys gets
+} HashMapStats;
+
+
+// ****************************************************************************************
+// hash_map_stats
+// ****************************************************************************************
+/**
+ *  Obtain occupancy of #map table and average cost of its operations
+ * @param[in]    map        Hash Map to inspect
+ * @param[out]   stats      Statistics of #map
+ * @return       none
+ *
+ * @details      Occupancy is computed walking the whole table. Operation counters cost
+ *               some increments on every get and set, so they are only compiled when the
+ *               library is built with CLIB_HASH_MAP_STATS defined (make STATS=1); in other
+ *               case #stats counters field is false and averages are 0.
+ *               Every node caches the full hash of its key, so keys are only compared on
+ *               full hash matches: many probes per operation with few compares points to
+ *               long chains (table too small or bad hash spread), not to key compares.
+ */
+// ****************************************************************************************
+void hash_map_stats(HashMap *map, HashMapStats *stats);
+
+
+/// Default bits per key of #hash_map_enable_filter, about 1% of absent keys pass the filter
+#define HASH_MAP_FILTER_BITS_PER_KEY    (10)
+
+// ****************************************************************************************
+// hash_map_enable_filter
+// ****************************************************************************************
+/**
+ *  Check every get and remove of #map against a Bloom filter of its keys first
+ * @param[in]    map           Hash Map to filter
+ * @param[in]    bits_per_key  Filter bits per key (#HASH_MAP_FILTER_BITS_PER_KEY), 0 to
+ *                             remove the filter
+ * @param[out]   none
+ * @return       CLIB_OK    if the filter is built \n
+ *               CLIB_ERROR if it can not be allocated (#map keeps its previous filter)
+ *
+ * @details      Meant for maps mostly asked for keys they do not hold. The filter is
+ *               split on 64 byte blocks and all bits of a key live on a single block, so
+ *               an absent key is usually rejected after reading one cache line, without
+ *               touching the table. Keys present, and the few absent keys passing the
+ *               filter, pay that line on top of the usual lookup.
+ *
+ *               Sets add their new keys to the filter. A Bloom filter can not forget
+ *               keys, so removed keys leave stale bits, and the filter is rebuilt from the
+ *               map keys once removed keys are half of the keys it holds. It is also
+ *               rebuilt twice as big once it holds more keys than it was sized for. Both
+ *               rebuilds hash every key of the map again on the call that triggers them.
+ *
+ *               #hash_map_stats reports its size and expected false positive rate, and
+ *               with CLIB_HASH_MAP_STATS the rate measured on gets (a get of a key stored
+ *               with a NULL value counts as absent).
+ */
+// ****************************************************************************************
+int hash_map_enable_filter(HashMap *map, unsigned int bits_per_key);
+
+
+/// Serialization of Hash Map values for #hash_map_save
+typedef struct{
+    /// Number of bytes #encode writes for #value
+    size_t (*size)(const void *value);
+    /// Write #value on #buffer, which has room for size(#value) bytes
+    void (*encode)(const void *value, void *buffer);
+} ValueCodec;
+
+/// Codec of NUL terminated string values (NULL values are saved as empty strings)
+extern const ValueCodec VALUE_CODEC_STRING;
+
+
+// ****************************************************************************************
+// hash_map_save
+// ****************************************************************************************
+/**
+ *  Write every pair of #map on #path as an image #hash_map_open_mapped can map
+ * @param[in]    map        Hash Map to save (any engine)
+ * @param[in]    path       File to write (replaced atomically if it exists)
+ * @param[in]    codec      Serialization of values, NULL to save keys only
+ * @return       CLIB_OK    if image is written \n
+ *               CLIB_ERROR in other case
+ *
+ * @details      Image holds a header, a bucket index, a fixed size entry per pair and
+ *               the bytes of keys and values. Entries of a bucket are contiguous and
+ *               every reference is an offset from the start of the file, so the image
+ *               is valid wherever it is mapped. Values are aligned to 8 bytes.
+ *               Image is written with the byte order and hash of this build, and must be
+ *               opened by a build of the same architecture.
+ */
+// ****************************************************************************************
+int hash_map_save(HashMap *map, const char *path, const ValueCodec *codec);
+
+
+// ****************************************************************************************
+// hash_map_open_mapped
+// ****************************************************************************************
+/**
+ *  Open an image written by #hash_map_save as a read only Hash Map
+ * @param[in]    path       Image file
+ * @param[out]   none
+ * @return       Pointer to a #HASH_MAP_MAPPED Hash Map, NULL if #path is not a valid image
+ *
+ * @details      File is mapped read only and shared, nothing is copied nor rebuilt, so
+ *               opening costs the same for any size and processes mapping the same image
+ *               share its pages on the page cache. Lookups read the mapping directly.
+ *               Values returned by gets, iterators and foreach point to the encoded bytes
+ *               inside the mapping and are valid until #hash_map_destroy, which must be
+ *               given a NULL free function. Set, remove and pop calls fail. Only the
+ *               header and bucket index are checked on open, so images must come from a
+ *               trusted writer.
+ */
+// ****************************************************************************************
+HashMap * hash_map_open_mapped(const char *path);
+
+
+// ****************************************************************************************
+// hash_map_freeze
+// ****************************************************************************************
+/**
+ *  Turn #map into a read only table with a minimal perfect hash of its current keys
+ * @param[in]    map        Hash Map to freeze (any engine but #HASH_MAP_MAPPED)
+ * @param[out]   none
+ * @return       CLIB_OK    if #map is frozen (or it already was) \n
+ *               CLIB_ERROR in other case (#map is left unchanged)
+ *
+ * @details      Meant for tables built once and only read afterwards, such as keyword
+ *               or opcode tables. Keys are split on buckets of about 4 keys and every
+ *               bucket gets a 32 bit seed placing its keys on free slots of a table with
+ *               exactly one slot per pair (CHD method). A get reads the seed of the key
+ *               bucket and a single slot, so it does one probe and at most one key
+ *               compare, and most misses are rejected by a 32 bit hash check without
+ *               comparing keys. A pair takes a 24 byte slot, one byte of seeds and its key.
+ *               Finding the seeds gets slower as the table fills up: freezing takes
+ *               about 0.4 ms for a thousand keys and 1 s for a million.
+ *               Values are kept, keys are copied to a single block. After freezing set,
+ *               remove and pop calls fail, values can still be changed through their
+ *               pointers. #hash_map_save can write a frozen map like any other.
+ */
+// ****************************************************************************************
+int hash_map_freeze(HashMap *map);
+
+
+//=======================================================================================//
+//                                                                                       //
+//                              Generic Hash Map API                                     //
+//                                                                                       //
+//=======================================================================================//
+
+
+/********************************** STRUCTURES **************************************/
+
+/// Key hash function definition (equal keys must give equal hashes)
+typedef uint64_t(*KeyHashFunction)(const void *);
+
+/// Primitive key hash functions (matching COMPARE_INT, COMPARE_STRING and COMPARE_POINTER)
+extern KeyHashFunction HASH_INT;
+extern KeyHashFunction HASH_STRING;
+extern KeyHashFunction HASH_POINTER;
+
+/// Internal Generic Hash Map node
+struct generic_map_node{
+    void* key;                  //< Key of key-value pair (owned by the caller)
+    void* value;                //< Value of key-value pair
+    struct generic_map_node* next;  //< Next Node on the single linked list chain
+    uint64_t hash;              //< Full hash of key, compared before the key itself
+};
+
+/// Public definition of Generic Hash Map Node
+typedef struct generic_map_node GenericMapNode;
+
+/// Generic Hash Map structure
+typedef struct{
+    int size;                   //< Number of table entries (always a power of two)
+    GenericMapNode **list;      //< Table of list nodes
+    uint64_t seed;              //< Per map seed mixed into the user hash
+    unsigned int count;         //< Number of key-value pairs stored
+    KeyHashFunction hash;       //< Hash function of keys
+    ContentComparator compare;  //< Key comparator, returns 0 on equal keys
+} GenericHashMap;
+
+
+// ****************************************************************************************
+// create_generic_hash_map
+// ****************************************************************************************
+/**
+ *  Initialice a Hash Map whose keys are any pointer, given its #hash and #compare functions
+ * @param[in]    size     Initial size for the Hash Map (rounded up to a power of two)
+ * @param[in]    hash     Function to hash keys
+ * @param[in]    compare  Function to compare keys, returning 0 if they are equal
+ * @param[out]   none
+ * @return       Pointer to a valid Generic Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Keys are stored by pointer, they are never copied nor freed by the map, so
+ *               they must stay valid and unchanged while their pair is on the map.
+ *               User hashes are remixed with a per map seed, so weak hashes (e.g. the
+ *               identity of an integer) still spread over the whole table.
+ *               The table doubles when the number of pairs exceeds its size.
+ */
+// ****************************************************************************************
+GenericHashMap * create_generic_hash_map(int size, KeyHashFunction hash, ContentComparator compare);
+
+
+// ****************************************************************************************
+// generic_hash_map_set
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key. If key already exist, update its value
+ * @param[in]    map        Generic Hash Map to be set
+ * @param[in]    key        Key of pair key-value (stored by pointer)
+ * @param[in]    value      Value of pair key-value
+ * @return       Pointer to previous value if #key already exists, or NULL in other case
+ *
+ * @details      When #key already exists the key stored on first set is kept.
+ */
+// ****************************************************************************************
+void * generic_hash_map_set(GenericHashMap *map, void *key, void *value);
+
+
+// ****************************************************************************************
+// generic_hash_map_get
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key
+ * @param[in]    map        Generic Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ */
+// ****************************************************************************************
+void * generic_hash_map_get(GenericHashMap *map, void *key);
+
+
+// ****************************************************************************************
+// generic_hash_map_remove
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key
+ * @param[in]    map        Generic Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ */
+// ****************************************************************************************
+int generic_hash_map_remove(GenericHashMap *map, void *key, void (*free_value)(void *));
+
+
+// ****************************************************************************************
+// generic_hash_map_pop
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key and return value
+ * @param[in]    map        Generic Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @return       Value of removed pair, or NULL if #key does not exist
+ */
+// ****************************************************************************************
+void * generic_hash_map_pop(GenericHashMap *map, void *key);
+
+
+// ****************************************************************************************
+// generic_hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every node, and every value given #free_value
+ * @param[in]    map         Generic Hash Map to be destroyed
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void generic_hash_map_destroy(GenericHashMap *map, void (*free_value)(void *));
+
+
+
+//=======================================================================================//
+//                                                                                       //
+//                              Integer Hash Map API                                     //
+//                                                                                       //
+//=======================================================================================//
+
+
+/********************************** STRUCTURES **************************************/
+
+/// Internal Integer Hash Map slot
+typedef struct{
+    uint64_t key;               //< Key of key-value pair (0 marks an empty slot)
+    void* value;                //< Value of key-value pair
+} IntMapSlot;
+
+/// Integer Hash Map structure
+typedef struct{
+    int size;                   //< Number of slots (always a power of two)
+    IntMapSlot *slots;          //< Open addressing table of pairs
+    uint64_t seed;              //< Per map seed of the hash function
+    unsigned int count;         //< Number of key-value pairs stored (key 0 included)
+    bool has_zero;              //< Key 0 is on the map (stored apart, it marks empty slots)
+    void *zero_value;           //< Value of key 0
+} IntHashMap;
+
+
+// ****************************************************************************************
+// create_int_hash_map
+// ****************************************************************************************
+/**
+ *  Initialice a Hash Map whose keys are 64 bit integers
+ * @param[in]    size  Initial number of pairs the map holds without growing
+ * @param[out]   none
+ * @return       Pointer to a valid Integer Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Pairs live on a flat slot array probed linearly, so neither keys nor
+ *               nodes are allocated and a lookup usually reads a single cache line.
+ *               Removed pairs are not left as tombstones: following pairs of the probe
+ *               sequence are shifted back instead. The table doubles at 3/4 load.
+ */
+// ****************************************************************************************
+IntHashMap * create_int_hash_map(int size);
+
+
+// ****************************************************************************************
+// int_hash_map_set
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key. If key already exist, update its value
+ * @param[in]    map        Integer Hash Map to be set
+ * @param[in]    key        Key of pair key-value
+ * @param[in]    value      Value of pair key-value
+ * @return       Pointer to previous value if #key already exists, or NULL in other case
+ */
+// ****************************************************************************************
+void * int_hash_map_set(IntHashMap *map, uint64_t key, void *value);
+
+
+// ****************************************************************************************
+// int_hash_map_get
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key
+ * @param[in]    map        Integer Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ */
+// ****************************************************************************************
+void * int_hash_map_get(IntHashMap *map, uint64_t key);
+
+
+// ****************************************************************************************
+// int_hash_map_remove
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key
+ * @param[in]    map        Integer Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ */
+// ****************************************************************************************
+int int_hash_map_remove(IntHashMap *map, uint64_t key, void (*free_value)(void *));
+
+
+// ****************************************************************************************
+// int_hash_map_pop
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key and return value
+ * @param[in]    map        Integer Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @return       Value of removed pair, or NULL if #key does not exist
+ */
+// ****************************************************************************************
+void * int_hash_map_pop(IntHashMap *map, uint64_t key);
+
+
+// ****************************************************************************************
+// int_hash_map_reserve
+// ****************************************************************************************
+/**
+ *  Grow #map table so it can hold #count pairs without growing again
+ * @param[in]    map        Integer Hash Map to grow
+ * @param[in]    count      Number of pairs expected on the map
+ * @param[out]   none
+ * @return       CLIB_OK    if table is big enough \n
+ *               CLIB_ERROR if table can not be allocated
+ */
+// ****************************************************************************************
+int int_hash_map_reserve(IntHashMap *map, unsigned int count);
+
+
+// ****************************************************************************************
+// int_hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every value given #free_value
+ * @param[in]    map         Integer Hash Map to be destroyed
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void int_hash_map_destroy(IntHashMap *map, void (*free_value)(void *));
+
+
+//=======================================================================================//
+//                                                                                       //
+//                             Concurrent Hash Map API                                   //
+//                                                                                       //
+//=======================================================================================//
+
+
+/********************************** STRUCTURES **************************************/
+
+/// Number of locks of a Concurrent Hash Map (power of two)
+#define CONCURRENT_MAP_STRIPES          (64)
+/// Bytes of a cache line, locks used by different threads are kept on different lines
+#define CLIB_CACHE_LINE                 (64)
+
+/// Lock of the table entries whose index is equal to the stripe index modulo #CONCURRENT_MAP_STRIPES
+typedef struct{
+    _Alignas(CLIB_CACHE_LINE) pthread_rwlock_t lock;
+    unsigned int count;         //< Number of key-value pairs on entries of this stripe
+} ConcurrentStripe;
+
+/// Concurrent Hash Map structure
+typedef struct{
+    int size;                   //< Number of table entries (power of two, >= #CONCURRENT_MAP_STRIPES)
+    MapNode **list;             //< Table of list nodes
+    uint64_t seed;              //< Per map seed of the hash function
+    ConcurrentStripe stripes[CONCURRENT_MAP_STRIPES];   //< Locks of table entries
+} ConcurrentHashMap;
+
+
+// ****************************************************************************************
+// create_concurrent_hash_map
+// ****************************************************************************************
+/**
+ *  Initialice a Hash Map that can be used by several threads at the same time
+ * @param[in]    size  Initial size for the Hash Map (rounded up to a power of two)
+ * @param[out]   none
+ * @return       Pointer to a valid Concurrent Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Table entries are split on #CONCURRENT_MAP_STRIPES stripes, every one with
+ *               its own reader/writer lock. Operations only lock the stripe of their key,
+ *               so threads using different stripes never wait for each other, and gets of
+ *               the same stripe run in parallel.
+ *               The stripe of a key is given by the low bits of its hash, which also
+ *               select its table entry, so doubling the table keeps every key on its
+ *               stripe. The table doubles, taking every stripe lock in order, once a
+ *               stripe holds more pairs than its share of table entries.
+ */
+// ****************************************************************************************
+ConcurrentHashMap * create_concurrent_hash_map(int size);
+
+
+// ****************************************************************************************
+// concurrent_hash_map_set
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key. If key already exist, update its value
+ * @param[in]    map        Concurrent Hash Map to be set
+ * @param[in]    key        Key of pair key-value (it is copied)
+ * @param[in]    value      Value of pair key-value
+ * @return       Pointer to previous value if #key already exists, or NULL in other case
+ */
+// ****************************************************************************************
+void * concurrent_hash_map_set(ConcurrentHashMap *map, const char *key, void *value);
+
+
+// ****************************************************************************************
+// concurrent_hash_map_get
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key
+ * @param[in]    map        Concurrent Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ *
+ * @note         Map does not protect values: a value returned here may be removed and
+ *               freed by other thread at any moment, unless callers agree otherwise.
+ */
+// ****************************************************************************************
+void * concurrent_hash_map_get(ConcurrentHashMap *map, const char *key);
+
+
+// ****************************************************************************************
+// concurrent_hash_map_update
+// ****************************************************************************************
+/**
+ *  Replace the value of #key on #map with the value returned by #update, atomically
+ * @param[in]    map        Concurrent Hash Map to update
+ * @param[in]    key        Key of pair key-value, inserted if it does not exist
+ * @param[in]    update     Function called with current value (NULL if #key is new) and #ctx
+ * @param[in]    ctx        User pointer given to #update
+ * @return       New value of #key, NULL if the pair can not be allocated
+ *
+ * @details      #update runs with the stripe of #key locked, so no other thread reads or
+ *               writes #key meanwhile. It must be short and must not use #map.
+ */
+// ****************************************************************************************
+void * concurrent_hash_map_update(ConcurrentHashMap *map, const char *key, UpdateFunction update, void *ctx);
+
+
+// ****************************************************************************************
+// concurrent_hash_map_remove
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key
+ * @param[in]    map        Concurrent Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ */
+// ****************************************************************************************
+int concurrent_hash_map_remove(ConcurrentHashMap *map, const char *key, void (*free_value)(void *));
+
+
+// ****************************************************************************************
+// concurrent_hash_map_pop
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key and return value
+ * @param[in]    map        Concurrent Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @return       Value of removed pair, or NULL if #key does not exist
+ */
+// ****************************************************************************************
+void * concurrent_hash_map_pop(ConcurrentHashMap *map, const char *key);
+
+
+// ****************************************************************************************
+// concurrent_hash_map_count
+// ****************************************************************************************
+/**
+ *  Obtain the number of key-value pairs of #map
+ * @param[in]    map        Concurrent Hash Map
+ * @return       Number of pairs (only exact if no other thread is modifying #map)
+ */
+// ****************************************************************************************
+unsigned int concurrent_hash_map_count(ConcurrentHashMap *map);
+
+
+// ****************************************************************************************
+// concurrent_hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every node and key, and every value given #free_value
+ * @param[in]    map         Concurrent Hash Map to be destroyed (no thread may be using it)
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void concurrent_hash_map_destroy(ConcurrentHashMap *map, void (*free_value)(void *));
+
+
+//=======================================================================================//
+//                                                                                       //
+//                                RCU Hash Map API                                       //
+//                                                                                       //
+//=======================================================================================//
+
+
+/********************************** STRUCTURES **************************************/
+
+/// Thread reading a RCU Hash Map, it announces its quiescent states on its own cache line
+typedef struct rcu_reader{
+    _Alignas(CLIB_CACHE_LINE) uint64_t seen_epoch;  //< Last map epoch seen on a quiescent state
+    struct rcu_reader *next;    //< Next registered reader
+} RcuReader;
+
+/// Table of a RCU Hash Map, replaced as a whole when it grows
+struct rcu_table;
+
+/// Memory removed from a RCU Hash Map waiting for readers to pass a quiescent state
+struct rcu_retired;
+
+/// RCU Hash Map structure
+typedef struct{
+    struct rcu_table *table;    //< Current table, published with atomic stores
+    uint64_t seed;              //< Per map seed of the hash function
+    unsigned int count;         //< Number of key-value pairs stored
+    void (*free_value)(void *); //< Function to free replaced and removed values (may be NULL)
+    pthread_mutex_t write_lock; //< Serializes writers
+    uint64_t epoch;             //< Increased on every retirement of memory
+    RcuReader *readers;         //< Registered readers
+    struct rcu_retired *retired;    //< Memory waiting for a grace period, newest first
+} RcuHashMap;
+
+
+// ****************************************************************************************
+// create_rcu_hash_map
+// ****************************************************************************************
+/**
+ *  Initialice a read mostly Hash Map whose gets take no locks
+ * @param[in]    size        Initial size for the Hash Map (rounded up to a power of two)
+ * @param[in]    free_value  Function to free values once no reader can see them (NULL if
+ *                           values must not be freed)
+ * @param[out]   none
+ * @return       Pointer to a valid RCU Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Readers follow the chains with atomic loads only, writing no shared memory.
+ *               Writers are serialized by a mutex and publish every change with a single
+ *               atomic pointer store: new nodes are linked at the head of their chain,
+ *               removed nodes are unlinked, new values replace the value pointer of the
+ *               node, and a grown table replaces the table pointer (its nodes are copies).
+ *
+ *               Removed nodes, replaced values and old tables are freed after a grace
+ *               period (quiescent state based reclamation): every thread calling
+ *               #rcu_hash_map_get registers with #rcu_hash_map_register_reader and calls
+ *               #rcu_hash_map_quiescent when it holds no pointer obtained from the map,
+ *               e.g. once per request. Memory is freed by writers once every registered
+ *               reader announced a quiescent state after its removal.
+ */
+// ****************************************************************************************
+RcuHashMap * create_rcu_hash_map(int size, void (*free_value)(void *));
+
+
+// ****************************************************************************************
+// rcu_hash_map_register_reader
+// ****************************************************************************************
+/**
+ *  Register the calling thread as a reader of #map
+ * @param[in]    map        RCU Hash Map to read
+ * @return       Reader handle to be given to #rcu_hash_map_quiescent, NULL if it can not be allocated
+ */
+// ****************************************************************************************
+RcuReader * rcu_hash_map_register_reader(RcuHashMap *map);
+
+
+// ****************************************************************************************
+// rcu_hash_map_unregister_reader
+// ****************************************************************************************
+/**
+ *  Unregister and free a reader of #map, once it will not read the map anymore
+ * @param[in]    map        RCU Hash Map
+ * @param[in]    reader     Reader handle given by #rcu_hash_map_register_reader
+ */
+// ****************************************************************************************
+void rcu_hash_map_unregister_reader(RcuHashMap *map, RcuReader *reader);
+
+
+// ****************************************************************************************
+// rcu_hash_map_quiescent
+// ****************************************************************************************
+/**
+ *  Announce that #reader holds no node, key or value obtained from #map
+ * @param[in]    map        RCU Hash Map
+ * @param[in]    reader     Reader handle of the calling thread
+ *
+ * @details      It only writes #reader cache line. Memory is not reclaimed while some
+ *               registered reader does not call it, so long running readers must call
+ *               it periodically.
+ */
+// ****************************************************************************************
+void rcu_hash_map_quiescent(RcuHashMap *map, RcuReader *reader);
+
+
+// ****************************************************************************************
+// rcu_hash_map_get
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key, without taking any lock
+ * @param[in]    map        RCU Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ *
+ * @details      Value is valid until the calling reader next calls #rcu_hash_map_quiescent.
+ */
+// ****************************************************************************************
+void * rcu_hash_map_get(RcuHashMap *map, const char *key);
+
+
+// ****************************************************************************************
+// rcu_hash_map_set
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key. If key already exist, replace its value
+ * @param[in]    map        RCU Hash Map to be set
+ * @param[in]    key        Key of pair key-value (it is copied)
+ * @param[in]    value      Value of pair key-value
+ * @return       CLIB_OK    if pair is set \n
+ *               CLIB_ERROR if it can not be allocated
+ *
+ * @details      A replaced value is freed with the map free_value after a grace period.
+ */
+// ****************************************************************************************
+int rcu_hash_map_set(RcuHashMap *map, const char *key, void *value);
+
+
+// ****************************************************************************************
+// rcu_hash_map_remove
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key
+ * @param[in]    map        RCU Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ *
+ * @details      Node and value are freed after a grace period.
+ */
+// ****************************************************************************************
+int rcu_hash_map_remove(RcuHashMap *map, const char *key);
+
+
+// ****************************************************************************************
+// rcu_hash_map_synchronize
+// ****************************************************************************************
+/**
+ *  Wait until every memory removed from #map so far is freed
+ * @param[in]    map        RCU Hash Map
+ *
+ * @details      Waits for every registered reader to call #rcu_hash_map_quiescent, so it
+ *               must not be called by a registered reader of #map.
+ */
+// ****************************************************************************************
+void rcu_hash_map_synchronize(RcuHashMap *map);
+
+
+// ****************************************************************************************
+// rcu_hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every node, key, value and reader
+ * @param[in]    map         RCU Hash Map to be destroyed (no thread may be using it)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void rcu_hash_map_destroy(RcuHashMap *map);
+
+
+
+//=======================================================================================//
+//                                                                                       //
+//                                     Cache API                                         //
+//                                                                                       //
+//=======================================================================================//
+
+
+/********************************** STRUCTURES **************************************/
+
+/// Entry chosen for eviction when a full cache receives a new key
+typedef enum {
+    CACHE_LRU,                  //< Least recently used entry (every hit moves its entry)
+    CACHE_SIEVE,                //< Oldest entry not used since the hand last passed (hits only set a bit)
+} CachePolicy;
+
+/// Function called with every entry evicted to make room for a new one
+typedef void (*EvictionCallback)(const char *key, void *value, void *ctx);
+
+/// Bounded key-value cache
+typedef struct {
+    HashMap *map;               //< Key -> list node of its entry
+    LinkedList *entries;        //< Entries, newest (or most recently used with LRU) first
+    ListNode *hand;             //< Next entry SIEVE checks for eviction (NULL for the oldest one)
+    unsigned int capacity;      //< Most entries held at once
+    CachePolicy policy;         //< Eviction policy
+    EvictionCallback on_evict;  //< Called with every evicted entry (NULL for none)
+    void *ctx;                  //< Context given to #on_evict
+    unsigned long hits;         //< Gets finding their key
+    unsigned long misses;       //< Gets not finding their key
+    unsigned long evictions;    //< Entries evicted to make room for new ones
+} Cache;
+
+
+// ****************************************************************************************
+// create_cache
+// ****************************************************************************************
+/**
+ *  Initialice a cache holding up to #capacity entries
+ * @param[in]    capacity   Most entries held at once (at least 1)
+ * @param[in]    policy     Eviction policy
+ * @param[in]    on_evict   Function called with every evicted entry (NULL for none)
+ * @param[in]    ctx        Context given to #on_evict
+ * @param[out]   none
+ * @return       Pointer to a valid cache, NULL if #capacity is 0 or it can not be allocated
+ *
+ * @details      Keys are stored on a Hash Map whose values are the list nodes of their
+ *               entries, so a hit costs a single lookup. #CACHE_LRU moves the entry of
+ *               every hit to the front of the list. #CACHE_SIEVE only marks it as visited:
+ *               on eviction a hand walks from the oldest entry to the newest one, clearing
+ *               marks, and evicts the first entry it finds unmarked. New entries always go
+ *               to the front, and SIEVE never moves an entry afterwards, so hits do not
+ *               write list links and popular keys survive scans of keys used once.
+ */
+// ****************************************************************************************
+Cache * create_cache(unsigned int capacity, CachePolicy policy, EvictionCallback on_evict, void *ctx);
+
+
+// ****************************************************************************************
+// cache_get
+// ****************************************************************************************
+/**
+ *  Get the value of #key on #cache, marking its entry as used
+ * @param[in]    cache      Cache to search
+ * @param[in]    key        Key to search
+ * @param[out]   none
+ * @return       Value of #key, NULL if #key is not cached
+ */
+// ****************************************************************************************
+void * cache_get(Cache *cache, const char *key);
+
+
+// ****************************************************************************************
+// cache_put
+// ****************************************************************************************
+/**
+ *  Set the value of #key on #cache, evicting an entry if #cache is full
+ * @param[in]    cache      Cache to be set
+ * @param[in]    key        Key of the entry (copied)
+ * @param[in]    value      Value of the entry
+ * @param[out]   none
+ * @return       Previous value of #key, or NULL if #key was not cached. NULL is returned
+ *               too if the entry can not be allocated, #key is not cached then
+ *
+ * @details      Updating a cached key marks its entry as used, and does not evict. A new
+ *               key is never its own victim.
+ */
+// ****************************************************************************************
+void * cache_put(Cache *cache, const char *key, void *value);
+
+
+// ****************************************************************************************
+// cache_remove
+// ****************************************************************************************
+/**
+ *  Remove the entry of #key from #cache
+ * @param[in]    cache      Cache to remove the entry from
+ * @param[in]    key        Key of the entry
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @param[out]   none
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ *
+ * @details      Eviction callback is not called for removed entries.
+ */
+// ****************************************************************************************
+int cache_remove(Cache *cache, const char *key, void (*free_value)(void *));
+
+
+// ****************************************************************************************
+// cache_destroy
+// ****************************************************************************************
+/**
+ *  Delete #cache and every entry on it
+ * @param[in]    cache      Cache to be destroyed
+ * @param[in]    free_value Function to free values (NULL if values must not be freed)
  * @param[out]   none
  * @return       none
  */
 // ****************************************************************************************
-void hash_map_print(HashMap* t , void (*print)(void*));
+void cache_destroy(Cache *cache, void (*free_value)(void *));
 
 
 
@@ -818,7 +2849,7 @@ typedef enum {
 /// TreeNode definition
 typedef struct{
     void *content;                 //< Pointer to storing node data
-    LinkedList *children;           //< List of children nodes
+    LinkedList children;            //< List of children nodes
 } TreeNode;
 
 /// Tree defintion
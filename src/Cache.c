@@ -0,0 +1,266 @@
+// ****************************************************************************************
+/**
+ * @file   Cache.c
+ * @brief  Bounded key-value cache with LRU or SIEVE eviction
+ *
+ * @details Entries live on a Linked List, newest first, and a Hash Map takes every key to
+ *          the list node of its entry, so gets, updates and evictions never search the
+ *          list. LRU moves the entry of a hit to the front, SIEVE only marks it and lets
+ *          the eviction hand skip it once.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+/// Biggest initial Hash Map size, bigger caches let the map grow
+#define MAX_INITIAL_SIZE        (1 << 30)
+
+/// Content of every list node
+typedef struct {
+    void *value;                //< Value of the entry
+    bool visited;               //< Entry used since SIEVE hand last passed
+    size_t key_len;             //< Length of #key
+    char key[];                 //< Key of the entry (NUL terminated), to remove it on eviction
+} CacheEntry;
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+/// Mark #node as used by #policy
+static inline void cache_touch(Cache *cache, ListNode *node) {
+    if (cache->policy == CACHE_LRU)
+        list_move_front(cache->entries, node);
+    else
+        ((CacheEntry *)node->content)->visited = true;
+}
+
+/// Remove #node from list and map, returning its entry. SIEVE hand moves on if it was there
+static CacheEntry * cache_unlink(Cache *cache, ListNode *node) {
+    // Hand walks from oldest to newest entry (#next side), head sentinel ends the walk
+    if (cache->hand == node)
+        cache->hand = node->next == &cache->entries->head ? NULL : node->next;
+    CacheEntry *entry = list_remove_node(cache->entries, node);
+    hash_map_remove_len(cache->map, entry->key, entry->key_len, NULL);
+    return entry;
+}
+
+
+// ****************************************************************************************
+// cache_victim
+// ****************************************************************************************
+/*  Private function to choose the entry evicted by #cache policy
+ * @param[in]    cache      Cache with at least two entries
+ * @param[in]    fresh      Entry being inserted, on the first position, never chosen
+ * @return       List node of the entry to evict
+ */
+// ****************************************************************************************
+static ListNode * cache_victim(Cache *cache, ListNode *fresh) {
+    LinkedList *entries = cache->entries;
+    ListNode *oldest = entries->tail.next;
+    if (cache->policy == CACHE_LRU)
+        return oldest;
+
+    ListNode *node = cache->hand ? cache->hand : oldest;
+    CacheEntry *entry;
+    while ((entry = node->content)->visited) {
+        entry->visited = false;
+        // Walk wraps before #fresh, so only entries older than the put are candidates
+        node = node->next == fresh ? oldest : node->next;
+    }
+    // Hand stays on the victim, so unlinking it moves the hand to the next newer entry
+    cache->hand = node;
+    return node;
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// create_cache
+// ****************************************************************************************
+/**
+ *  Initialice a cache holding up to #capacity entries
+ * @param[in]    capacity   Most entries held at once (at least 1)
+ * @param[in]    policy     Eviction policy
+ * @param[in]    on_evict   Function called with every evicted entry (NULL for none)
+ * @param[in]    ctx        Context given to #on_evict
+ * @param[out]   none
+ * @return       Pointer to a valid cache, NULL if #capacity is 0 or it can not be allocated
+ */
+// ****************************************************************************************
+Cache * create_cache(unsigned int capacity, CachePolicy policy, EvictionCallback on_evict, void *ctx) {
+    if (capacity == 0)
+        return NULL;
+    Cache *cache = malloc(sizeof(Cache));
+    if (!cache)
+        return NULL;
+    // Map is sized for a full cache, so it never grows while the cache is in use
+    cache->map = create_hash_map(capacity < MAX_INITIAL_SIZE ? (int)capacity : MAX_INITIAL_SIZE);
+    if (!cache->map) {
+        free(cache);
+        return NULL;
+    }
+    cache->entries = create_linked_list();
+    if (!cache->entries) {
+        hash_map_destroy(cache->map, NULL);
+        free(cache);
+        return NULL;
+    }
+    cache->hand = NULL;
+    cache->capacity = capacity;
+    cache->policy = policy;
+    cache->on_evict = on_evict;
+    cache->ctx = ctx;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+    return cache;
+}
+
+
+// ****************************************************************************************
+// cache_get
+// ****************************************************************************************
+/**
+ *  Get the value of #key on #cache, marking its entry as used
+ * @param[in]    cache      Cache to search
+ * @param[in]    key        Key to search
+ * @param[out]   none
+ * @return       Value of #key, NULL if #key is not cached
+ */
+// ****************************************************************************************
+void * cache_get(Cache *cache, const char *key) {
+    ListNode *node = hash_map_get_len(cache->map, key, strlen(key));
+    if (!node) {
+        cache->misses++;
+        return NULL;
+    }
+    cache->hits++;
+    cache_touch(cache, node);
+    return ((CacheEntry *)node->content)->value;
+}
+
+
+// ****************************************************************************************
+// cache_put
+// ****************************************************************************************
+/**
+ *  Set the value of #key on #cache, evicting an entry if #cache is full
+ * @param[in]    cache      Cache to be set
+ * @param[in]    key        Key of the entry (copied)
+ * @param[in]    value      Value of the entry
+ * @param[out]   none
+ * @return       Previous value of #key, or NULL if #key was not cached. NULL is returned
+ *               too if the entry can not be allocated, #key is not cached then
+ */
+// ****************************************************************************************
+void * cache_put(Cache *cache, const char *key, void *value) {
+    size_t len = strlen(key);
+    // Key is hashed and searched once, a miss leaves a NULL slot for the new entry
+    void **slot = hash_map_get_or_insert_len(cache->map, key, len);
+    if (!slot)
+        return NULL;
+    if (*slot) {
+        ListNode *node = *slot;
+        CacheEntry *entry = node->content;
+        void *previous = entry->value;
+        entry->value = value;
+        cache_touch(cache, node);
+        return previous;
+    }
+
+    CacheEntry *entry = malloc(sizeof(CacheEntry) + len + 1);
+    if (!entry) {
+        hash_map_remove_len(cache->map, key, len, NULL);
+        return NULL;
+    }
+    entry->value = value;
+    entry->visited = false;
+    entry->key_len = len;
+    memcpy(entry->key, key, len + 1);
+    list_push_front(cache->entries, entry);
+    ListNode *fresh = cache->entries->head.prev;
+    *slot = fresh;
+
+    // Slot is filled before evicting, as removing the victim key may move it
+    if (cache->map->count > cache->capacity) {
+        CacheEntry *victim = cache_unlink(cache, cache_victim(cache, fresh));
+        // Hand restarts from the oldest entry instead of resting on the new one
+        if (cache->hand == fresh)
+            cache->hand = NULL;
+        cache->evictions++;
+        if (cache->on_evict)
+            cache->on_evict(victim->key, victim->value, cache->ctx);
+        free(victim);
+    }
+    return NULL;
+}
+
+
+// ****************************************************************************************
+// cache_remove
+// ****************************************************************************************
+/**
+ *  Remove the entry of #key from #cache
+ * @param[in]    cache      Cache to remove the entry from
+ * @param[in]    key        Key of the entry
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @param[out]   none
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ */
+// ****************************************************************************************
+int cache_remove(Cache *cache, const char *key, void (*free_value)(void *)) {
+    ListNode *node = hash_map_get_len(cache->map, key, strlen(key));
+    if (!node)
+        return CLIB_ERROR;
+    CacheEntry *entry = cache_unlink(cache, node);
+    if (free_value)
+        free_value(entry->value);
+    free(entry);
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// cache_destroy
+// ****************************************************************************************
+/**
+ *  Delete #cache and every entry on it
+ * @param[in]    cache      Cache to be destroyed
+ * @param[in]    free_value Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void cache_destroy(Cache *cache, void (*free_value)(void *)) {
+    while (!list_is_empty(cache->entries)) {
+        CacheEntry *entry = list_pop_front(cache->entries);
+        if (free_value)
+            free_value(entry->value);
+        free(entry);
+    }
+    list_destroy(cache->entries);
+    hash_map_destroy(cache->map, NULL);
+    free(cache);
+}
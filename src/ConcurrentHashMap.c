@@ -0,0 +1,442 @@
+// ****************************************************************************************
+/**
+ * @file   ConcurrentHashMap.c
+ * @brief  Implementation of a thread safe hash map on C
+ *
+ * @details Chained table whose entries are protected by a fixed set of reader/writer
+ *          locks (lock striping).
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+
+//=======================================================================================//
+//                                                                                       //
+//                             Concurrent Hash Map API                                   //
+//                                                                                       //
+//=======================================================================================//
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+
+// ****************************************************************************************
+// concurrent_stripe
+// ****************************************************************************************
+/*  Private function to obtain the stripe protecting the table entry of #hash
+ * @param[in]    map        Concurrent Hash Map
+ * @param[in]    hash       Full hash of the key
+ */
+// ****************************************************************************************
+static inline ConcurrentStripe * concurrent_stripe(ConcurrentHashMap *map, uint64_t hash) {
+    return &map->stripes[hash & (CONCURRENT_MAP_STRIPES - 1)];
+}
+
+
+// ****************************************************************************************
+// concurrent_find
+// ****************************************************************************************
+/*  Private function to find the link pointing to the node of #key (stripe must be locked)
+ * @param[in]    map        Concurrent Hash Map to search
+ * @param[in]    hash       Full hash of #key
+ * @param[in]    key        Key to find
+ * @param[in]    len        Length of #key
+ * @return       Pointer to the chain link pointing to the node of #key, or to the NULL
+ *               link ending its chain if #key does not exist
+ */
+// ****************************************************************************************
+static MapNode ** concurrent_find(ConcurrentHashMap *map, uint64_t hash, const char *key, size_t len) {
+    MapNode **link = &map->list[hash & (uint64_t)(map->size - 1)];
+    while (*link) {
+        MapNode *node = *link;
+        if (node->hash == hash && node->key_len == len && memcmp(node->key, key, len) == 0)
+            break;
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+
+// ****************************************************************************************
+// concurrent_insert
+// ****************************************************************************************
+/*  Private function to obtain the value slot of #key, inserting it if it does not exist
+ *  (stripe must be write locked)
+ * @param[in]    map        Concurrent Hash Map to search
+ * @param[in]    hash       Full hash of #key
+ * @param[in]    key        Key to insert
+ * @param[in]    len        Length of #key
+ * @param[out]   inserted   True if #key did not exist
+ * @return       Pointer to the value of #key, NULL if the node can not be allocated
+ */
+// ****************************************************************************************
+static void ** concurrent_insert(ConcurrentHashMap *map, uint64_t hash, const char *key, size_t len,
+                                 bool *inserted) {
+    MapNode **link = concurrent_find(map, hash, key, len);
+    *inserted = false;
+    if (*link)
+        return &(*link)->value;
+
+    // Keys are malloced one by one when they do not fit inline, an arena would need its own lock
+    MapNode *node = malloc(sizeof(MapNode));
+    if (!node)
+        return NULL;
+    node->key = len < MAP_NODE_INLINE_KEY ? node->key_data : malloc(len + 1);
+    if (!node->key) {
+        free(node);
+        return NULL;
+    }
+    memcpy(node->key, key, len);
+    node->key[len] = '\0';
+    node->key_len = (uint32_t)len;
+    node->hash = hash;
+    node->value = NULL;
+    node->next = NULL;
+    *link = node;
+    concurrent_stripe(map, hash)->count++;
+    *inserted = true;
+    return &node->value;
+}
+
+
+// ****************************************************************************************
+// concurrent_free_node
+// ****************************************************************************************
+/*  Private function to free #node and its key
+ * @param[in]    node       Node to free
+ */
+// ****************************************************************************************
+static void concurrent_free_node(MapNode *node) {
+    if (node->key != node->key_data)
+        free(node->key);
+    free(node);
+}
+
+
+// ****************************************************************************************
+// concurrent_resize
+// ****************************************************************************************
+/*  Private function to double #map table if it still has #size entries
+ * @param[in]    map        Concurrent Hash Map to resize
+ * @param[in]    size       Number of entries seen by the caller when it decided to resize
+ *
+ * @details      Every stripe is write locked, always in the same order so concurrent
+ *               resizes can not deadlock. Several threads may ask for the same resize,
+ *               only the first one doubles the table.
+ */
+// ****************************************************************************************
+static void concurrent_resize(ConcurrentHashMap *map, int size) {
+    for (int i = 0; i < CONCURRENT_MAP_STRIPES; i++)
+        pthread_rwlock_wrlock(&map->stripes[i].lock);
+
+    MapNode **list = map->size == size && size < (1 << 30)
+        ? calloc((size_t)size * 2, sizeof(MapNode *)) : NULL;
+    if (list) {
+        for (int i = 0; i < size; i++) {
+            MapNode *node = map->list[i], *next;
+            while (node) {
+                next = node->next;
+                MapNode **bucket = &list[node->hash & (uint64_t)(size * 2 - 1)];
+                node->next = *bucket;
+                *bucket = node;
+                node = next;
+            }
+        }
+        free(map->list);
+        map->list = list;
+        map->size = size * 2;
+    }
+
+    for (int i = CONCURRENT_MAP_STRIPES - 1; i >= 0; i--)
+        pthread_rwlock_unlock(&map->stripes[i].lock);
+}
+
+
+// ****************************************************************************************
+// concurrent_erase
+// ****************************************************************************************
+/*  Private function to remove #key from #map
+ * @param[in]    map        Concurrent Hash Map to remove pair
+ * @param[in]    key        Key to remove
+ * @param[out]   value      Value of removed pair
+ * @return       true if #key existed
+ */
+// ****************************************************************************************
+static bool concurrent_erase(ConcurrentHashMap *map, const char *key, void **value) {
+    size_t len = strlen(key);
+    uint64_t hash = hash_bytes(key, len, map->seed);
+    ConcurrentStripe *stripe = concurrent_stripe(map, hash);
+
+    pthread_rwlock_wrlock(&stripe->lock);
+    MapNode **link = concurrent_find(map, hash, key, len);
+    MapNode *node = *link;
+    if (node) {
+        *link = node->next;
+        *value = node->value;
+        stripe->count--;
+    }
+    pthread_rwlock_unlock(&stripe->lock);
+
+    if (!node)
+        return false;
+    concurrent_free_node(node);
+    return true;
+}
+
+
+// ****************************************************************************************
+// concurrent_upsert
+// ****************************************************************************************
+/*  Private function to set or update the value of #key with its stripe write locked
+ * @param[in]    map        Concurrent Hash Map to update
+ * @param[in]    key        Key of pair key-value
+ * @param[in]    update     Function giving the new value (NULL to store #ctx as value)
+ * @param[in]    ctx        User pointer given to #update, or new value
+ * @param[out]   prev_value Previous value of #key (NULL if it did not exist)
+ * @return       New value of #key, NULL if the pair can not be allocated
+ */
+// ****************************************************************************************
+static void * concurrent_upsert(ConcurrentHashMap *map, const char *key, UpdateFunction update, void *ctx,
+                                void **prev_value) {
+    size_t len = strlen(key);
+    uint64_t hash = hash_bytes(key, len, map->seed);
+    ConcurrentStripe *stripe = concurrent_stripe(map, hash);
+    void *value = NULL;
+    bool inserted, grow = false;
+    int size;
+
+    *prev_value = NULL;
+    if (len > UINT32_MAX)
+        return NULL;
+
+    pthread_rwlock_wrlock(&stripe->lock);
+    void **slot = concurrent_insert(map, hash, key, len, &inserted);
+    if (slot) {
+        *prev_value = *slot;
+        value = *slot = update ? (*update)(*slot, ctx) : ctx;
+    }
+    // Every stripe owns size / CONCURRENT_MAP_STRIPES entries, grow at load factor 1
+    size = map->size;
+    grow = inserted && stripe->count > (unsigned int)(size / CONCURRENT_MAP_STRIPES);
+    pthread_rwlock_unlock(&stripe->lock);
+
+    if (grow)
+        concurrent_resize(map, size);
+    return value;
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// create_concurrent_hash_map
+// ****************************************************************************************
+/**
+ *  Initialice a Hash Map that can be used by several threads at the same time
+ * @param[in]    size  Initial size for the Hash Map (rounded up to a power of two)
+ * @param[out]   none
+ * @return       Pointer to a valid Concurrent Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Table entries are split on #CONCURRENT_MAP_STRIPES stripes, every one with
+ *               its own reader/writer lock. Operations only lock the stripe of their key,
+ *               so threads using different stripes never wait for each other, and gets of
+ *               the same stripe run in parallel.
+ *               The stripe of a key is given by the low bits of its hash, which also
+ *               select its table entry, so doubling the table keeps every key on its
+ *               stripe. The table doubles, taking every stripe lock in order, once a
+ *               stripe holds more pairs than its share of table entries.
+ */
+// ****************************************************************************************
+ConcurrentHashMap * create_concurrent_hash_map(int size) {
+    ConcurrentHashMap *map = aligned_alloc(CLIB_CACHE_LINE, sizeof(ConcurrentHashMap));
+    if (!map)
+        return NULL;
+    map->size = CONCURRENT_MAP_STRIPES;
+    while (map->size < size && map->size < (1 << 30))
+        map->size <<= 1;
+    map->list = calloc((size_t)map->size, sizeof(MapNode *));
+    if (!map->list) {
+        free(map);
+        return NULL;
+    }
+    for (int i = 0; i < CONCURRENT_MAP_STRIPES; i++) {
+        pthread_rwlock_init(&map->stripes[i].lock, NULL);
+        map->stripes[i].count = 0;
+    }
+    map->seed = hash_map_new_seed(map);
+    return map;
+}
+
+
+// ****************************************************************************************
+// concurrent_hash_map_set
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key. If key already exist, update its value
+ * @param[in]    map        Concurrent Hash Map to be set
+ * @param[in]    key        Key of pair key-value (it is copied)
+ * @param[in]    value      Value of pair key-value
+ * @return       Pointer to previous value if #key already exists, or NULL in other case
+ */
+// ****************************************************************************************
+void * concurrent_hash_map_set(ConcurrentHashMap *map, const char *key, void *value) {
+    void *prev_value;
+    concurrent_upsert(map, key, NULL, value, &prev_value);
+    return prev_value;
+}
+
+
+// ****************************************************************************************
+// concurrent_hash_map_get
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key
+ * @param[in]    map        Concurrent Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ *
+ * @note         Map does not protect values: a value returned here may be removed and
+ *               freed by other thread at any moment, unless callers agree otherwise.
+ */
+// ****************************************************************************************
+void * concurrent_hash_map_get(ConcurrentHashMap *map, const char *key) {
+    size_t len = strlen(key);
+    uint64_t hash = hash_bytes(key, len, map->seed);
+    ConcurrentStripe *stripe = concurrent_stripe(map, hash);
+
+    pthread_rwlock_rdlock(&stripe->lock);
+    MapNode *node = *concurrent_find(map, hash, key, len);
+    void *value = node ? node->value : NULL;
+    pthread_rwlock_unlock(&stripe->lock);
+    return value;
+}
+
+
+// ****************************************************************************************
+// concurrent_hash_map_update
+// ****************************************************************************************
+/**
+ *  Replace the value of #key on #map with the value returned by #update, atomically
+ * @param[in]    map        Concurrent Hash Map to update
+ * @param[in]    key        Key of pair key-value, inserted if it does not exist
+ * @param[in]    update     Function called with current value (NULL if #key is new) and #ctx
+ * @param[in]    ctx        User pointer given to #update
+ * @return       New value of #key, NULL if the pair can not be allocated
+ *
+ * @details      #update runs with the stripe of #key locked, so no other thread reads or
+ *               writes #key meanwhile. It must be short and must not use #map.
+ */
+// ****************************************************************************************
+void * concurrent_hash_map_update(ConcurrentHashMap *map, const char *key, UpdateFunction update, void *ctx) {
+    void *prev_value;
+    return concurrent_upsert(map, key, update, ctx, &prev_value);
+}
+
+
+// ****************************************************************************************
+// concurrent_hash_map_remove
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key
+ * @param[in]    map        Concurrent Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ */
+// ****************************************************************************************
+int concurrent_hash_map_remove(ConcurrentHashMap *map, const char *key, void (*free_value)(void *)) {
+    void *value;
+    if (!concurrent_erase(map, key, &value))
+        return CLIB_ERROR;
+    if (free_value)
+        (*free_value)(value);
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// concurrent_hash_map_pop
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key and return value
+ * @param[in]    map        Concurrent Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @return       Value of removed pair, or NULL if #key does not exist
+ */
+// ****************************************************************************************
+void * concurrent_hash_map_pop(ConcurrentHashMap *map, const char *key) {
+    void *value;
+    if (!concurrent_erase(map, key, &value))
+        return NULL;
+    return value;
+}
+
+
+// ****************************************************************************************
+// concurrent_hash_map_count
+// ****************************************************************************************
+/**
+ *  Obtain the number of key-value pairs of #map
+ * @param[in]    map        Concurrent Hash Map
+ * @return       Number of pairs (only exact if no other thread is modifying #map)
+ */
+// ****************************************************************************************
+unsigned int concurrent_hash_map_count(ConcurrentHashMap *map) {
+    unsigned int count = 0;
+    for (int i = 0; i < CONCURRENT_MAP_STRIPES; i++) {
+        pthread_rwlock_rdlock(&map->stripes[i].lock);
+        count += map->stripes[i].count;
+        pthread_rwlock_unlock(&map->stripes[i].lock);
+    }
+    return count;
+}
+
+
+// ****************************************************************************************
+// concurrent_hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every node and key, and every value given #free_value
+ * @param[in]    map         Concurrent Hash Map to be destroyed (no thread may be using it)
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void concurrent_hash_map_destroy(ConcurrentHashMap *map, void (*free_value)(void *)) {
+    MapNode *tmp, *next;
+    for (int i = 0; i < map->size; i++) {
+        tmp = map->list[i];
+        while (tmp) {
+            next = tmp->next;
+            if (free_value)
+                (*free_value)(tmp->value);
+            concurrent_free_node(tmp);
+            tmp = next;
+        }
+    }
+    for (int i = 0; i < CONCURRENT_MAP_STRIPES; i++)
+        pthread_rwlock_destroy(&map->stripes[i].lock);
+    free(map->list);
+    free(map);
+}
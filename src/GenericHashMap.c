@@ -0,0 +1,292 @@
+// ****************************************************************************************
+/**
+ * @file   GenericHashMap.c
+ * @brief  Implementation of a hash map with any key type on C
+ *
+ * @details Keys are user pointers hashed and compared through user callbacks.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+
+//=======================================================================================//
+//                                                                                       //
+//                              Generic Hash Map API                                     //
+//                                                                                       //
+//=======================================================================================//
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+static uint64_t hashInt(const void *key) {
+    return (uint64_t)(unsigned int)*(const int *)key;
+}
+
+static uint64_t hashString(const void *key) {
+    return hash_bytes(key, strlen((const char *)key), 0);
+}
+
+static uint64_t hashPointer(const void *key) {
+    return (uint64_t)(uintptr_t)key;
+}
+
+KeyHashFunction HASH_INT = hashInt;
+KeyHashFunction HASH_STRING = hashString;
+KeyHashFunction HASH_POINTER = hashPointer;
+
+
+// ****************************************************************************************
+// generic_hash_key
+// ****************************************************************************************
+/*  Private function to calculate the full hash of #key, remixing the user hash with #map seed
+ * @param[in]    map        Generic Hash Map of the key
+ * @param[in]    key        Key to hash
+ */
+// ****************************************************************************************
+static inline uint64_t generic_hash_key(GenericHashMap *map, void *key) {
+    uint64_t hash = (*map->hash)(key);
+    return hash_bytes(&hash, sizeof(hash), map->seed);
+}
+
+
+// ****************************************************************************************
+// generic_find
+// ****************************************************************************************
+/*  Private function to find the link pointing to the node of #key
+ * @param[in]    map        Generic Hash Map to search
+ * @param[in]    hash       Full hash of #key
+ * @param[in]    key        Key to find
+ * @return       Pointer to the chain link pointing to the node of #key, or to the NULL
+ *               link ending its chain if #key does not exist
+ */
+// ****************************************************************************************
+static GenericMapNode ** generic_find(GenericHashMap *map, uint64_t hash, void *key) {
+    GenericMapNode **link = &map->list[hash & (uint64_t)(map->size - 1)];
+    while (*link) {
+        if ((*link)->hash == hash && (*map->compare)(key, (*link)->key) == 0)
+            break;
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+
+// ****************************************************************************************
+// generic_resize
+// ****************************************************************************************
+/*  Private function to move every node of #map into a table of #size entries
+ * @param[in]    map        Generic Hash Map to resize
+ * @param[in]    size       New number of table entries (power of two)
+ */
+// ****************************************************************************************
+static void generic_resize(GenericHashMap *map, int size) {
+    GenericMapNode **list = calloc((size_t)size, sizeof(GenericMapNode *));
+    if (!list)
+        return;
+    for (int i = 0; i < map->size; i++) {
+        GenericMapNode *node = map->list[i], *next;
+        while (node) {
+            next = node->next;
+            GenericMapNode **bucket = &list[node->hash & (uint64_t)(size - 1)];
+            node->next = *bucket;
+            *bucket = node;
+            node = next;
+        }
+    }
+    free(map->list);
+    map->list = list;
+    map->size = size;
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// create_generic_hash_map
+// ****************************************************************************************
+/**
+ *  Initialice a Hash Map whose keys are any pointer, given its #hash and #compare functions
+ * @param[in]    size     Initial size for the Hash Map (rounded up to a power of two)
+ * @param[in]    hash     Function to hash keys
+ * @param[in]    compare  Function to compare keys, returning 0 if they are equal
+ * @param[out]   none
+ * @return       Pointer to a valid Generic Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Keys are stored by pointer, they are never copied nor freed by the map, so
+ *               they must stay valid and unchanged while their pair is on the map.
+ *               User hashes are remixed with a per map seed, so weak hashes (e.g. the
+ *               identity of an integer) still spread over the whole table.
+ *               The table doubles when the number of pairs exceeds its size.
+ */
+// ****************************************************************************************
+GenericHashMap * create_generic_hash_map(int size, KeyHashFunction hash, ContentComparator compare) {
+    GenericHashMap *map = malloc(sizeof(GenericHashMap));
+    if (!map)
+        return NULL;
+    map->size = 1;
+    while (map->size < size && map->size < (1 << 30))
+        map->size <<= 1;
+    map->list = calloc((size_t)map->size, sizeof(GenericMapNode *));
+    if (!map->list) {
+        free(map);
+        return NULL;
+    }
+    map->count = 0;
+    map->hash = hash;
+    map->compare = compare;
+    map->seed = hash_map_new_seed(map);
+    return map;
+}
+
+
+// ****************************************************************************************
+// generic_hash_map_set
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key. If key already exist, update its value
+ * @param[in]    map        Generic Hash Map to be set
+ * @param[in]    key        Key of pair key-value (stored by pointer)
+ * @param[in]    value      Value of pair key-value
+ * @return       Pointer to previous value if #key already exists, or NULL in other case
+ *
+ * @details      When #key already exists the key stored on first set is kept.
+ */
+// ****************************************************************************************
+void * generic_hash_map_set(GenericHashMap *map, void *key, void *value) {
+    uint64_t hash = generic_hash_key(map, key);
+    GenericMapNode **link = generic_find(map, hash, key);
+    if (*link) {
+        void *prev_value = (*link)->value;
+        (*link)->value = value;
+        return prev_value;
+    }
+
+    GenericMapNode *node = malloc(sizeof(GenericMapNode));
+    if (!node)
+        return NULL;
+    node->key = key;
+    node->value = value;
+    node->hash = hash;
+    // Insert new node in the beginning of the list
+    GenericMapNode **bucket = &map->list[hash & (uint64_t)(map->size - 1)];
+    node->next = *bucket;
+    *bucket = node;
+
+    if (++map->count > (unsigned int)map->size && map->size < (1 << 30))
+        generic_resize(map, map->size * 2);
+    return NULL;
+}
+
+
+// ****************************************************************************************
+// generic_hash_map_get
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key
+ * @param[in]    map        Generic Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ */
+// ****************************************************************************************
+void * generic_hash_map_get(GenericHashMap *map, void *key) {
+    GenericMapNode *node = *generic_find(map, generic_hash_key(map, key), key);
+    return node ? node->value : NULL;
+}
+
+
+// ****************************************************************************************
+// generic_hash_map_remove
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key
+ * @param[in]    map        Generic Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ */
+// ****************************************************************************************
+int generic_hash_map_remove(GenericHashMap *map, void *key, void (*free_value)(void *)) {
+    GenericMapNode **link = generic_find(map, generic_hash_key(map, key), key);
+    GenericMapNode *node = *link;
+    if (!node)
+        return CLIB_ERROR;
+
+    *link = node->next;
+    if (free_value)
+        (*free_value)(node->value);
+    free(node);
+    map->count--;
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// generic_hash_map_pop
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key and return value
+ * @param[in]    map        Generic Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @return       Value of removed pair, or NULL if #key does not exist
+ */
+// ****************************************************************************************
+void * generic_hash_map_pop(GenericHashMap *map, void *key) {
+    GenericMapNode **link = generic_find(map, generic_hash_key(map, key), key);
+    GenericMapNode *node = *link;
+    if (!node)
+        return NULL;
+
+    void *value = node->value;
+    *link = node->next;
+    free(node);
+    map->count--;
+    return value;
+}
+
+
+// ****************************************************************************************
+// generic_hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every node, and every value given #free_value
+ * @param[in]    map         Generic Hash Map to be destroyed
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void generic_hash_map_destroy(GenericHashMap *map, void (*free_value)(void *)) {
+    GenericMapNode *tmp, *next;
+    for (int i = 0; i < map->size; i++) {
+        tmp = map->list[i];
+        while (tmp) {
+            next = tmp->next;
+            if (free_value)
+                (*free_value)(tmp->value);
+            free(tmp);
+            tmp = next;
+        }
+    }
+    free(map->list);
+    free(map);
+}
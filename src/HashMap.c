@@ -23,6 +23,7 @@
 // ********************************** Include Files ***************************************
 // ****************************************************************************************
 #include "Clib.h"
+#include "HashMapEngine.h"
 
 
 //=======================================================================================//
@@ -36,39 +37,921 @@
 /***************** Private Auxiliary Functions Implementations ****************/
 /******************************************************************************/
 
+/// Number of keys hashed and prefetched together by batched operations
+#define HASH_MAP_BATCH                  (16)
+
+/// Secret constants of the hash function (wyhash default secret)
+static const uint64_t HASH_SECRET[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+/// Counter used to give a different seed to every map created (#hash_map_new_seed)
+static uint64_t seed_counter = 0;
+
+
+// ****************************************************************************************
+// hash_mum
+// ****************************************************************************************
+/*  Private function to multiply #a by #b as 128 bit, leaving low part on #a and high part on #b
+ * @param[in]    a          First factor, low 64 bits of result on return
+ * @param[in]    b          Second factor, high 64 bits of result on return
+ */
+// ****************************************************************************************
+static inline void hash_mum(uint64_t *a, uint64_t *b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), lo = t + (rm1 << 32);
+    uint64_t c = (t < rl) + (lo < t);
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+
+static inline uint64_t hash_mix(uint64_t a, uint64_t b) {
+    hash_mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t hash_read8(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t hash_read4(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t hash_read3(const uint8_t *p, size_t k) {
+    return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+}
+
+
 // ****************************************************************************************
 // hash_code
 // ****************************************************************************************
-/*  Private function to calculate postion in hash table given #key
+/*  Private function to calculate postion in hash table given the #hash of a key
  * @param[in]    map        Hash Map to obtain position
- * @param[in]    key        Key to obtain position
+ * @param[in]    hash       Full hash of the key
+ */
+// ****************************************************************************************
+static inline int hash_code(HashMap *map, uint64_t hash) {
+    return (int)(hash & (uint64_t)(map->size - 1));
+}
+
+
+// ****************************************************************************************
+// table_size
+// ****************************************************************************************
+/*  Private function to round #size up to a power of two
+ * @param[in]    size       Requested number of table entries
+ */
+// ****************************************************************************************
+static int table_size(unsigned long size) {
+    int pow = 1;
+    while ((unsigned long)pow < size && pow < (1 << 30))
+        pow <<= 1;
+    return pow;
+}
+
+
+// ****************************************************************************************
+// hash_map_bucket
+// ****************************************************************************************
+/*  Private function to obtain the table entry where a key with #hash is stored
+ * @param[in]    map        Hash Map to obtain entry
+ * @param[in]    hash       Full hash of the key
  *
- * @details      this is a very simple implementation of a hash
+ * @details      While rehashing, keys whose old entry has not been moved yet are still on
+ *               #old_list, so a key is always on exactly one chain.
+ */
+// ****************************************************************************************
+static inline MapNode ** hash_map_bucket(HashMap *map, uint64_t hash) {
+    if (map->old_list) {
+        int old_pos = (int)(hash & (uint64_t)(map->old_size - 1));
+        if (old_pos >= map->rehash_pos)
+            return &map->old_list[old_pos];
+    }
+    return &map->list[hash_code(map, hash)];
+}
+
+
+/// Number of 64 bit words of the occupancy bitmap of a table of #size entries
+static inline size_t occupied_words(int size) {
+    return ((size_t)size + 63) / 64;
+}
+
+
+// ****************************************************************************************
+// chained_mark
+// ****************************************************************************************
+/*  Private function to update the occupancy bit of the #list entry of #hash
+ * @param[in]    map        Hash Map whose entry changed
+ * @param[in]    hash       Full hash of the inserted or removed key
+ */
+// ****************************************************************************************
+static inline void chained_mark(HashMap *map, uint64_t hash) {
+    int pos = hash_code(map, hash);
+    if (map->list[pos])
+        map->occupied[pos >> 6] |= 1ull << (pos & 63);
+    else
+        map->occupied[pos >> 6] &= ~(1ull << (pos & 63));
+}
+
+
+// ****************************************************************************************
+// occupied_next
+// ****************************************************************************************
+/*  Private function to find the first non empty #list entry at or after #from
+ * @param[in]    map        Hash Map to search
+ * @param[in]    from       First entry to check
+ * @return       Position of the entry, or #map size if there is none
+ */
+// ****************************************************************************************
+static size_t occupied_next(HashMap *map, size_t from) {
+    size_t size = (size_t)map->size, word = from >> 6, words = occupied_words(map->size);
+    if (from >= size)
+        return size;
+    uint64_t bits = map->occupied[word] & (~0ull << (from & 63));
+    while (!bits) {
+        if (++word >= words)
+            return size;
+        bits = map->occupied[word];
+    }
+    return word * 64 + (size_t)__builtin_ctzll(bits);
+}
+
+
+// ****************************************************************************************
+// hash_map_rehash_step
+// ****************************************************************************************
+/*  Private function to move up to #steps non empty entries of #old_list into #list
+ * @param[in]    map        Hash Map being rehashed
+ * @param[in]    steps      Number of non empty entries to move
  *
+ * @details      At most 10 empty entries are visited per step, bounding the work per call.
  */
 // ****************************************************************************************
-int hash_code(HashMap *map, char *key) {
-    int pos = 0;
-    for (int i = 0; i < (int)strlen(key); ++i)
-        pos += key[i];
-    return pos % map->size;
+static void hash_map_rehash_step(HashMap *map, int steps) {
+    long empty_visits = (long)steps * 10;
+    while (steps > 0 && map->rehash_pos < map->old_size) {
+        MapNode *node = map->old_list[map->rehash_pos];
+        if (!node) {
+            map->rehash_pos++;
+            if (--empty_visits == 0)
+                break;
+            continue;
+        }
+        while (node) {
+            MapNode *next = node->next;
+            int pos = hash_code(map, node->hash);
+            node->next = map->list[pos];
+            map->list[pos] = node;
+            map->occupied[pos >> 6] |= 1ull << (pos & 63);
+            node = next;
+        }
+        map->old_list[map->rehash_pos++] = NULL;
+        steps--;
+    }
+    if (map->rehash_pos >= map->old_size) {
+        FREE_TO_NULL(map->old_list);
+        map->old_size = 0;
+        map->rehash_pos = 0;
+    }
 }
 
+
+// ****************************************************************************************
+// hash_map_resize
+// ****************************************************************************************
+/*  Private function to replace #map table with a table of #size entries
+ * @param[in]    map        Hash Map to resize
+ * @param[in]    size       New number of table entries (power of two)
+ * @param[in]    incremental  Move nodes on later calls instead of moving them now
+ * @return       CLIB_OK    if new table is allocated \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+static int hash_map_resize(HashMap *map, int size, bool incremental) {
+    // Only one rehash at a time, finish the pending one first
+    if (map->old_list)
+        hash_map_rehash_step(map, map->old_size);
+
+    MapNode **list = calloc((size_t)size, sizeof(MapNode *));
+    uint64_t *occupied = calloc(occupied_words(size), sizeof(uint64_t));
+    if (!list || !occupied) {
+        free(list);
+        free(occupied);
+        return CLIB_ERROR;
+    }
+
+    // Entries of #old_list are not tracked, iterators finish the rehash first
+    free(map->occupied);
+    map->occupied = occupied;
+    map->old_list = map->list;
+    map->old_size = map->size;
+    map->rehash_pos = 0;
+    map->list = list;
+    map->size = size;
+    if (!incremental)
+        hash_map_rehash_step(map, map->old_size);
+    return CLIB_OK;
+}
+
+// ****************************************************************************************
+// hash_key
+// ****************************************************************************************
+/*  Private function to calculate the full hash of #key with the seed of #map
+ * @param[in]    map        Hash Map owning the hash seed
+ * @param[in]    key        Key to hash
+ * @param[in]    len        Length of #key
+ */
+// ****************************************************************************************
+static inline uint64_t hash_key(HashMap *map, const void *key, size_t len) {
+    return hash_bytes(key, len, map->seed);
+}
+
+
+/// Context of #print_map traversal
+typedef struct {
+    void (*print_func)(void *);
+    int position;
+} PrintContext;
+
+static void print_visitor(const char *key, size_t key_len, void *value, void *ctx) {
+    (void)key;
+    (void)key_len;
+    PrintContext *print = ctx;
+    printf("Elem: %d\n---------------------------\n", print->position++);
+    (*print->print_func)(value);
+}
+
+static void free_visitor(const char *key, size_t key_len, void *value, void *ctx) {
+    (void)key;
+    (void)key_len;
+    (*(void (**)(void *))ctx)(value);
+}
+
+
+/// Block of the key bump allocator
+struct key_arena_block {
+    struct key_arena_block *next;   //< Previously filled block
+    size_t used;                    //< Bytes already given from #data
+    size_t capacity;                //< Bytes of #data
+    char data[];                    //< Key storage
+};
+
+/// Freed chunk of a key arena block, waiting on the free list of its size class
+struct key_arena_chunk {
+    struct key_arena_chunk *next;   //< Next free chunk of the same size class
+};
+
+/// Allocation longer than #KEY_ARENA_MAX_CHUNK, linked so the arena can free it on destroy
+struct key_arena_large {
+    struct key_arena_large *prev;   //< Previous large allocation, NULL on the first one
+    struct key_arena_large *next;   //< Next large allocation, NULL on the last one
+    size_t size;                    //< Bytes of #data
+    char data[];                    //< Key storage
+};
+
+/// Key allocator of a Hash Map: size classes carved from blocks, recycled on free lists
+struct key_arena {
+    struct key_arena_block *blocks; //< Block chunks are carved from, older blocks after it
+    struct key_arena_large *large;  //< Allocations longer than #KEY_ARENA_MAX_CHUNK
+    size_t bytes;                   //< Memory of blocks and large allocations
+    struct key_arena_chunk *free[KEY_ARENA_MAX_CHUNK / KEY_ARENA_ALIGN];  //< Free chunks by class
+};
+
+/// Size class of a chunk of #size bytes: chunks of class c are (c + 1) * KEY_ARENA_ALIGN bytes
+static inline size_t key_arena_class(size_t size) {
+    return size ? (size - 1) / KEY_ARENA_ALIGN : 0;
+}
+
+
+// ****************************************************************************************
+// key_arena_alloc
+// ****************************************************************************************
+/**
+ *  Obtain #size bytes for a key from #map key arena
+ * @param[in]    map        Hash Map owning the arena
+ * @param[in]    size       Number of bytes
+ * @return       Pointer to #size bytes aligned to #KEY_ARENA_ALIGN, valid until they are
+ *               given back with #key_arena_free or the map is destroyed. NULL if they can
+ *               not be allocated
+ */
+// ****************************************************************************************
+char * key_arena_alloc(HashMap *map, size_t size) {
+    struct key_arena *arena = map->key_arena;
+    if (!arena) {
+        arena = calloc(1, sizeof(struct key_arena));
+        if (!arena)
+            return NULL;
+        map->key_arena = arena;
+    }
+
+    if (size > KEY_ARENA_MAX_CHUNK) {
+        struct key_arena_large *large = malloc(sizeof(struct key_arena_large) + size);
+        if (!large)
+            return NULL;
+        large->prev = NULL;
+        large->next = arena->large;
+        large->size = size;
+        if (arena->large)
+            arena->large->prev = large;
+        arena->large = large;
+        arena->bytes += size;
+        return large->data;
+    }
+
+    // Chunks freed by removed keys are reused first, so churn does not grow the arena
+    size_t class = key_arena_class(size);
+    struct key_arena_chunk *chunk = arena->free[class];
+    if (chunk) {
+        arena->free[class] = chunk->next;
+        return (char *)chunk;
+    }
+    size_t bytes = (class + 1) * KEY_ARENA_ALIGN;
+    struct key_arena_block *block = arena->blocks;
+    if (!block || block->capacity - block->used < bytes) {
+        block = malloc(sizeof(struct key_arena_block) + KEY_ARENA_BLOCK);
+        if (!block)
+            return NULL;
+        block->next = arena->blocks;
+        block->used = 0;
+        block->capacity = KEY_ARENA_BLOCK;
+        arena->blocks = block;
+        arena->bytes += KEY_ARENA_BLOCK;
+    }
+    char *key = block->data + block->used;
+    block->used += bytes;
+    return key;
+}
+
+
+// ****************************************************************************************
+// key_arena_free
+// ****************************************************************************************
+/**
+ *  Give back to #map key arena #size bytes obtained from #key_arena_alloc
+ * @param[in]    map        Hash Map owning the arena
+ * @param[in]    key        Bytes to give back
+ * @param[in]    size       Number of bytes, the same asked to #key_arena_alloc
+ *
+ * @details      Chunks are kept for the next keys of the same size class, allocations
+ *               longer than #KEY_ARENA_MAX_CHUNK go back to the system right away.
+ */
+// ****************************************************************************************
+void key_arena_free(HashMap *map, char *key, size_t size) {
+    struct key_arena *arena = map->key_arena;
+    if (size > KEY_ARENA_MAX_CHUNK) {
+        struct key_arena_large *large = (struct key_arena_large *)(void *)(key - offsetof(struct key_arena_large, data));
+        if (large->prev)
+            large->prev->next = large->next;
+        else
+            arena->large = large->next;
+        if (large->next)
+            large->next->prev = large->prev;
+        arena->bytes -= large->size;
+        free(large);
+        return;
+    }
+    struct key_arena_chunk *chunk = (struct key_arena_chunk *)(void *)key;
+    chunk->next = arena->free[key_arena_class(size)];
+    arena->free[key_arena_class(size)] = chunk;
+}
+
+
+// ****************************************************************************************
+// key_arena_bytes
+// ****************************************************************************************
+/**
+ *  Obtain the memory reserved by #map key arena, free chunks included
+ * @param[in]    map        Hash Map owning the arena
+ * @return       Bytes of every block and large allocation of the arena
+ */
+// ****************************************************************************************
+size_t key_arena_bytes(HashMap *map) {
+    return map->key_arena ? map->key_arena->bytes : 0;
+}
+
+
+// ****************************************************************************************
+// key_arena_destroy
+// ****************************************************************************************
+/**
+ *  Free every block of #map key arena
+ * @param[in]    map        Hash Map owning the arena
+ */
+// ****************************************************************************************
+void key_arena_destroy(HashMap *map) {
+    struct key_arena *arena = map->key_arena;
+    if (!arena)
+        return;
+    struct key_arena_block *block = arena->blocks, *next;
+    while (block) {
+        next = block->next;
+        free(block);
+        block = next;
+    }
+    struct key_arena_large *large = arena->large, *next_large;
+    while (large) {
+        next_large = large->next;
+        free(large);
+        large = next_large;
+    }
+    FREE_TO_NULL(map->key_arena);
+}
+
+
+/// Engines indexed by #HashMapEngine
+static const HashMapOps * const HASH_MAP_ENGINES[] = {
+    [HASH_MAP_CHAINED] = &CHAINED_MAP_OPS,
+    [HASH_MAP_SWISS] = &SWISS_MAP_OPS,
+    [HASH_MAP_COMPACT] = &COMPACT_MAP_OPS,
+    [HASH_MAP_CUCKOO] = &CUCKOO_MAP_OPS,
+    [HASH_MAP_MAPPED] = &MAPPED_MAP_OPS,
+    [HASH_MAP_FROZEN] = &FROZEN_MAP_OPS,
+};
+
+
+// ****************************************************************************************
+// hash_map_prefetch_batch
+// ****************************************************************************************
+/*  Private function to hash a batch of keys and prefetch every memory their lookups read
+ * @param[in]    map        Hash Map to search
+ * @param[in]    keys       Batch of at most #HASH_MAP_BATCH keys
+ * @param[in]    batch      Number of keys
+ * @param[out]   hashes     Full hash of every key
+ * @param[out]   lens       Length of every key
+ *
+ * @details      Every stage issues the loads of the whole batch before the next stage
+ *               needs them, so up to #batch cache misses are in flight at the same time.
+ */
+// ****************************************************************************************
+static void hash_map_prefetch_batch(HashMap *map, const char * const *keys, size_t batch,
+                                    uint64_t *hashes, size_t *lens) {
+    const HashMapOps *ops = HASH_MAP_ENGINES[map->engine];
+    for (size_t i = 0; i < batch; i++) {
+        lens[i] = strlen(keys[i]);
+        hashes[i] = hash_key(map, keys[i], lens[i]);
+    }
+    for (int stage = 0; stage < HASH_MAP_PREFETCH_STAGES; stage++) {
+        for (size_t i = 0; i < batch; i++)
+            ops->prefetch(map, hashes[i], stage);
+    }
+}
+
+
+/// State of #engine_rebuild copy
+typedef struct {
+    HashMap *fresh;
+    bool failed;
+} RebuildContext;
+
+static void rebuild_visitor(const char *key, size_t key_len, void *value, void *ctx) {
+    RebuildContext *rebuild = ctx;
+    bool inserted;
+    void **slot = HASH_MAP_ENGINES[rebuild->fresh->engine]->insert(
+        rebuild->fresh, hash_key(rebuild->fresh, key, key_len), key, key_len, &inserted);
+    if (slot)
+        *slot = value;
+    else
+        rebuild->failed = true;
+}
+
+
+// ****************************************************************************************
+// engine_rebuild
+// ****************************************************************************************
+/*  Private function to replace the engine storage of #map with a new one sized for its
+ *  pairs, copying every pair and key
+ * @param[in]    map        Hash Map to rebuild
+ * @return       CLIB_OK    if #map is rebuilt \n
+ *               CLIB_ERROR if new storage can not be allocated (#map is left unchanged)
+ *
+ * @details      Pairs are inserted on #foreach order, so insertion ordered engines keep
+ *               their order.
+ */
+// ****************************************************************************************
+static int engine_rebuild(HashMap *map) {
+    HashMap *fresh = create_hash_map_engine((int)map->count, map->engine);
+    if (!fresh)
+        return CLIB_ERROR;
+    // Same seed, so hashes (and a filter built from them) stay valid
+    fresh->seed = map->seed;
+    RebuildContext rebuild = { fresh, false };
+    HASH_MAP_ENGINES[map->engine]->foreach(map, rebuild_visitor, &rebuild);
+    if (rebuild.failed) {
+        hash_map_destroy(fresh, NULL);
+        return CLIB_ERROR;
+    }
+
+    HASH_MAP_ENGINES[map->engine]->destroy(map);
+    key_arena_destroy(map);
+    map->engine_data = fresh->engine_data;
+    map->key_arena = fresh->key_arena;
+    map->size = fresh->size;
+    free(fresh);
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// hash_map_shrink
+// ****************************************************************************************
+/*  Private function to shrink #map table once its load is under its min load factor
+ * @param[in]    map        Hash Map a key was just removed from
+ *
+ * @details      New table is left half full. Chained tables shrink with an incremental
+ *               rehash, like they grow, other engines are rebuilt on this call.
+ */
+// ****************************************************************************************
+static void hash_map_shrink(HashMap *map) {
+    if (!((float)map->count < map->min_load_factor * (float)map->size) || map->size <= HASH_MAP_MIN_SHRINK_SIZE)
+        return;
+    if (map->engine != HASH_MAP_CHAINED) {
+        engine_rebuild(map);
+        return;
+    }
+    int size = table_size((unsigned long)((float)map->count * 2 / map->max_load_factor) + 1);
+    if (!map->old_list && size < map->size)
+        hash_map_resize(map, size, true);
+}
+
+
+// ****************************************************************************************
+// hash_map_erase
+// ****************************************************************************************
+/*  Private function to remove #key from #map, asking its filter first if it has one
+ * @param[in]    map        Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    len        Length of #key in bytes
+ * @param[out]   value      Value of removed pair
+ * @return       true if #key existed
+ */
+// ****************************************************************************************
+static bool hash_map_erase(HashMap *map, const void *key, size_t len, void **value) {
+    uint64_t hash = hash_key(map, key, len);
+    if (map->filter && !filter_may_contain(map->filter, hash))
+        return false;
+    if (!HASH_MAP_ENGINES[map->engine]->erase(map, hash, key, len, value))
+        return false;
+    if (map->filter)
+        filter_remove(map);
+    if (map->min_load_factor > 0)
+        hash_map_shrink(map);
+    return true;
+}
+
+
+//=======================================================================================//
+//                                                                                       //
+//                                Chained engine                                         //
+//                                                                                       //
+//=======================================================================================//
+
+// ****************************************************************************************
+// chained_find
+// ****************************************************************************************
+/*  Private function to find the link pointing to the node of #key
+ * @param[in]    map        Hash Map to search
+ * @param[in]    hash       Full hash of #key
+ * @param[in]    key        Key to find
+ * @param[in]    len        Length of #key
+ * @return       Pointer to the chain link pointing to the node of #key, or to the NULL
+ *               link ending its chain if #key does not exist
+ */
+// ****************************************************************************************
+static MapNode ** chained_find(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    if (map->old_list)
+        hash_map_rehash_step(map, HASH_MAP_REHASH_STEP);
+    MapNode **link = hash_map_bucket(map, hash);
+    while (*link) {
+        MapNode *node = *link;
+        HASH_MAP_COUNT(map, probes);
+        if (node->hash == hash && node->key_len == len) {
+            HASH_MAP_COUNT(map, compares);
+            if (memcmp(node->key, key, len) == 0)
+                break;
+        }
+        link = &(*link)->next;
+    }
+    return link;
+}
+
+static void * chained_get(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    MapNode *node = *chained_find(map, hash, key, len);
+    return node ? node->value : NULL;
+}
+
+static void ** chained_insert(HashMap *map, uint64_t hash, const char *key, size_t len, bool *inserted) {
+    MapNode *node = *chained_find(map, hash, key, len);
+    if (node) {
+        *inserted = false;
+        return &node->value;
+    }
+
+    // If key does not exist, create a node
+    node = malloc(sizeof(MapNode));
+    if (!node)
+        return NULL;
+    node->flags = 0;
+    node->key = len < MAP_NODE_INLINE_KEY ? node->key_data : key_arena_alloc(map, len + 1);
+    if (!node->key) {
+        free(node);
+        return NULL;
+    }
+    memcpy(node->key, key, len);
+    node->key[len] = '\0';
+    node->key_len = (uint32_t)len;
+    node->value = NULL;
+    node->hash = hash;
+    // Insert new node in the beginning of the list
+    MapNode **bucket = hash_map_bucket(map, hash);
+    node->next = *bucket;
+    *bucket = node;
+    chained_mark(map, hash);
+
+    // Start doubling the table once max load factor is exceeded
+    if (++map->count > (unsigned int)(map->max_load_factor * (float)map->size)
+            && !map->old_list && map->size < (1 << 30))
+        hash_map_resize(map, map->size * 2, true);
+
+    *inserted = true;
+    return &node->value;
+}
+
+static bool chained_erase(HashMap *map, uint64_t hash, const char *key, size_t len, void **value) {
+    MapNode **link = chained_find(map, hash, key, len);
+    MapNode *node = *link;
+    if (!node)
+        return false;
+
+    *link = node->next;
+    *value = node->value;
+    // Slab nodes and their keys are freed with their slab, on the key arena
+    if (!(node->flags & MAP_NODE_SLAB)) {
+        if (node->key != node->key_data)
+            key_arena_free(map, node->key, node->key_len + 1);
+        free(node);
+    }
+    map->count--;
+    chained_mark(map, hash);
+    return true;
+}
+
+static int chained_reserve(HashMap *map, unsigned int count) {
+    int size = table_size((unsigned long)((float)count / map->max_load_factor) + 1);
+    if (size <= map->size) {
+        return CLIB_OK;
+    }
+    return hash_map_resize(map, size, false);
+}
+
+static void chained_foreach(HashMap *map, EntryVisitor visit, void *ctx) {
+    MapNode *tmp;
+    for (size_t i = occupied_next(map, 0); i < (size_t)map->size; i = occupied_next(map, i + 1)) {
+        for (tmp = map->list[i]; tmp; tmp = tmp->next)
+            (*visit)(tmp->key, tmp->key_len, tmp->value, ctx);
+    }
+    // Entries of a pending rehash, already moved ones are NULL
+    for (int i = map->rehash_pos; i < map->old_size; i++) {
+        for (tmp = map->old_list[i]; tmp; tmp = tmp->next)
+            (*visit)(tmp->key, tmp->key_len, tmp->value, ctx);
+    }
+}
+
+static bool chained_iter_next(HashMap *map, HashMapIter *it) {
+    MapNode *node = it->cursor;
+    if (!node) {
+        size_t pos = occupied_next(map, it->position);
+        if (pos >= (size_t)map->size)
+            return false;
+        node = map->list[pos];
+        it->position = pos + 1;
+    }
+    it->cursor = node->next;
+    it->key = node->key;
+    it->key_len = node->key_len;
+    it->value = node->value;
+    return true;
+}
+
+static void chained_prefetch(HashMap *map, uint64_t hash, int stage) {
+    MapNode **bucket = hash_map_bucket(map, hash);
+    if (stage == 0)
+        HASH_MAP_PREFETCH(bucket);
+    else if (*bucket && stage == 1)
+        HASH_MAP_PREFETCH(*bucket);
+    else if (*bucket && (*bucket)->key != (*bucket)->key_data)
+        HASH_MAP_PREFETCH((*bucket)->key);
+}
+
+static void chained_stats(HashMap *map, HashMapStats *stats) {
+    for (int i = 0; i < map->size + map->old_size; i++) {
+        unsigned int chain = 0;
+        MapNode *tmp = i < map->size ? map->list[i] : map->old_list[i - map->size];
+        // Entries of #old_list already moved are not part of the table anymore
+        if (i >= map->size && i - map->size < map->rehash_pos)
+            continue;
+        for (; tmp; tmp = tmp->next)
+            chain++;
+        stats->chain_histogram[chain < HASH_MAP_STATS_HISTOGRAM ? chain : HASH_MAP_STATS_HISTOGRAM - 1]++;
+        if (chain > stats->max_chain)
+            stats->max_chain = chain;
+    }
+}
+
+static void chained_destroy(HashMap *map) {
+    MapNode *tmp, *next;
+    for (int i = 0; i < map->size + map->old_size; i++) {
+        tmp = i < map->size ? map->list[i] : map->old_list[i - map->size];
+        while (tmp) {
+            next = tmp->next;
+            if (!(tmp->flags & MAP_NODE_SLAB))
+                free(tmp);
+            tmp = next;
+        }
+    }
+    free(map->list);
+    free(map->old_list);
+    free(map->occupied);
+}
+
+
+// ****************************************************************************************
+// chained_compact
+// ****************************************************************************************
+/*  Private function to shrink #map table to its pairs and move every node and long key
+ *  into a single slab, laid out on table order
+ * @param[in]    map        Hash Map with #HASH_MAP_CHAINED engine
+ * @return       CLIB_OK    if #map is compacted \n
+ *               CLIB_ERROR if new storage can not be allocated (#map is left unchanged)
+ */
+// ****************************************************************************************
+static int chained_compact(HashMap *map) {
+    if (map->old_list)
+        hash_map_rehash_step(map, map->old_size);
+
+    // Table never grows here, so every new entry gathers old entries p, p + size, ...
+    int size = table_size((unsigned long)((float)map->count / map->max_load_factor) + 1);
+    size = size < map->size ? size : map->size;
+    size_t blob_bytes = 0;
+    for (int i = 0; i < map->size; i++) {
+        for (MapNode *node = map->list[i]; node; node = node->next)
+            blob_bytes += node->key_len >= MAP_NODE_INLINE_KEY ? node->key_len + 1 : 0;
+    }
+
+    struct key_arena *old_arena = map->key_arena;
+    MapNode **list = calloc((size_t)size, sizeof(MapNode *));
+    uint64_t *occupied = calloc(occupied_words(size), sizeof(uint64_t));
+    map->key_arena = NULL;
+    char *storage = list && occupied
+        ? key_arena_alloc(map, map->count * sizeof(MapNode) + blob_bytes + sizeof(void *)) : NULL;
+    if (!storage) {
+        free(list);
+        free(occupied);
+        map->key_arena = old_arena;
+        return CLIB_ERROR;
+    }
+    MapNode *slab = (MapNode *)(void *)(storage + (-(uintptr_t)storage & (sizeof(void *) - 1)));
+    char *blob = (char *)(slab + map->count);
+
+    for (int pos = 0; pos < size; pos++) {
+        for (int i = pos; i < map->size; i += size) {
+            MapNode *node = map->list[i], *next;
+            for (; node; node = next) {
+                next = node->next;
+                *slab = *node;
+                slab->flags = MAP_NODE_SLAB;
+                if (node->key_len < MAP_NODE_INLINE_KEY) {
+                    slab->key = slab->key_data;
+                } else {
+                    memcpy(blob, node->key, node->key_len + 1);
+                    slab->key = blob;
+                    blob += node->key_len + 1;
+                }
+                slab->next = list[pos];
+                list[pos] = slab++;
+                if (!(node->flags & MAP_NODE_SLAB))
+                    free(node);
+            }
+        }
+        if (list[pos])
+            occupied[pos >> 6] |= 1ull << (pos & 63);
+    }
+
+    // Old keys and slabs are not referenced anymore
+    struct key_arena *new_arena = map->key_arena;
+    map->key_arena = old_arena;
+    key_arena_destroy(map);
+    map->key_arena = new_arena;
+    free(map->list);
+    free(map->occupied);
+    map->list = list;
+    map->occupied = occupied;
+    map->size = size;
+    return CLIB_OK;
+}
+
+const HashMapOps CHAINED_MAP_OPS = {
+    .get = chained_get,
+    .insert = chained_insert,
+    .erase = chained_erase,
+    .reserve = chained_reserve,
+    .foreach = chained_foreach,
+    .iter_next = chained_iter_next,
+    .prefetch = chained_prefetch,
+    .stats = chained_stats,
+    .destroy = chained_destroy,
+};
+
+
 /******************************************************************************/
 /*********************** Public Functions Implementations *********************/
 /******************************************************************************/
 
 
+// ****************************************************************************************
+// hash_bytes
+// ****************************************************************************************
+/**
+ *  Calculate a 64 bit hash of #len bytes starting at #data
+ * @param[in]    data  Pointer to the bytes to be hashed (no alignment required)
+ * @param[in]    len   Number of bytes to hash
+ * @param[in]    seed  Seed of the hash, different seeds give independent hash functions
+ * @param[out]   none
+ * @return       64 bit hash value
+ *
+ * @details      wyhash based implementation, it consumes the input 8 bytes at a time and
+ *               mixes them with 64x64->128 bit multiplications.
+ */
+// ****************************************************************************************
+uint64_t hash_bytes(const void *data, size_t len, uint64_t seed) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint64_t a, b;
+
+    seed ^= hash_mix(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+    if (len <= 16) {
+        if (len >= 4) {
+            a = (hash_read4(p) << 32) | hash_read4(p + ((len >> 3) << 2));
+            b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - ((len >> 3) << 2));
+        } else if (len > 0) {
+            a = hash_read3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = hash_mix(hash_read8(p) ^ HASH_SECRET[1], hash_read8(p + 8) ^ seed);
+                see1 = hash_mix(hash_read8(p + 16) ^ HASH_SECRET[2], hash_read8(p + 24) ^ see1);
+                see2 = hash_mix(hash_read8(p + 32) ^ HASH_SECRET[3], hash_read8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = hash_mix(hash_read8(p) ^ HASH_SECRET[1], hash_read8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = hash_read8(p + i - 16);
+        b = hash_read8(p + i - 8);
+    }
+    a ^= HASH_SECRET[1];
+    b ^= seed;
+    hash_mum(&a, &b);
+    return hash_mix(a ^ HASH_SECRET[0] ^ len, b ^ HASH_SECRET[1]);
+}
+
+
 // ****************************************************************************************
 // create_hash_map
 // ****************************************************************************************
 /**
- *  Initialice a Hash Map with a fixed #size
- * @param[in]    size  Size for the Hash Map
+ *  Initialice a Hash Map with an initial #size
+ * @param[in]    size  Initial size for the Hash Map (rounded up to a power of two)
  * @param[out]   none
  * @return       Pointer to a valid Hash Map structure
  *
- * @details
+ * @details      The table doubles when the number of pairs exceeds the max load factor.
+ *               Nodes are moved to the new table incrementally, #HASH_MAP_REHASH_STEP
+ *               entries on every set, get, remove or pop call, so no single call pays
+ *               for a full table rehash.
  *
  * Hash Map initial state:
  *
@@ -90,17 +973,116 @@ int hash_code(HashMap *map, char *key) {
  *
  */
 // ****************************************************************************************
-HashMap * create_hash_map(int size) {
-    HashMap *table = malloc(sizeof(HashMap));
-    table->size = size;
-    table->list = (MapNode **)malloc(sizeof(MapNode *) * (unsigned long)size);
+HashMap * create_hash_map(int size) {
+    return create_hash_map_engine(size, HASH_MAP_CHAINED);
+}
+
+
+// ****************************************************************************************
+// create_hash_map_engine
+// ****************************************************************************************
+/**
+ *  Initialice a Hash Map with an initial #size storing pairs on the given #engine
+ * @param[in]    size    Initial size for the Hash Map
+ * @param[in]    engine  Storage engine of the map
+ * @param[out]   none
+ * @return       Pointer to a valid Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Every hash_map_* function behaves the same with every engine.
+ */
+// ****************************************************************************************
+HashMap * create_hash_map_engine(int size, HashMapEngine engine) {
+    HashMap *table = hash_map_alloc(size, engine);
+    if (!table)
+        return NULL;
+
+    switch (engine) {
+        case HASH_MAP_CHAINED:
+            table->list = (MapNode **)malloc(sizeof(MapNode *) * (unsigned long)table->size);
+            table->occupied = calloc(occupied_words(table->size), sizeof(uint64_t));
+            if (!table->list || !table->occupied) {
+                free(table->list);
+                free(table->occupied);
+                FREE_TO_NULL(table);
+                break;
+            }
+            for (int i = 0; i < table->size; i++)
+                table->list[i] = NULL;
+            break;
+        case HASH_MAP_SWISS:
+            if (swiss_map_init(table, size) != CLIB_OK)
+                FREE_TO_NULL(table);
+            break;
+        case HASH_MAP_COMPACT:
+            if (compact_map_init(table, size) != CLIB_OK)
+                FREE_TO_NULL(table);
+            break;
+        case HASH_MAP_CUCKOO:
+            if (cuckoo_map_init(table, size) != CLIB_OK)
+                FREE_TO_NULL(table);
+            break;
+        case HASH_MAP_MAPPED:   // Only created from an image by #hash_map_open_mapped
+        case HASH_MAP_FROZEN:   // Only created from another map by #hash_map_freeze
+        default:
+            FREE_TO_NULL(table);
+            break;
+    }
+    return table;
+}
 
-    for (int i = 0; i < size; i++)
-        table->list[i] = NULL;
+
+// ****************************************************************************************
+// hash_map_alloc
+// ****************************************************************************************
+/**
+ *  Allocate a Hash Map with the common fields initialiced and no engine storage
+ * @param[in]    size    Initial size for the Hash Map
+ * @param[in]    engine  Storage engine of the map
+ * @return       Pointer to a Hash Map structure, NULL if it can not be allocated
+ */
+// ****************************************************************************************
+HashMap * hash_map_alloc(int size, HashMapEngine engine) {
+    HashMap *table = malloc(sizeof(HashMap));
+    if (!table)
+        return NULL;
+    table->engine = engine;
+    table->engine_data = NULL;
+    table->key_arena = NULL;
+    table->occupied = NULL;
+    memset(&table->get_counters, 0, sizeof(HashMapCounters));
+    memset(&table->set_counters, 0, sizeof(HashMapCounters));
+    table->counting = NULL;
+    table->filter = NULL;
+    table->size = table_size(size > 0 ? (unsigned long)size : 1);
+    table->list = NULL;
+    table->count = 0;
+    table->max_load_factor = HASH_MAP_MAX_LOAD_FACTOR;
+    table->min_load_factor = 0;
+    table->old_size = 0;
+    table->old_list = NULL;
+    table->rehash_pos = 0;
+    // Every map gets its own seed so colliding keys of one map do not collide on others
+    table->seed = hash_map_new_seed(table);
     return table;
 }
 
 
+// ****************************************************************************************
+// hash_map_new_seed
+// ****************************************************************************************
+/**
+ *  Obtain the hash seed of a new map, different for every map created by any thread
+ * @param[in]    owner      Map the seed is for, its address is mixed into the seed
+ * @return       Seed of the hash function of #owner
+ */
+// ****************************************************************************************
+uint64_t hash_map_new_seed(const void *owner) {
+    // Maps may be created from several threads at once
+    uint64_t counter = __atomic_add_fetch(&seed_counter, 1, __ATOMIC_RELAXED);
+    return hash_mix((uint64_t)(uintptr_t)owner ^ HASH_SECRET[2], counter ^ HASH_SECRET[3]);
+}
+
+
 
 // ****************************************************************************************
 // hash_map_set
@@ -132,6 +1114,10 @@ HashMap * create_hash_map(int size) {
  *  |         |                                    |         |
  *  |---------|                                    |---------|
  *
+ * Keys shorter than #MAP_NODE_INLINE_KEY bytes are copied inside the node, longer keys are
+ * copied to a key arena owned by the map, so a new pair costs a single allocation.
+ * Arena space of removed keys is reused by later keys of a similar length.
+ *
  * Collision case: if a collision happens, new node is inserted in the BEGINING of the list given current position
  *
  * Hash Map initial state:                          Hash Map after #hash_map_set (collision case):
@@ -153,30 +1139,8 @@ HashMap * create_hash_map(int size) {
  *  |---------|                                    |---------|
  */
 // ****************************************************************************************
-void * hash_map_set(HashMap *map, char *key, void *value) {
-    int pos = hash_code(map, key);
-    MapNode *tmp = map->list[pos];
-    while (tmp) {
-        // If key already exist, update value
-        if (strcmp(tmp->key, key) == 0){
-            void *prev_value = tmp->value;
-            tmp->value = value;
-            return prev_value;
-        }
-
-        tmp = tmp->next;
-    }
-
-    // If key does not exist, create a node
-    MapNode *new_elem = malloc(sizeof(MapNode));
-    new_elem->key = malloc(strlen(key));
-    strcpy(new_elem->key, key);
-    new_elem->value = value;
-    // Insert new node in the beginning of the list
-    new_elem->next = map->list[pos];
-    map->list[pos] = new_elem;
-
-    return NULL;
+void * hash_map_set(HashMap *map, const char *key, void *value) {
+    return hash_map_set_len(map, key, strlen(key), value);
 }
 
 
@@ -190,16 +1154,8 @@ void * hash_map_set(HashMap *map, char *key, void *value) {
  * @return       Pointer value if #key exists, or NULL if it does not exist
  */
 // ****************************************************************************************
-void * hash_map_get(HashMap *map, char *key) {
-    int pos = hash_code(map, key);
-    MapNode *tmp = map->list[pos];
-    while (tmp) {
-        if (strcmp(tmp->key, key) == 0) {
-            return tmp->value;
-        }
-        tmp = tmp->next;
-    }
-    return NULL;
+void * hash_map_get(HashMap *map, const char *key) {
+    return hash_map_get_len(map, key, strlen(key));
 }
 
 
@@ -256,29 +1212,8 @@ void * hash_map_get(HashMap *map, char *key) {
  *  |---------|                                                       |---------|
  */
 // ****************************************************************************************
-int hash_map_remove(HashMap *map, char *key, void (*free_value)(void *)) {
-
-    int pos = hash_code(map, key);
-    MapNode *tmp = map->list[pos];
-    MapNode *prev = NULL;
-
-    while (tmp) {
-        if (strcmp(tmp->key, key) == 0) {
-            if (prev != NULL) {
-                prev->next = tmp->next;
-            } else {
-                map->list[pos] = tmp->next;
-            }
-            (*free_value)(tmp->value); // TODO: review. Call proper free function
-            // for our value structure
-            free(tmp->value);
-            free(tmp);
-            return CLIB_OK;
-        }
-        prev = tmp;
-        tmp = tmp->next;
-    }
-    return CLIB_ERROR;
+int hash_map_remove(HashMap *map, const char *key, void (*free_value)(void *)) {
+    return hash_map_remove_len(map, key, strlen(key), free_value);
 }
 
 
@@ -296,27 +1231,287 @@ int hash_map_remove(HashMap *map, char *key, void (*free_value)(void *)) {
  * @details      Very similar to #hash_map_remove
  */
 // ****************************************************************************************
-void * hash_map_pop(HashMap *map, char *key) {
+void * hash_map_pop(HashMap *map, const char *key) {
+    return hash_map_pop_len(map, key, strlen(key));
+}
+
+
+// ****************************************************************************************
+// hash_map_set_len
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key of #len bytes. If key already exist, update its value
+ * @param[in]    map        Hash Map to be set
+ * @param[in]    key        Key of pair key-value (any bytes, it does not need a NUL terminator)
+ * @param[in]    len        Length of #key in bytes
+ * @param[in]    value      Value of pair key-value
+ * @return       Pointer to previous value if #key already exists, or NULL in other case
+ *
+ * @details      Keys must be shorter than 4 GiB.
+ */
+// ****************************************************************************************
+void * hash_map_set_len(HashMap *map, const void *key, size_t len, void *value) {
+    bool inserted;
+    if (len > UINT32_MAX)
+        return NULL;
+    uint64_t hash = hash_key(map, key, len);
+    HASH_MAP_COUNT_BEGIN(map, set_counters);
+    void **slot = HASH_MAP_ENGINES[map->engine]->insert(map, hash, key, len, &inserted);
+    HASH_MAP_COUNT_END(map);
+    if (!slot)
+        return NULL;
+    if (inserted && map->filter)
+        filter_add(map, hash);
+    void *prev_value = inserted ? NULL : *slot;
+    *slot = value;
+    return prev_value;
+}
+
+
+// ****************************************************************************************
+// hash_map_get_len
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key of #len bytes
+ * @param[in]    map        Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @param[in]    len        Length of #key in bytes
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ */
+// ****************************************************************************************
+void * hash_map_get_len(HashMap *map, const void *key, size_t len) {
+    uint64_t hash = hash_key(map, key, len);
+    if (map->filter && !filter_may_contain(map->filter, hash)) {
+        HASH_MAP_FILTER_COUNT(map->filter, rejects);
+        return NULL;
+    }
+    HASH_MAP_COUNT_BEGIN(map, get_counters);
+    void *value = HASH_MAP_ENGINES[map->engine]->get(map, hash, key, len);
+    HASH_MAP_COUNT_END(map);
+    if (!value && map->filter)
+        HASH_MAP_FILTER_COUNT(map->filter, false_positives);
+    return value;
+}
+
+
+// ****************************************************************************************
+// hash_map_lookup
+// ****************************************************************************************
+/**
+ *  Get the value of #key, with full #hash, from the engine of #map
+ * @param[in]    map        Hash Map to search
+ * @param[in]    hash       Full hash of #key with the seed of #map
+ * @param[in]    key        Key to search
+ * @param[in]    len        Length of #key in bytes
+ * @return       Value of #key, NULL if it does not exist
+ *
+ * @details      Neither the Bloom filter nor operation counters are touched, so several
+ *               threads can look up the same map at once while no thread changes it and
+ *               no incremental rehash is pending.
+ */
+// ****************************************************************************************
+void * hash_map_lookup(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    return HASH_MAP_ENGINES[map->engine]->get(map, hash, key, len);
+}
+
+
+// ****************************************************************************************
+// hash_map_remove_len
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key of #len bytes
+ * @param[in]    map        Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    len        Length of #key in bytes
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ */
+// ****************************************************************************************
+int hash_map_remove_len(HashMap *map, const void *key, size_t len, void (*free_value)(void *)) {
+    void *value;
+    if (!hash_map_erase(map, key, len, &value))
+        return CLIB_ERROR;
+    if (free_value)
+        (*free_value)(value);
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// hash_map_pop_len
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key of #len bytes and return value
+ * @param[in]    map        Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    len        Length of #key in bytes
+ * @return       Value of removed pair, or NULL if #key does not exist
+ */
+// ****************************************************************************************
+void * hash_map_pop_len(HashMap *map, const void *key, size_t len) {
+    void *value;
+    if (!hash_map_erase(map, key, len, &value))
+        return NULL;
+    return value;
+}
+
+
+// ****************************************************************************************
+// hash_map_get_or_insert
+// ****************************************************************************************
+/**
+ *  Get the value slot of #key on #map, inserting #key with a NULL value if it does not exist
+ * @param[in]    map        Hash Map to search
+ * @param[in]    key        Key of pair key-value
+ * @return       Pointer to the value of #key, NULL if the pair can not be allocated
+ *
+ * @details      Key is hashed and searched only once, so read-modify-write code such as
+ *               counters pays a single probe:
+ *
+ *                   void **slot = hash_map_get_or_insert(map, word);
+ *                   *slot = (void *)((uintptr_t)*slot + 1);
+ *
+ *               Slot is valid until next call inserting or removing keys of #map.
+ */
+// ****************************************************************************************
+void ** hash_map_get_or_insert(HashMap *map, const char *key) {
+    return hash_map_get_or_insert_len(map, key, strlen(key));
+}
+
+
+// ****************************************************************************************
+// hash_map_get_or_insert_len
+// ****************************************************************************************
+/**
+ *  Get the value slot of #key of #len bytes, inserting #key with a NULL value if it does not exist
+ * @param[in]    map        Hash Map to search
+ * @param[in]    key        Key of pair key-value (any bytes, it does not need a NUL terminator)
+ * @param[in]    len        Length of #key in bytes
+ * @return       Pointer to the value of #key, NULL if the pair can not be allocated
+ *
+ * @details      Same as #hash_map_get_or_insert.
+ */
+// ****************************************************************************************
+void ** hash_map_get_or_insert_len(HashMap *map, const void *key, size_t len) {
+    bool inserted;
+    if (len > UINT32_MAX)
+        return NULL;
+    uint64_t hash = hash_key(map, key, len);
+    HASH_MAP_COUNT_BEGIN(map, set_counters);
+    void **slot = HASH_MAP_ENGINES[map->engine]->insert(map, hash, key, len, &inserted);
+    HASH_MAP_COUNT_END(map);
+    if (slot && inserted && map->filter)
+        filter_add(map, hash);
+    return slot;
+}
+
+
+// ****************************************************************************************
+// hash_map_update
+// ****************************************************************************************
+/**
+ *  Replace the value of #key on #map with the value returned by #update
+ * @param[in]    map        Hash Map to update
+ * @param[in]    key        Key of pair key-value, inserted if it does not exist
+ * @param[in]    update     Function called with current value (NULL if #key is new) and #ctx
+ * @param[in]    ctx        User pointer given to #update
+ * @return       New value of #key, NULL if the pair can not be allocated
+ *
+ * @details      Key is hashed and searched only once. #update must not modify #map.
+ */
+// ****************************************************************************************
+void * hash_map_update(HashMap *map, const char *key, UpdateFunction update, void *ctx) {
+    void **slot = hash_map_get_or_insert_len(map, key, strlen(key));
+    if (!slot)
+        return NULL;
+    *slot = (*update)(*slot, ctx);
+    return *slot;
+}
+
 
-    int pos = hash_code(map, key);
-    MapNode *tmp = map->list[pos];
-    MapNode *prev = NULL;
+// ****************************************************************************************
+// hash_map_get_many
+// ****************************************************************************************
+/**
+ *  Get the values of #n keys on #map
+ * @param[in]    map        Hash Map to obtain values
+ * @param[in]    keys       Keys of pairs key-value to obtain
+ * @param[in]    n          Number of keys
+ * @param[out]   out        Value of every key, or NULL for keys that do not exist
+ * @return       none
+ *
+ * @details      Keys are processed on batches: the whole batch is hashed first, then
+ *               the table entries, nodes and keys of every key are prefetched one stage
+ *               at a time, and only then keys are compared. Cache misses of independent
+ *               lookups overlap instead of stalling one after another, which pays off
+ *               on tables bigger than the CPU caches.
+ */
+// ****************************************************************************************
+void hash_map_get_many(HashMap *map, const char * const *keys, size_t n, void **out) {
+    const HashMapOps *ops = HASH_MAP_ENGINES[map->engine];
+    uint64_t hashes[HASH_MAP_BATCH];
+    size_t lens[HASH_MAP_BATCH];
 
-    while (tmp) {
-        if (strcmp(tmp->key, key) == 0) {
-            if (prev != NULL) {
-                prev->next = tmp->next;
-            } else {
-                map->list[pos] = tmp->next;
+    for (size_t base = 0; base < n; base += HASH_MAP_BATCH) {
+        size_t batch = n - base < HASH_MAP_BATCH ? n - base : HASH_MAP_BATCH;
+        hash_map_prefetch_batch(map, keys + base, batch, hashes, lens);
+        for (size_t i = 0; i < batch; i++) {
+            if (map->filter && !filter_may_contain(map->filter, hashes[i])) {
+                HASH_MAP_FILTER_COUNT(map->filter, rejects);
+                out[base + i] = NULL;
+                continue;
             }
-            void *value = tmp->value;
-            free(tmp);
-            return value;
+            HASH_MAP_COUNT_BEGIN(map, get_counters);
+            out[base + i] = ops->get(map, hashes[i], keys[base + i], lens[i]);
+            HASH_MAP_COUNT_END(map);
+            if (!out[base + i] && map->filter)
+                HASH_MAP_FILTER_COUNT(map->filter, false_positives);
+        }
+    }
+}
+
+
+// ****************************************************************************************
+// hash_map_set_many
+// ****************************************************************************************
+/**
+ *  Set #n key-value pairs on #map. If a key already exist, update its value
+ * @param[in]    map        Hash Map to be set
+ * @param[in]    keys       Keys of pairs key-value
+ * @param[in]    values     Value of every key
+ * @param[in]    n          Number of pairs
+ * @return       CLIB_OK    if every pair is set \n
+ *               CLIB_ERROR if some pair can not be allocated
+ *
+ * @details      Same batching than #hash_map_get_many. Previous values of existing keys
+ *               are overwritten, use #hash_map_set if they must be freed.
+ */
+// ****************************************************************************************
+int hash_map_set_many(HashMap *map, const char * const *keys, void **values, size_t n) {
+    const HashMapOps *ops = HASH_MAP_ENGINES[map->engine];
+    uint64_t hashes[HASH_MAP_BATCH];
+    size_t lens[HASH_MAP_BATCH];
+    int result = CLIB_OK;
+    bool inserted;
+
+    for (size_t base = 0; base < n; base += HASH_MAP_BATCH) {
+        size_t batch = n - base < HASH_MAP_BATCH ? n - base : HASH_MAP_BATCH;
+        hash_map_prefetch_batch(map, keys + base, batch, hashes, lens);
+        for (size_t i = 0; i < batch; i++) {
+            HASH_MAP_COUNT_BEGIN(map, set_counters);
+            void **slot = lens[i] <= UINT32_MAX
+                ? ops->insert(map, hashes[i], keys[base + i], lens[i], &inserted) : NULL;
+            HASH_MAP_COUNT_END(map);
+            if (slot && inserted && map->filter)
+                filter_add(map, hashes[i]);
+            if (slot)
+                *slot = values[base + i];
+            else
+                result = CLIB_ERROR;
         }
-        prev = tmp;
-        tmp = tmp->next;
     }
-    return NULL;
+    return result;
 }
 
 
@@ -332,17 +1527,266 @@ void * hash_map_pop(HashMap *map, char *key) {
  * @return       none
  */
 // ****************************************************************************************
-void print_map(HashMap *map, void (*print_func)(void *)) {
-    MapNode *tmp;
-    int map_position = 0;
+void hash_map_print(HashMap *map, void (*print_func)(void *)) {
+    PrintContext print = { print_func, 0 };
     printf("\nHASH MAP\n");
-    for (int i = 0; i < map->size; i++) {
-        tmp = map->list[i];
-        while (tmp) {
-            printf("Elem: %d\n---------------------------\n", map_position);
-            (*print_func)(tmp->value);
-            tmp = tmp->next;
-            map_position++;
-        }
+    HASH_MAP_ENGINES[map->engine]->foreach(map, print_visitor, &print);
+}
+
+
+// ****************************************************************************************
+// hash_map_iter_begin
+// ****************************************************************************************
+/**
+ *  Place #it before the first pair of #map
+ * @param[in]    map        Hash Map to iterate
+ * @param[out]   it         Iterator to initialice
+ * @return       none
+ *
+ * @details      Pairs are visited on table order:
+ *
+ *                   HashMapIter it;
+ *                   hash_map_iter_begin(map, &it);
+ *                   while (hash_map_iter_next(&it))
+ *                       use(it.key, it.value);
+ *
+ *               A pending incremental rehash is finished here, so every pair is on a
+ *               single table. The chained engine keeps a bitmap of its non empty table
+ *               entries, so empty entries are skipped 64 at a time.
+ *               Inserting or removing keys invalidates the iterator, getting keys or
+ *               setting values of existing keys does not.
+ */
+// ****************************************************************************************
+void hash_map_iter_begin(HashMap *map, HashMapIter *it) {
+    if (map->old_list)
+        hash_map_rehash_step(map, map->old_size);
+    it->map = map;
+    it->position = 0;
+    it->cursor = NULL;
+    it->key = NULL;
+    it->key_len = 0;
+    it->value = NULL;
+}
+
+
+// ****************************************************************************************
+// hash_map_iter_next
+// ****************************************************************************************
+/**
+ *  Move #it to the next pair of its map
+ * @param[in]    it         Iterator initialiced by #hash_map_iter_begin
+ * @return       true if #it points to a pair (on it->key, it->key_len, it->value) \n
+ *               false if every pair was visited
+ */
+// ****************************************************************************************
+bool hash_map_iter_next(HashMapIter *it) {
+    return HASH_MAP_ENGINES[it->map->engine]->iter_next(it->map, it);
+}
+
+
+// ****************************************************************************************
+// hash_map_foreach
+// ****************************************************************************************
+/**
+ *  Call #visit for every pair of #map
+ * @param[in]    map        Hash Map to traverse
+ * @param[in]    visit      Function called with key, key length, value and #ctx of every pair
+ * @param[in]    ctx        User pointer given to #visit
+ * @return       none
+ *
+ * @details      #visit must not insert or remove keys of #map.
+ */
+// ****************************************************************************************
+void hash_map_foreach(HashMap *map, EntryVisitor visit, void *ctx) {
+    HASH_MAP_ENGINES[map->engine]->foreach(map, visit, ctx);
+}
+
+
+// ****************************************************************************************
+// hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every node and key, and every value given #free_value
+ * @param[in]    map         Hash Map to be destroyed
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void hash_map_destroy(HashMap *map, void (*free_value)(void *)) {
+    if (free_value)
+        HASH_MAP_ENGINES[map->engine]->foreach(map, free_visitor, &free_value);
+    HASH_MAP_ENGINES[map->engine]->destroy(map);
+    key_arena_destroy(map);
+    filter_destroy(map);
+    free(map);
+}
+
+
+// ****************************************************************************************
+// hash_map_reserve
+// ****************************************************************************************
+/**
+ *  Grow #map table so it can hold #count pairs without exceeding its max load factor
+ * @param[in]    map        Hash Map to grow
+ * @param[in]    count      Number of pairs expected on the map
+ * @param[out]   none
+ * @return       CLIB_OK    if table is big enough \n
+ *               CLIB_ERROR if table can not be allocated
+ *
+ * @details      Rehash happens on this call, so it should be called before filling the map.
+ */
+// ****************************************************************************************
+int hash_map_reserve(HashMap *map, unsigned int count) {
+    return HASH_MAP_ENGINES[map->engine]->reserve(map, count);
+}
+
+
+// ****************************************************************************************
+// hash_map_set_max_load_factor
+// ****************************************************************************************
+/**
+ *  Set the max ratio of pairs per table entry before #map table doubles
+ * @param[in]    map          Hash Map to configure
+ * @param[in]    load_factor  New max load factor (must be greater than 0)
+ * @param[out]   none
+ * @return       CLIB_OK    if load factor is valid \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+int hash_map_set_max_load_factor(HashMap *map, float load_factor) {
+    if (!(load_factor > 0))
+        return CLIB_ERROR;
+    map->max_load_factor = load_factor;
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// hash_map_set_min_load_factor
+// ****************************************************************************************
+/**
+ *  Set the ratio of pairs per table entry under which removals shrink #map table
+ * @param[in]    map          Hash Map to configure
+ * @param[in]    load_factor  New min load factor, 0 to never shrink (default)
+ * @param[out]   none
+ * @return       CLIB_OK    if load factor is valid \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+int hash_map_set_min_load_factor(HashMap *map, float load_factor) {
+    // Shrinking leaves tables half full, which must not be over the min load already
+    if (!(load_factor >= 0) || !(load_factor < map->max_load_factor / 2))
+        return CLIB_ERROR;
+    map->min_load_factor = load_factor;
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// hash_map_stats
+// ****************************************************************************************
+/**
+ *  Obtain occupancy of #map table and average cost of its operations
+ * @param[in]    map        Hash Map to inspect
+ * @param[out]   stats      Statistics of #map
+ * @return       none
+ *
+ * @details      Occupancy is computed walking the whole table. Operation counters cost
+ *               some increments on every get and set, so they are only compiled when the
+ *               library is built with CLIB_HASH_MAP_STATS defined (make STATS=1); in other
+ *               case #stats counters field is false and averages are 0.
+ *               Every node caches the full hash of its key, so keys are only compared on
+ *               full hash matches: many probes per operation with few compares points to
+ *               long chains (table too small or bad hash spread), not to key compares.
+ */
+// ****************************************************************************************
+void hash_map_stats(HashMap *map, HashMapStats *stats) {
+    memset(stats, 0, sizeof(HashMapStats));
+    stats->count = map->count;
+    stats->size = map->size;
+    stats->load_factor = (float)map->count / (float)map->size;
+    stats->key_arena_bytes = key_arena_bytes(map);
+    HASH_MAP_ENGINES[map->engine]->stats(map, stats);
+    if (map->filter)
+        filter_stats(map, stats);
+
+#ifdef CLIB_HASH_MAP_STATS
+    stats->counters = true;
+    stats->gets = map->get_counters.calls;
+    stats->sets = map->set_counters.calls;
+    if (stats->gets) {
+        stats->probes_per_get = (double)map->get_counters.probes / (double)stats->gets;
+        stats->compares_per_get = (double)map->get_counters.compares / (double)stats->gets;
+    }
+    if (stats->sets) {
+        stats->probes_per_set = (double)map->set_counters.probes / (double)stats->sets;
+        stats->compares_per_set = (double)map->set_counters.compares / (double)stats->sets;
+    }
+#endif
+}
+
+
+// ****************************************************************************************
+// hash_map_freeze
+// ****************************************************************************************
+/**
+ *  Turn #map into a read only table with a minimal perfect hash of its current keys
+ * @param[in]    map        Hash Map to freeze (any engine but #HASH_MAP_MAPPED)
+ * @param[out]   none
+ * @return       CLIB_OK    if #map is frozen (or it already was) \n
+ *               CLIB_ERROR in other case (#map is left unchanged)
+ *
+ * @details      Frozen table is built first, the previous engine storage is only freed
+ *               once it succeeds.
+ */
+// ****************************************************************************************
+int hash_map_freeze(HashMap *map) {
+    if (map->engine == HASH_MAP_FROZEN)
+        return CLIB_OK;
+    // Values of a mapped map point into the mapping, which is released below
+    if (map->engine == HASH_MAP_MAPPED)
+        return CLIB_ERROR;
+    void *frozen = frozen_map_build(map);
+    if (!frozen)
+        return CLIB_ERROR;
+
+    HASH_MAP_ENGINES[map->engine]->destroy(map);
+    key_arena_destroy(map);
+    map->list = NULL;
+    map->old_list = NULL;
+    map->old_size = 0;
+    map->rehash_pos = 0;
+    map->occupied = NULL;
+    map->engine = HASH_MAP_FROZEN;
+    map->engine_data = frozen;
+    map->size = map->count > 0 ? (int)map->count : 1;
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// hash_map_compact
+// ****************************************************************************************
+/**
+ *  Shrink #map table to the pairs it holds, moving them to new contiguous storage
+ * @param[in]    map        Hash Map to compact
+ * @param[out]   none
+ * @return       CLIB_OK    if #map is compacted (read only maps always are) \n
+ *               CLIB_ERROR if new storage can not be allocated (#map is left unchanged)
+ */
+// ****************************************************************************************
+int hash_map_compact(HashMap *map) {
+    switch (map->engine) {
+        case HASH_MAP_CHAINED:
+            return chained_compact(map);
+        case HASH_MAP_SWISS:
+        case HASH_MAP_COMPACT:
+        case HASH_MAP_CUCKOO:
+            return engine_rebuild(map);
+        case HASH_MAP_MAPPED:   // Read only, already as compact as saved
+        case HASH_MAP_FROZEN:   // Read only, one slot per pair
+        default:
+            return CLIB_OK;
     }
 }
@@ -0,0 +1,336 @@
+// ****************************************************************************************
+/**
+ * @file   HashMapBuild.c
+ * @brief  Bulk construction of a chained Hash Map from arrays of keys and values
+ *
+ * @details Table is sized once for every key, then keys are partitioned by the high bits
+ *          of their table entry, so every partition owns a contiguous range of entries
+ *          (and of occupancy bitmap words) and is built by its own thread without locks.
+ *          Nodes and long keys of every pair come from a single allocation, placed on
+ *          the map key arena, with nodes of a partition next to each other.
+ *
+ *          Build runs in three phases, each one on every thread:
+ *              1. Hash a range of keys, counting keys and key bytes per partition.
+ *              2. Scatter the key indexes of the range to their partition.
+ *              3. Link the nodes of a partition into its table entries.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+/// Table entries per partition at least, so partitions never share an occupancy word
+#define MIN_PARTITION_ENTRIES   (64)
+/// Length marking keys which can not be stored (4 GiB or longer)
+#define KEY_SKIPPED             (UINT32_MAX)
+
+/// State shared by every thread of a build
+typedef struct {
+    const char * const *keys;   //< Keys to insert
+    const size_t *key_lens;     //< Length of every key (NULL if keys are NUL terminated)
+    void **values;              //< Value of every key (NULL for NULL values)
+    size_t n;                   //< Number of keys
+    HashMap *map;               //< Map being built (chained engine)
+    uint64_t *hashes;           //< Full hash of every key
+    uint32_t *lens;             //< Length of every key, or KEY_SKIPPED
+    uint32_t *order;            //< Key indexes grouped by partition, input order inside each
+    size_t *counts;             //< Keys of [thread][partition], then their first #order position
+    size_t *bytes;              //< Long key bytes of [thread][partition]
+    size_t *part_start;         //< First #order position (and slab node) of every partition
+    size_t *part_blob;          //< First #blob byte of every partition
+    unsigned int *unique;       //< Keys inserted by every partition (duplicates excluded)
+    MapNode *nodes;             //< Slab of nodes
+    char *blob;                 //< Storage of keys not fitting inline on their node
+    unsigned int partitions;    //< Number of partitions and threads (power of two)
+    int shift;                  //< Table entry >> #shift is the partition of a key
+} BuildJob;
+
+/// Work of a single thread of #parallel_run
+typedef struct {
+    ParallelTask task;          //< Function to run
+    void *ctx;                  //< Its shared state
+    unsigned int id;            //< Thread number
+} ParallelWork;
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+static inline unsigned int build_partition_of(const BuildJob *job, uint64_t hash) {
+    return (unsigned int)((hash & (uint64_t)(job->map->size - 1)) >> job->shift);
+}
+
+/// First key index of the input range of thread #id
+static inline size_t build_range(const BuildJob *job, unsigned int id) {
+    return job->n / job->partitions * id + (job->n % job->partitions) * id / job->partitions;
+}
+
+/// Phase 1: hash keys of the range of #id and count them per partition
+static void build_hash(void *ctx, unsigned int id) {
+    BuildJob *job = ctx;
+    size_t *counts = &job->counts[(size_t)id * job->partitions];
+    size_t *bytes = &job->bytes[(size_t)id * job->partitions];
+    for (size_t i = build_range(job, id); i < build_range(job, id + 1); i++) {
+        size_t len = job->key_lens ? job->key_lens[i] : strlen(job->keys[i]);
+        if (len >= KEY_SKIPPED) {
+            job->lens[i] = KEY_SKIPPED;
+            continue;
+        }
+        job->lens[i] = (uint32_t)len;
+        job->hashes[i] = hash_bytes(job->keys[i], len, job->map->seed);
+        unsigned int part = build_partition_of(job, job->hashes[i]);
+        counts[part]++;
+        if (len >= MAP_NODE_INLINE_KEY)
+            bytes[part] += len + 1;
+    }
+}
+
+/// Phase 2: place key indexes of the range of #id on the #order positions of their partition
+static void build_scatter(void *ctx, unsigned int id) {
+    BuildJob *job = ctx;
+    size_t *next = &job->counts[(size_t)id * job->partitions];
+    for (size_t i = build_range(job, id); i < build_range(job, id + 1); i++) {
+        if (job->lens[i] != KEY_SKIPPED)
+            job->order[next[build_partition_of(job, job->hashes[i])]++] = (uint32_t)i;
+    }
+}
+
+/// Phase 3: link the keys of partition #id into the table entries it owns
+static void build_link(void *ctx, unsigned int id) {
+    BuildJob *job = ctx;
+    HashMap *map = job->map;
+    MapNode *node = &job->nodes[job->part_start[id]];
+    char *blob = job->blob + job->part_blob[id];
+    unsigned int unique = 0;
+
+    for (size_t k = job->part_start[id]; k < job->part_start[id + 1]; k++) {
+        size_t i = job->order[k];
+        uint64_t hash = job->hashes[i];
+        uint32_t len = job->lens[i];
+        void *value = job->values ? job->values[i] : NULL;
+        int pos = (int)(hash & (uint64_t)(map->size - 1));
+
+        // Keys of a partition keep input order, so a repeated key ends with its last value
+        MapNode *dup = map->list[pos];
+        while (dup && !(dup->hash == hash && dup->key_len == len && memcmp(dup->key, job->keys[i], len) == 0))
+            dup = dup->next;
+        if (dup) {
+            dup->value = value;
+            continue;
+        }
+
+        node->flags = MAP_NODE_SLAB;
+        if (len < MAP_NODE_INLINE_KEY) {
+            node->key = node->key_data;
+        } else {
+            node->key = blob;
+            blob += len + 1;
+        }
+        memcpy(node->key, job->keys[i], len);
+        node->key[len] = '\0';
+        node->key_len = len;
+        node->hash = hash;
+        node->value = value;
+        node->next = map->list[pos];
+        map->list[pos] = node;
+        map->occupied[pos >> 6] |= 1ull << (pos & 63);
+        node++;
+        unique++;
+    }
+    job->unique[id] = unique;
+}
+
+static void * parallel_worker(void *arg) {
+    ParallelWork *work = arg;
+    (*work->task)(work->ctx, work->id);
+    return NULL;
+}
+
+
+// ****************************************************************************************
+// build_layout
+// ****************************************************************************************
+/*  Private function to turn per thread counts of phase 1 into #order positions and slab
+ *  offsets of every partition
+ * @param[in]    job        Build state after phase 1
+ * @return       Bytes of long keys of every partition together
+ */
+// ****************************************************************************************
+static size_t build_layout(BuildJob *job) {
+    unsigned int parts = job->partitions;
+    size_t position = 0, blob = 0;
+    for (unsigned int p = 0; p < parts; p++) {
+        job->part_start[p] = position;
+        job->part_blob[p] = blob;
+        // Inside a partition, ranges of lower threads go first to keep input order
+        for (unsigned int t = 0; t < parts; t++) {
+            size_t count = job->counts[(size_t)t * parts + p];
+            job->counts[(size_t)t * parts + p] = position;
+            position += count;
+            blob += job->bytes[(size_t)t * parts + p];
+        }
+    }
+    job->part_start[parts] = position;
+    job->part_blob[parts] = blob;
+    return blob;
+}
+
+
+// ****************************************************************************************
+// build_fill
+// ****************************************************************************************
+/*  Private function to run every phase of #job, leaving every pair on its map
+ * @param[in]    job        Build state, with every array allocated
+ * @return       CLIB_OK    if the map is filled \n
+ *               CLIB_ERROR if nodes can not be allocated
+ */
+// ****************************************************************************************
+static int build_fill(BuildJob *job) {
+    parallel_run(job->partitions, build_hash, job);
+    size_t blob_bytes = build_layout(job);
+    parallel_run(job->partitions, build_scatter, job);
+
+    // Nodes and long keys of every pair on a single arena allocation, nodes first
+    size_t nodes = job->part_start[job->partitions];
+    char *storage = key_arena_alloc(job->map, nodes * sizeof(MapNode) + blob_bytes + sizeof(void *));
+    if (!storage)
+        return CLIB_ERROR;
+    // Arena gives bytes for keys, so the slab is aligned here
+    job->nodes = (MapNode *)(void *)(storage + (-(uintptr_t)storage & (sizeof(void *) - 1)));
+    job->blob = (char *)(job->nodes + nodes);
+
+    parallel_run(job->partitions, build_link, job);
+    for (unsigned int p = 0; p < job->partitions; p++)
+        job->map->count += job->unique[p];
+    return CLIB_OK;
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// parallel_run
+// ****************************************************************************************
+/**
+ *  Run #task on #threads threads, each one with its own id, and wait for all of them
+ * @param[in]    threads    Number of threads (at most #HASH_MAP_MAX_THREADS)
+ * @param[in]    task       Function to run
+ * @param[in]    ctx        State shared by every thread
+ *
+ * @details      Id 0 runs on the calling thread. Ids whose thread can not be created also
+ *               run there, after the others are started.
+ */
+// ****************************************************************************************
+void parallel_run(unsigned int threads, ParallelTask task, void *ctx) {
+    pthread_t handles[HASH_MAP_MAX_THREADS];
+    bool started[HASH_MAP_MAX_THREADS] = { false };
+    ParallelWork work[HASH_MAP_MAX_THREADS];
+
+    for (unsigned int id = 1; id < threads; id++) {
+        work[id] = (ParallelWork){ task, ctx, id };
+        started[id] = pthread_create(&handles[id], NULL, parallel_worker, &work[id]) == 0;
+    }
+    (*task)(ctx, 0);
+    for (unsigned int id = 1; id < threads; id++) {
+        if (started[id])
+            pthread_join(handles[id], NULL);
+        else
+            (*task)(ctx, id);
+    }
+}
+
+
+// ****************************************************************************************
+// hash_map_build_len
+// ****************************************************************************************
+/**
+ *  Create a Hash Map holding #n key-value pairs, built on #nthreads threads
+ * @param[in]    keys       Keys of pairs key-value
+ * @param[in]    lens       Length of every key in bytes (NULL if keys are NUL terminated)
+ * @param[in]    values     Value of every key (NULL to set every value to NULL)
+ * @param[in]    n          Number of pairs
+ * @param[in]    nthreads   Number of threads building the map
+ * @return       Pointer to a Hash Map with #HASH_MAP_CHAINED engine, NULL if it can not be
+ *               allocated
+ */
+// ****************************************************************************************
+HashMap * hash_map_build_len(const char * const *keys, const size_t *lens, void **values,
+                             size_t n, int nthreads) {
+    if (n > UINT32_MAX)
+        return NULL;
+    HashMap *map = create_hash_map((int)(n < (1u << 30) ? n : (1u << 30)));
+    if (!map)
+        return NULL;
+
+    BuildJob job = { .keys = keys, .key_lens = lens, .values = values, .n = n, .map = map,
+                     .partitions = 1 };
+    // Partitions split the table entries on equal power of two ranges
+    int entries_bits = __builtin_ctz((unsigned int)map->size);
+    while ((int)job.partitions * 2 <= nthreads && job.partitions * 2 <= HASH_MAP_MAX_THREADS &&
+           (size_t)map->size / (job.partitions * 2) >= MIN_PARTITION_ENTRIES)
+        job.partitions *= 2;
+    job.shift = entries_bits - __builtin_ctz(job.partitions);
+
+    size_t cells = (size_t)job.partitions * job.partitions;
+    job.hashes = malloc(n * sizeof(uint64_t) + 1);
+    job.lens = malloc(n * sizeof(uint32_t) + 1);
+    job.order = malloc(n * sizeof(uint32_t) + 1);
+    job.counts = calloc(cells, sizeof(size_t));
+    job.bytes = calloc(cells, sizeof(size_t));
+    job.part_start = malloc((job.partitions + 1) * sizeof(size_t));
+    job.part_blob = malloc((job.partitions + 1) * sizeof(size_t));
+    job.unique = malloc(job.partitions * sizeof(unsigned int));
+    if (!job.hashes || !job.lens || !job.order || !job.counts || !job.bytes ||
+        !job.part_start || !job.part_blob || !job.unique || !map->list || !map->occupied ||
+        build_fill(&job) != CLIB_OK) {
+        hash_map_destroy(map, NULL);
+        map = NULL;
+    }
+
+    free(job.hashes);
+    free(job.lens);
+    free(job.order);
+    free(job.counts);
+    free(job.bytes);
+    free(job.part_start);
+    free(job.part_blob);
+    free(job.unique);
+    return map;
+}
+
+
+// ****************************************************************************************
+// hash_map_build
+// ****************************************************************************************
+/**
+ *  Create a Hash Map holding #n key-value pairs, built on #nthreads threads
+ * @param[in]    keys       Keys of pairs key-value (NUL terminated)
+ * @param[in]    values     Value of every key (NULL to set every value to NULL)
+ * @param[in]    n          Number of pairs
+ * @param[in]    nthreads   Number of threads building the map (1 to build it on the caller)
+ * @return       Pointer to a Hash Map with #HASH_MAP_CHAINED engine, NULL if it can not be
+ *               allocated
+ */
+// ****************************************************************************************
+HashMap * hash_map_build(const char * const *keys, void **values, size_t n, int nthreads) {
+    return hash_map_build_len(keys, NULL, values, n, nthreads);
+}
@@ -0,0 +1,347 @@
+// ****************************************************************************************
+/**
+ * @file   HashMapCompact.c
+ * @brief  Insertion ordered "compact dict" engine of Hash Map
+ *
+ * @details Pairs live on a dense array of entries, appended in insertion order. Hashing
+ *          is done on a separate index table of 32 bit entry numbers, probed linearly.
+ *          Removed entries stay as holes on the entry array (so order is kept) until the
+ *          array fills up and is compacted.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define INDEX_EMPTY             (UINT32_MAX)
+#define MIN_SIZE                (8)
+#define MAX_SIZE                ((size_t)1 << 30)
+
+/// Compact table entry
+typedef struct {
+    uint64_t hash;              //< Full hash of key
+    char *key;                  //< Key of key-value pair, NULL on removed entries
+    void *value;                //< Value of key-value pair
+    uint32_t key_len;           //< Length of key
+} CompactEntry;
+
+/// Compact table state, stored on HashMap engine_data
+typedef struct {
+    uint32_t *index;            //< Entry number of every index slot, or INDEX_EMPTY
+    CompactEntry *entries;      //< Entries in insertion order
+    size_t size;                //< Number of index slots (power of two)
+    size_t capacity;            //< Number of entries allocated (2/3 of #size)
+    size_t used;                //< Number of entries appended, removed ones included
+} CompactTable;
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+/// Number of entries of an index of #size slots, which keeps its load under 2/3
+static inline size_t compact_capacity(size_t size) {
+    return size - size / 3;
+}
+
+/// Smallest index size able to hold #count entries
+static size_t compact_size_for(size_t count) {
+    size_t size = MIN_SIZE;
+    while (compact_capacity(size) < count && size < MAX_SIZE)
+        size <<= 1;
+    return size;
+}
+
+
+// ****************************************************************************************
+// compact_find
+// ****************************************************************************************
+/*  Private function to find the index slot of #key
+ * @param[in]    map        Hash Map whose compact table is searched
+ * @param[in]    hash       Full hash of #key
+ * @param[in]    key        Key to find
+ * @param[in]    len        Length of #key
+ * @return       Index slot holding the entry of #key, or the INDEX_EMPTY slot ending its
+ *               probe sequence if #key does not exist
+ */
+// ****************************************************************************************
+static size_t compact_find(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    CompactTable *table = map->engine_data;
+    size_t mask = table->size - 1;
+    for (size_t pos = (size_t)hash & mask;; pos = (pos + 1) & mask) {
+        uint32_t number = table->index[pos];
+        HASH_MAP_COUNT(map, probes);
+        if (number == INDEX_EMPTY)
+            return pos;
+        CompactEntry *entry = &table->entries[number];
+        if (entry->hash == hash && entry->key_len == len) {
+            HASH_MAP_COUNT(map, compares);
+            if (memcmp(entry->key, key, len) == 0)
+                return pos;
+        }
+    }
+}
+
+
+// ****************************************************************************************
+// compact_rebuild
+// ****************************************************************************************
+/*  Private function to drop removed entries and rebuild the index with #size slots
+ * @param[in]    map        Hash Map owning #table, its key arena is rebuilt too
+ * @param[in]    table      Table to rebuild
+ * @param[in]    size       New number of index slots (must hold every live entry)
+ * @return       CLIB_OK    if new table is allocated \n
+ *               CLIB_ERROR in other case (#table and key arena are left unchanged)
+ */
+// ****************************************************************************************
+static int compact_rebuild(HashMap *map, CompactTable *table, size_t size) {
+    size_t capacity = compact_capacity(size);
+    uint32_t *index = malloc(size * sizeof(uint32_t));
+    CompactEntry *entries = malloc(capacity * sizeof(CompactEntry));
+    if (!index || !entries) {
+        free(index);
+        free(entries);
+        return CLIB_ERROR;
+    }
+
+    // Live keys are copied to a fresh arena, packed on entry order like the entries
+    struct key_arena *old_arena = map->key_arena;
+    map->key_arena = NULL;
+    // Live entries keep their order, only holes are squeezed out
+    size_t used = 0, mask = size - 1;
+    memset(index, 0xFF, size * sizeof(uint32_t));
+    for (size_t i = 0; i < table->used; i++) {
+        if (!table->entries[i].key)
+            continue;
+        CompactEntry *entry = &entries[used];
+        *entry = table->entries[i];
+        entry->key = key_arena_alloc(map, entry->key_len + 1);
+        if (!entry->key) {
+            key_arena_destroy(map);
+            map->key_arena = old_arena;
+            free(index);
+            free(entries);
+            return CLIB_ERROR;
+        }
+        memcpy(entry->key, table->entries[i].key, entry->key_len + 1);
+        size_t pos = (size_t)entry->hash & mask;
+        while (index[pos] != INDEX_EMPTY)
+            pos = (pos + 1) & mask;
+        index[pos] = (uint32_t)used++;
+    }
+
+    struct key_arena *new_arena = map->key_arena;
+    map->key_arena = old_arena;
+    key_arena_destroy(map);
+    map->key_arena = new_arena;
+    free(table->index);
+    free(table->entries);
+    table->index = index;
+    table->entries = entries;
+    table->size = size;
+    table->capacity = capacity;
+    table->used = used;
+    return CLIB_OK;
+}
+
+
+/******************************************************************************/
+/************************** Engine Operations Implementations *****************/
+/******************************************************************************/
+
+static void * compact_get(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    CompactTable *table = map->engine_data;
+    uint32_t number = table->index[compact_find(map, hash, key, len)];
+    return number != INDEX_EMPTY ? table->entries[number].value : NULL;
+}
+
+static void ** compact_insert(HashMap *map, uint64_t hash, const char *key, size_t len, bool *inserted) {
+    CompactTable *table = map->engine_data;
+    size_t pos = compact_find(map, hash, key, len);
+    if (table->index[pos] != INDEX_EMPTY) {
+        *inserted = false;
+        return &table->entries[table->index[pos]].value;
+    }
+
+    if (table->used == table->capacity) {
+        // Room for twice the live entries: doubles a table without holes, only
+        // compacts one where removed entries are half of the array
+        if (compact_rebuild(map, table, compact_size_for(map->count * 2 + 1)) != CLIB_OK ||
+            table->used == table->capacity)
+            return NULL;
+        map->size = (int)table->size;
+        pos = compact_find(map, hash, key, len);
+    }
+
+    char *entry_key = key_arena_alloc(map, len + 1);
+    if (!entry_key)
+        return NULL;
+    CompactEntry *entry = &table->entries[table->used];
+    entry->hash = hash;
+    entry->key = entry_key;
+    memcpy(entry->key, key, len);
+    entry->key[len] = '\0';
+    entry->key_len = (uint32_t)len;
+    entry->value = NULL;
+    table->index[pos] = (uint32_t)table->used++;
+    map->count++;
+
+    *inserted = true;
+    return &entry->value;
+}
+
+static bool compact_erase(HashMap *map, uint64_t hash, const char *key, size_t len, void **value) {
+    CompactTable *table = map->engine_data;
+    size_t pos = compact_find(map, hash, key, len);
+    uint32_t number = table->index[pos];
+    if (number == INDEX_EMPTY)
+        return false;
+
+    *value = table->entries[number].value;
+    key_arena_free(map, table->entries[number].key, table->entries[number].key_len + 1);
+    table->entries[number].key = NULL;
+    map->count--;
+    // Holes at the end of the array are reused right away
+    while (table->used > 0 && !table->entries[table->used - 1].key)
+        table->used--;
+
+    // Move back every following slot whose home slot is not between the hole and itself
+    size_t mask = table->size - 1, hole = pos;
+    for (;;) {
+        pos = (pos + 1) & mask;
+        if (table->index[pos] == INDEX_EMPTY)
+            break;
+        size_t home = (size_t)table->entries[table->index[pos]].hash & mask;
+        if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+            table->index[hole] = table->index[pos];
+            hole = pos;
+        }
+    }
+    table->index[hole] = INDEX_EMPTY;
+    return true;
+}
+
+static int compact_reserve(HashMap *map, unsigned int count) {
+    CompactTable *table = map->engine_data;
+    if (count <= table->capacity)
+        return CLIB_OK;
+    if (compact_rebuild(map, table, compact_size_for(count)) != CLIB_OK)
+        return CLIB_ERROR;
+    map->size = (int)table->size;
+    return CLIB_OK;
+}
+
+static void compact_foreach(HashMap *map, EntryVisitor visit, void *ctx) {
+    CompactTable *table = map->engine_data;
+    for (size_t i = 0; i < table->used; i++) {
+        CompactEntry *entry = &table->entries[i];
+        if (entry->key)
+            (*visit)(entry->key, entry->key_len, entry->value, ctx);
+    }
+}
+
+static bool compact_iter_next(HashMap *map, HashMapIter *it) {
+    CompactTable *table = map->engine_data;
+    while (it->position < table->used) {
+        CompactEntry *entry = &table->entries[it->position++];
+        if (entry->key) {
+            it->key = entry->key;
+            it->key_len = entry->key_len;
+            it->value = entry->value;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void compact_prefetch(HashMap *map, uint64_t hash, int stage) {
+    CompactTable *table = map->engine_data;
+    uint32_t *slot = &table->index[(size_t)hash & (table->size - 1)];
+    if (stage == 0) {
+        HASH_MAP_PREFETCH(slot);
+        return;
+    }
+    // Later stages follow the home slot, the usual place of a key on a 2/3 loaded index
+    if (*slot == INDEX_EMPTY)
+        return;
+    if (stage == 1)
+        HASH_MAP_PREFETCH(&table->entries[*slot]);
+    else
+        HASH_MAP_PREFETCH(table->entries[*slot].key);
+}
+
+static void compact_stats(HashMap *map, HashMapStats *stats) {
+    CompactTable *table = map->engine_data;
+    size_t mask = table->size - 1;
+    for (size_t pos = 0; pos < table->size; pos++) {
+        if (table->index[pos] == INDEX_EMPTY)
+            continue;
+        size_t home = (size_t)table->entries[table->index[pos]].hash & mask;
+        unsigned int distance = (unsigned int)((pos - home) & mask);
+        stats->chain_histogram[distance < HASH_MAP_STATS_HISTOGRAM ? distance : HASH_MAP_STATS_HISTOGRAM - 1]++;
+        if (distance + 1 > stats->max_chain)
+            stats->max_chain = distance + 1;
+    }
+}
+
+static void compact_destroy(HashMap *map) {
+    CompactTable *table = map->engine_data;
+    free(table->index);
+    free(table->entries);
+    FREE_TO_NULL(map->engine_data);
+}
+
+const HashMapOps COMPACT_MAP_OPS = {
+    .get = compact_get,
+    .insert = compact_insert,
+    .erase = compact_erase,
+    .reserve = compact_reserve,
+    .foreach = compact_foreach,
+    .iter_next = compact_iter_next,
+    .prefetch = compact_prefetch,
+    .stats = compact_stats,
+    .destroy = compact_destroy,
+};
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// compact_map_init
+// ****************************************************************************************
+/**
+ *  Initialice compact engine state of #map for at least #size pairs
+ * @param[in]    map   Hash Map whose engine is #HASH_MAP_COMPACT
+ * @param[in]    size  Initial number of pairs
+ * @return       CLIB_OK    if engine is initialiced \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+int compact_map_init(HashMap *map, int size) {
+    CompactTable *table = calloc(1, sizeof(CompactTable));
+    if (!table || compact_rebuild(map, table, compact_size_for(size > 0 ? (size_t)size : 1)) != CLIB_OK) {
+        free(table);
+        return CLIB_ERROR;
+    }
+    map->engine_data = table;
+    map->size = (int)table->size;
+    return CLIB_OK;
+}
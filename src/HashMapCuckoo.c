@@ -0,0 +1,545 @@
+// ****************************************************************************************
+/**
+ * @file   HashMapCuckoo.c
+ * @brief  Bucketized cuckoo hashing engine of Hash Map
+ *
+ * @details Every key has two candidate buckets, and every bucket is one cache line with
+ *          4 slots. A slot holds a 32 bit fingerprint of the key hash and a pointer to
+ *          the key record (key, full hash and value). A key is always on one of its two
+ *          buckets or on a small stash, so a lookup reads at most two bucket lines and
+ *          the record of each fingerprint match, whatever the load or key distribution.
+ *          When both buckets are full, insertion searches (breadth first) the shortest
+ *          chain of keys that can move to their other bucket to free a slot.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+#include <stddef.h>
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define CACHE_LINE              (64)
+#define BUCKET_SLOTS            (4)
+#define MIN_BUCKETS             (2)
+#define MAX_BUCKETS             ((size_t)1 << 28)
+/// Keys placed on the stash when no displacement path is found, before the table grows
+#define STASH_SIZE              (4)
+/// Max number of buckets visited by the breadth first search of a displacement path
+#define BFS_MAX_NODES           (256)
+/// Max used slots per 100 slots before the table doubles
+#define MAX_LOAD_PERCENT        (90)
+
+/// Key record, allocated on the map key arena. Value lives here so its slot never moves
+typedef struct {
+    void *value;                //< Value of key-value pair
+    uint64_t hash;              //< Full hash of key
+    uint32_t key_len;           //< Length of key
+    char key[];                 //< Key, NUL terminated
+} CuckooRecord;
+
+/// Bucket of a cuckoo table, exactly one cache line
+typedef struct {
+    uint32_t fingerprints[BUCKET_SLOTS];    //< Fingerprint of every slot, 0 if empty
+    CuckooRecord *records[BUCKET_SLOTS];    //< Record of every slot
+} __attribute__((aligned(CACHE_LINE))) CuckooBucket;
+
+/// Cuckoo table state, stored on HashMap engine_data
+typedef struct {
+    CuckooBucket *buckets;      //< Table of buckets
+    size_t mask;                //< Number of buckets - 1 (power of two)
+    CuckooRecord *stash[STASH_SIZE];    //< Keys which did not fit on their buckets
+    int stash_count;            //< Number of keys on #stash
+} CuckooTable;
+
+/// Node of the displacement path search
+typedef struct {
+    size_t bucket;              //< Bucket visited
+    int parent;                 //< Node whose key moves into #bucket, -1 for start buckets
+    int slot;                   //< Slot of that key on the parent bucket
+} CuckooPathNode;
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+/// Fingerprint of a hash, never 0 (which marks empty slots)
+static inline uint32_t cuckoo_fingerprint(uint64_t hash) {
+    uint32_t fingerprint = (uint32_t)(hash >> 32);
+    return fingerprint ? fingerprint : 1;
+}
+
+/// Other bucket of a key with #fingerprint placed on #bucket. Applying it twice gives
+/// #bucket back, so moving keys only needs their fingerprint, not their record
+static inline size_t cuckoo_alternate(const CuckooTable *table, size_t bucket, uint32_t fingerprint) {
+    return (bucket ^ ((size_t)(fingerprint * 0x5BD1E995u) | 1)) & table->mask;
+}
+
+static inline int cuckoo_empty_slot(const CuckooBucket *bucket) {
+    for (int i = 0; i < BUCKET_SLOTS; i++) {
+        if (!bucket->fingerprints[i])
+            return i;
+    }
+    return -1;
+}
+
+static inline bool cuckoo_match(const CuckooRecord *record, uint64_t hash, const char *key, size_t len) {
+    return record->hash == hash && record->key_len == len && memcmp(record->key, key, len) == 0;
+}
+
+
+// ****************************************************************************************
+// cuckoo_alloc
+// ****************************************************************************************
+/*  Private function to allocate empty buckets for #count buckets
+ * @param[in]    table      Table to initialice
+ * @param[in]    count      Number of buckets (power of two)
+ */
+// ****************************************************************************************
+static int cuckoo_alloc(CuckooTable *table, size_t count) {
+    table->buckets = aligned_alloc(CACHE_LINE, count * sizeof(CuckooBucket));
+    if (!table->buckets)
+        return CLIB_ERROR;
+    memset(table->buckets, 0, count * sizeof(CuckooBucket));
+    table->mask = count - 1;
+    table->stash_count = 0;
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// cuckoo_find
+// ****************************************************************************************
+/*  Private function to find the slot of #key
+ * @param[in]    map        Hash Map whose cuckoo table is searched
+ * @param[in]    hash       Full hash of #key
+ * @param[in]    key        Key to find
+ * @param[in]    len        Length of #key
+ * @param[out]   bucket     Bucket of #key, or SIZE_MAX if it is on the stash
+ * @param[out]   slot       Slot of #key on #bucket, or position on the stash
+ * @return       true if #key exists
+ */
+// ****************************************************************************************
+static bool cuckoo_find(HashMap *map, uint64_t hash, const char *key, size_t len,
+                        size_t *bucket, int *slot) {
+    CuckooTable *table = map->engine_data;
+    uint32_t fingerprint = cuckoo_fingerprint(hash);
+    size_t candidates[2];
+    candidates[0] = (size_t)hash & table->mask;
+    candidates[1] = cuckoo_alternate(table, candidates[0], fingerprint);
+
+    for (int c = 0; c < 2; c++) {
+        CuckooBucket *current = &table->buckets[candidates[c]];
+        HASH_MAP_COUNT(map, probes);
+        for (int i = 0; i < BUCKET_SLOTS; i++) {
+            if (current->fingerprints[i] != fingerprint)
+                continue;
+            HASH_MAP_COUNT(map, compares);
+            if (cuckoo_match(current->records[i], hash, key, len)) {
+                *bucket = candidates[c];
+                *slot = i;
+                return true;
+            }
+        }
+    }
+    for (int i = 0; i < table->stash_count; i++) {
+        HASH_MAP_COUNT(map, compares);
+        if (cuckoo_match(table->stash[i], hash, key, len)) {
+            *bucket = SIZE_MAX;
+            *slot = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+// ****************************************************************************************
+// cuckoo_displace
+// ****************************************************************************************
+/*  Private function to free a slot on #first or #second moving keys to their other bucket
+ * @param[in]    table      Table to modify
+ * @param[in]    first      First candidate bucket of the key being inserted
+ * @param[in]    second     Second candidate bucket of the key being inserted
+ * @param[out]   slot       Free slot on the returned bucket
+ * @return       #first or #second with a free #slot, or SIZE_MAX if no path was found
+ *
+ * @details      Buckets are searched breadth first, so the path found moves as few keys
+ *               as possible. Keys are moved from the end of the path, so every key is
+ *               always on one of its buckets even if the path stops being valid.
+ */
+// ****************************************************************************************
+static size_t cuckoo_displace(CuckooTable *table, size_t first, size_t second, int *slot) {
+    CuckooPathNode nodes[BFS_MAX_NODES];
+    unsigned int head = 0, tail = 0;
+    int found = -1;
+    nodes[tail++] = (CuckooPathNode){ first, -1, -1 };
+    nodes[tail++] = (CuckooPathNode){ second, -1, -1 };
+
+    while (head < tail) {
+        CuckooBucket *bucket = &table->buckets[nodes[head].bucket];
+        if (cuckoo_empty_slot(bucket) >= 0) {
+            found = (int)head;
+            break;
+        }
+        for (int i = 0; i < BUCKET_SLOTS && tail < BFS_MAX_NODES; i++) {
+            size_t next = cuckoo_alternate(table, nodes[head].bucket, bucket->fingerprints[i]);
+            nodes[tail++] = (CuckooPathNode){ next, (int)head, i };
+        }
+        head++;
+    }
+    if (found < 0)
+        return SIZE_MAX;
+
+    // Walk back to the start bucket, moving every key one step into the free slot after it
+    int node = found;
+    while (nodes[node].parent >= 0) {
+        CuckooBucket *to = &table->buckets[nodes[node].bucket];
+        CuckooBucket *from = &table->buckets[nodes[nodes[node].parent].bucket];
+        int free_slot = cuckoo_empty_slot(to), moved = nodes[node].slot;
+        if (free_slot < 0 || !from->fingerprints[moved] ||
+            cuckoo_alternate(table, nodes[nodes[node].parent].bucket, from->fingerprints[moved]) != nodes[node].bucket)
+            return SIZE_MAX;
+        to->fingerprints[free_slot] = from->fingerprints[moved];
+        to->records[free_slot] = from->records[moved];
+        from->fingerprints[moved] = 0;
+        from->records[moved] = NULL;
+        node = nodes[node].parent;
+    }
+    *slot = cuckoo_empty_slot(&table->buckets[nodes[node].bucket]);
+    return *slot >= 0 ? nodes[node].bucket : SIZE_MAX;
+}
+
+
+/// Record pointer of #slot on #bucket, or of stash position #slot if #bucket is SIZE_MAX
+static inline CuckooRecord ** cuckoo_record_slot(CuckooTable *table, size_t bucket, int slot) {
+    return bucket == SIZE_MAX ? &table->stash[slot] : &table->buckets[bucket].records[slot];
+}
+
+/// Bytes of the record of a key of #len bytes, multiple of 8 so records stay aligned
+static inline size_t cuckoo_record_size(size_t len) {
+    return (offsetof(CuckooRecord, key) + len + 1 + 7) & ~(size_t)7;
+}
+
+
+// ****************************************************************************************
+// cuckoo_claim
+// ****************************************************************************************
+/*  Private function to take a free slot for a key with #hash on one of its buckets,
+ *  displacing keys if needed
+ * @param[in]    table      Table to modify (the key must not be on it)
+ * @param[in]    hash       Full hash of the key
+ * @param[out]   bucket     Bucket of the slot taken, or SIZE_MAX if it is on the stash
+ * @param[out]   slot       Slot taken on #bucket, or position on the stash
+ * @return       true if a slot is taken, with its fingerprint set and a NULL record,
+ *               false if the table must grow
+ */
+// ****************************************************************************************
+static bool cuckoo_claim(CuckooTable *table, uint64_t hash, size_t *bucket, int *slot) {
+    uint32_t fingerprint = cuckoo_fingerprint(hash);
+    size_t first = (size_t)hash & table->mask;
+    size_t second = cuckoo_alternate(table, first, fingerprint);
+    *bucket = first;
+    *slot = cuckoo_empty_slot(&table->buckets[first]);
+    if (*slot < 0) {
+        *bucket = second;
+        *slot = cuckoo_empty_slot(&table->buckets[second]);
+    }
+    if (*slot < 0)
+        *bucket = cuckoo_displace(table, first, second, slot);
+    if (*bucket == SIZE_MAX) {
+        if (table->stash_count == STASH_SIZE)
+            return false;
+        *slot = table->stash_count;
+        table->stash[table->stash_count++] = NULL;
+        return true;
+    }
+    table->buckets[*bucket].fingerprints[*slot] = fingerprint;
+    table->buckets[*bucket].records[*slot] = NULL;
+    return true;
+}
+
+/// Place #record, not on #table yet, on one of its buckets. False if the table must grow
+static bool cuckoo_place(CuckooTable *table, CuckooRecord *record) {
+    size_t bucket;
+    int slot;
+    if (!cuckoo_claim(table, record->hash, &bucket, &slot))
+        return false;
+    *cuckoo_record_slot(table, bucket, slot) = record;
+    return true;
+}
+
+
+// ****************************************************************************************
+// cuckoo_resize
+// ****************************************************************************************
+/*  Private function to move every record of #table into a new table of #count buckets
+ * @param[in]    table      Table to resize
+ * @param[in]    count      New number of buckets (doubled again if records do not fit)
+ * @return       CLIB_OK    if new table is allocated \n
+ *               CLIB_ERROR in other case (#table is left unchanged)
+ */
+// ****************************************************************************************
+static int cuckoo_resize(CuckooTable *table, size_t count) {
+    CuckooTable old = *table;
+    for (; count <= MAX_BUCKETS; count <<= 1) {
+        if (cuckoo_alloc(table, count) != CLIB_OK)
+            break;
+        bool placed = true;
+        for (size_t b = 0; b <= old.mask && placed; b++) {
+            for (int i = 0; i < BUCKET_SLOTS && placed; i++) {
+                if (old.buckets[b].fingerprints[i])
+                    placed = cuckoo_place(table, old.buckets[b].records[i]);
+            }
+        }
+        for (int i = 0; i < old.stash_count && placed; i++)
+            placed = cuckoo_place(table, old.stash[i]);
+        if (placed) {
+            free(old.buckets);
+            return CLIB_OK;
+        }
+        free(table->buckets);
+    }
+    *table = old;
+    return CLIB_ERROR;
+}
+
+/// Smallest number of buckets holding #count pairs under the max load
+static size_t cuckoo_buckets_for(size_t count) {
+    size_t buckets = MIN_BUCKETS;
+    while (buckets * BUCKET_SLOTS * MAX_LOAD_PERCENT < count * 100 && buckets < MAX_BUCKETS)
+        buckets <<= 1;
+    return buckets;
+}
+
+
+/******************************************************************************/
+/************************** Engine Operations Implementations *****************/
+/******************************************************************************/
+
+static void * cuckoo_get(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    CuckooTable *table = map->engine_data;
+    size_t bucket;
+    int slot;
+    if (!cuckoo_find(map, hash, key, len, &bucket, &slot))
+        return NULL;
+    return bucket == SIZE_MAX ? table->stash[slot]->value : table->buckets[bucket].records[slot]->value;
+}
+
+static void ** cuckoo_insert(HashMap *map, uint64_t hash, const char *key, size_t len, bool *inserted) {
+    CuckooTable *table = map->engine_data;
+    size_t bucket;
+    int slot;
+    if (cuckoo_find(map, hash, key, len, &bucket, &slot)) {
+        *inserted = false;
+        return bucket == SIZE_MAX ? &table->stash[slot]->value : &table->buckets[bucket].records[slot]->value;
+    }
+
+    size_t slots = (table->mask + 1) * BUCKET_SLOTS;
+    if (((size_t)map->count + 1) * 100 > slots * MAX_LOAD_PERCENT &&
+        cuckoo_resize(table, (table->mask + 1) * 2) != CLIB_OK)
+        return NULL;
+
+    // Slot is taken before the record is allocated, so no failure leaves a record behind
+    while (!cuckoo_claim(table, hash, &bucket, &slot)) {
+        if (cuckoo_resize(table, (table->mask + 1) * 2) != CLIB_OK)
+            return NULL;
+    }
+    map->size = (int)((table->mask + 1) * BUCKET_SLOTS);
+    CuckooRecord *record = (CuckooRecord *)(void *)key_arena_alloc(map, cuckoo_record_size(len));
+    if (!record) {
+        // Taken stash position is the last one
+        if (bucket == SIZE_MAX)
+            table->stash_count--;
+        else
+            table->buckets[bucket].fingerprints[slot] = 0;
+        return NULL;
+    }
+    record->value = NULL;
+    record->hash = hash;
+    record->key_len = (uint32_t)len;
+    memcpy(record->key, key, len);
+    record->key[len] = '\0';
+    *cuckoo_record_slot(table, bucket, slot) = record;
+    map->count++;
+
+    *inserted = true;
+    return &record->value;
+}
+
+static bool cuckoo_erase(HashMap *map, uint64_t hash, const char *key, size_t len, void **value) {
+    CuckooTable *table = map->engine_data;
+    size_t bucket;
+    int slot;
+    if (!cuckoo_find(map, hash, key, len, &bucket, &slot))
+        return false;
+
+    CuckooRecord *erased = *cuckoo_record_slot(table, bucket, slot);
+    *value = erased->value;
+    // Record space goes back to the arena for the next keys of a similar length
+    key_arena_free(map, (char *)erased, cuckoo_record_size(erased->key_len));
+    if (bucket == SIZE_MAX) {
+        table->stash[slot] = table->stash[--table->stash_count];
+    } else {
+        table->buckets[bucket].fingerprints[slot] = 0;
+        table->buckets[bucket].records[slot] = NULL;
+        // A free slot may let a stashed key go back to its buckets
+        for (int i = 0; i < table->stash_count; i++) {
+            CuckooRecord *record = table->stash[i];
+            size_t first = (size_t)record->hash & table->mask;
+            uint32_t fingerprint = cuckoo_fingerprint(record->hash);
+            if (bucket == first || bucket == cuckoo_alternate(table, first, fingerprint)) {
+                table->buckets[bucket].fingerprints[slot] = fingerprint;
+                table->buckets[bucket].records[slot] = record;
+                table->stash[i] = table->stash[--table->stash_count];
+                break;
+            }
+        }
+    }
+    map->count--;
+    return true;
+}
+
+static int cuckoo_reserve(HashMap *map, unsigned int count) {
+    CuckooTable *table = map->engine_data;
+    size_t buckets = cuckoo_buckets_for(count);
+    if (buckets <= table->mask + 1)
+        return CLIB_OK;
+    if (cuckoo_resize(table, buckets) != CLIB_OK)
+        return CLIB_ERROR;
+    map->size = (int)((table->mask + 1) * BUCKET_SLOTS);
+    return CLIB_OK;
+}
+
+static void cuckoo_foreach(HashMap *map, EntryVisitor visit, void *ctx) {
+    CuckooTable *table = map->engine_data;
+    for (size_t b = 0; b <= table->mask; b++) {
+        for (int i = 0; i < BUCKET_SLOTS; i++) {
+            CuckooRecord *record = table->buckets[b].records[i];
+            if (table->buckets[b].fingerprints[i])
+                (*visit)(record->key, record->key_len, record->value, ctx);
+        }
+    }
+    for (int i = 0; i < table->stash_count; i++)
+        (*visit)(table->stash[i]->key, table->stash[i]->key_len, table->stash[i]->value, ctx);
+}
+
+static bool cuckoo_iter_next(HashMap *map, HashMapIter *it) {
+    CuckooTable *table = map->engine_data;
+    size_t slots = (table->mask + 1) * BUCKET_SLOTS;
+    CuckooRecord *record = NULL;
+    // Positions are slots of the table, followed by the stash
+    while (!record && it->position < slots + (size_t)table->stash_count) {
+        size_t pos = it->position++;
+        if (pos >= slots)
+            record = table->stash[pos - slots];
+        else if (table->buckets[pos / BUCKET_SLOTS].fingerprints[pos % BUCKET_SLOTS])
+            record = table->buckets[pos / BUCKET_SLOTS].records[pos % BUCKET_SLOTS];
+    }
+    if (!record)
+        return false;
+    it->key = record->key;
+    it->key_len = record->key_len;
+    it->value = record->value;
+    return true;
+}
+
+static void cuckoo_prefetch(HashMap *map, uint64_t hash, int stage) {
+    CuckooTable *table = map->engine_data;
+    uint32_t fingerprint = cuckoo_fingerprint(hash);
+    size_t first = (size_t)hash & table->mask;
+    CuckooBucket *buckets[2] = { &table->buckets[first],
+                                 &table->buckets[cuckoo_alternate(table, first, fingerprint)] };
+    // Records hold keys inline, so there is nothing left to load on the last stage
+    if (stage > 1)
+        return;
+    for (int c = 0; c < 2; c++) {
+        if (stage == 0) {
+            HASH_MAP_PREFETCH(buckets[c]);
+            continue;
+        }
+        for (int i = 0; i < BUCKET_SLOTS; i++) {
+            if (buckets[c]->fingerprints[i] == fingerprint)
+                HASH_MAP_PREFETCH(buckets[c]->records[i]);
+        }
+    }
+}
+
+static void cuckoo_stats(HashMap *map, HashMapStats *stats) {
+    CuckooTable *table = map->engine_data;
+    for (size_t b = 0; b <= table->mask; b++) {
+        for (int i = 0; i < BUCKET_SLOTS; i++) {
+            if (!table->buckets[b].fingerprints[i])
+                continue;
+            unsigned int distance = ((size_t)table->buckets[b].records[i]->hash & table->mask) == b ? 0 : 1;
+            stats->chain_histogram[distance]++;
+            if (distance + 1 > stats->max_chain)
+                stats->max_chain = distance + 1;
+        }
+    }
+    if (table->stash_count) {
+        stats->chain_histogram[2] += (unsigned int)table->stash_count;
+        stats->max_chain = 3;
+    }
+}
+
+static void cuckoo_destroy(HashMap *map) {
+    CuckooTable *table = map->engine_data;
+    free(table->buckets);
+    FREE_TO_NULL(map->engine_data);
+}
+
+const HashMapOps CUCKOO_MAP_OPS = {
+    .get = cuckoo_get,
+    .insert = cuckoo_insert,
+    .erase = cuckoo_erase,
+    .reserve = cuckoo_reserve,
+    .foreach = cuckoo_foreach,
+    .iter_next = cuckoo_iter_next,
+    .prefetch = cuckoo_prefetch,
+    .stats = cuckoo_stats,
+    .destroy = cuckoo_destroy,
+};
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// cuckoo_map_init
+// ****************************************************************************************
+/**
+ *  Initialice cuckoo engine state of #map for at least #size pairs
+ * @param[in]    map   Hash Map whose engine is #HASH_MAP_CUCKOO
+ * @param[in]    size  Initial number of pairs
+ * @return       CLIB_OK    if engine is initialiced \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+int cuckoo_map_init(HashMap *map, int size) {
+    CuckooTable *table = malloc(sizeof(CuckooTable));
+    if (!table || cuckoo_alloc(table, cuckoo_buckets_for(size > 0 ? (size_t)size : 1)) != CLIB_OK) {
+        free(table);
+        return CLIB_ERROR;
+    }
+    map->engine_data = table;
+    map->size = (int)((table->mask + 1) * BUCKET_SLOTS);
+    return CLIB_OK;
+}
@@ -0,0 +1,381 @@
+// ****************************************************************************************
+/**
+ * @file   HashMapEngine.h
+ * @brief  Private interface between Hash Map API and its storage engines
+ *
+ * @details Public hash_map_* functions hash the key once and forward the call to the
+ *          operations of the engine selected on #create_hash_map_engine.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+#ifndef CLIB_HASH_MAP_ENGINE_H
+#define CLIB_HASH_MAP_ENGINE_H
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+
+/// Hint the CPU to load #addr into cache without waiting for it
+#if defined(__GNUC__) || defined(__clang__)
+#define HASH_MAP_PREFETCH(addr)         __builtin_prefetch((addr))
+#else
+#define HASH_MAP_PREFETCH(addr)         ((void)(addr))
+#endif
+
+/// Number of dependent loads of a lookup prefetched by batched operations
+#define HASH_MAP_PREFETCH_STAGES        (3)
+
+/// Operation counters, only compiled with CLIB_HASH_MAP_STATS so hot paths cost nothing without it
+#ifdef CLIB_HASH_MAP_STATS
+#define HASH_MAP_COUNT_BEGIN(map, counters) ((map)->counting = &(map)->counters, (map)->counters.calls++)
+#define HASH_MAP_COUNT(map, field)          ((map)->counting ? (void)(map)->counting->field++ : (void)0)
+#define HASH_MAP_COUNT_END(map)             ((map)->counting = NULL)
+#else
+#define HASH_MAP_COUNT_BEGIN(map, counters) ((void)0)
+#define HASH_MAP_COUNT(map, field)          ((void)0)
+#define HASH_MAP_COUNT_END(map)             ((void)0)
+#endif
+
+/// Operations every Hash Map engine implements. Keys are given with their full hash.
+typedef struct {
+    /// Return value of #key or NULL if it does not exist
+    void * (*get)(HashMap *map, uint64_t hash, const char *key, size_t len);
+    /// Return the value slot of #key, inserting it with a NULL value if it does not exist
+    void ** (*insert)(HashMap *map, uint64_t hash, const char *key, size_t len, bool *inserted);
+    /// Remove #key, leaving its value on #value. Return false if #key does not exist
+    bool (*erase)(HashMap *map, uint64_t hash, const char *key, size_t len, void **value);
+    /// Make room for #count pairs
+    int (*reserve)(HashMap *map, unsigned int count);
+    /// Call #visit for every pair of the map
+    void (*foreach)(HashMap *map, EntryVisitor visit, void *ctx);
+    /// Move #it to the pair following it->position / it->cursor, false if there is none
+    bool (*iter_next)(HashMap *map, HashMapIter *it);
+    /// Prefetch the memory a lookup of #hash reads on #stage (0: table entry, 1: node or slot,
+    /// 2: key). Stage N may read what stage N - 1 prefetched
+    void (*prefetch)(HashMap *map, uint64_t hash, int stage);
+    /// Fill table occupancy fields of #stats (histogram and max chain)
+    void (*stats)(HashMap *map, HashMapStats *stats);
+    /// Free every engine structure (values are freed by the caller on #foreach, keys on arena)
+    void (*destroy)(HashMap *map);
+} HashMapOps;
+
+
+/// Bits of a Bloom filter block: one cache line, so a check reads a single line
+#define HASH_MAP_FILTER_BLOCK_BITS      (512)
+
+/// Blocked Bloom filter of the keys of a map, checked before asking the engine
+struct hash_map_filter {
+    uint64_t *blocks;           //< #block_count blocks of 512 bits, cache line aligned
+    size_t block_count;         //< Number of blocks
+    unsigned int hashes;        //< Bits set per key, all of them on the block of the key
+    unsigned int bits_per_key;  //< Bits per key the filter keeps when it is full
+    unsigned int capacity;      //< Keys the filter is sized for before it is rebuilt bigger
+    unsigned int keys;          //< Keys added since last rebuild (removed ones included)
+    unsigned int removed;       //< Keys removed since last rebuild, whose bits are stale
+    unsigned long rejects;      //< Gets answered by the filter alone (CLIB_HASH_MAP_STATS)
+    unsigned long false_positives;  //< Gets passing the filter but missing (CLIB_HASH_MAP_STATS)
+};
+
+/// Count a filter outcome, only compiled with CLIB_HASH_MAP_STATS
+#ifdef CLIB_HASH_MAP_STATS
+#define HASH_MAP_FILTER_COUNT(filter, field)    ((void)(filter)->field++)
+#else
+#define HASH_MAP_FILTER_COUNT(filter, field)    ((void)0)
+#endif
+
+/// Block of #hash: high half of the hash scaled to the number of blocks
+static inline uint64_t * filter_block(const struct hash_map_filter *filter, uint64_t hash) {
+    return filter->blocks + HASH_MAP_FILTER_BLOCK_BITS / 64 *
+           (size_t)(((hash >> 32) * (uint64_t)filter->block_count) >> 32);
+}
+
+/// Bits of #hash inside its block, taken 9 at a time from the top of a remix of the hash
+static inline uint64_t filter_bits(uint64_t hash) {
+    return hash * 0x9E3779B97F4A7C15ull;
+}
+
+/// Return false if #hash was never added to #filter, true if it may have been
+static inline bool filter_may_contain(const struct hash_map_filter *filter, uint64_t hash) {
+    const uint64_t *block = filter_block(filter, hash);
+    uint64_t bits = filter_bits(hash);
+    for (unsigned int i = 0; i < filter->hashes; i++, bits <<= 9) {
+        unsigned int bit = (unsigned int)(bits >> 55);
+        if (!(block[bit >> 6] & ((uint64_t)1 << (bit & 63))))
+            return false;
+    }
+    return true;
+}
+
+
+/// Most threads a parallel operation on maps runs on
+#define HASH_MAP_MAX_THREADS            (64)
+
+/// Work of one thread of #parallel_run, #id goes from 0 to the number of threads - 1
+typedef void (*ParallelTask)(void *ctx, unsigned int id);
+
+
+/// Bytes of every key arena block
+#define KEY_ARENA_BLOCK                 (64 * 1024)
+/// Key arena chunks are multiples of this, so a freed chunk can hold its free list link
+#define KEY_ARENA_ALIGN                 (8)
+/// Longest chunk carved from key arena blocks, longer keys get an allocation of their own
+#define KEY_ARENA_MAX_CHUNK             (512)
+
+/// Engines implementations
+extern const HashMapOps CHAINED_MAP_OPS;
+extern const HashMapOps SWISS_MAP_OPS;
+extern const HashMapOps COMPACT_MAP_OPS;
+extern const HashMapOps CUCKOO_MAP_OPS;
+extern const HashMapOps MAPPED_MAP_OPS;
+extern const HashMapOps FROZEN_MAP_OPS;
+
+
+// ****************************************************************************************
+// hash_map_alloc
+// ****************************************************************************************
+/**
+ *  Allocate a Hash Map with the common fields initialiced and no engine storage
+ * @param[in]    size    Initial size for the Hash Map
+ * @param[in]    engine  Storage engine of the map
+ * @return       Pointer to a Hash Map structure, NULL if it can not be allocated
+ */
+// ****************************************************************************************
+HashMap * hash_map_alloc(int size, HashMapEngine engine);
+
+
+// ****************************************************************************************
+// hash_map_new_seed
+// ****************************************************************************************
+/**
+ *  Obtain the hash seed of a new map, different for every map created by any thread
+ * @param[in]    owner      Map the seed is for, its address is mixed into the seed
+ * @return       Seed of the hash function of #owner
+ */
+// ****************************************************************************************
+uint64_t hash_map_new_seed(const void *owner);
+
+
+// ****************************************************************************************
+// hash_map_lookup
+// ****************************************************************************************
+/**
+ *  Get the value of #key, with full #hash, from the engine of #map
+ * @param[in]    map        Hash Map to search
+ * @param[in]    hash       Full hash of #key with the seed of #map
+ * @param[in]    key        Key to search
+ * @param[in]    len        Length of #key in bytes
+ * @return       Value of #key, NULL if it does not exist
+ *
+ * @details      Neither the Bloom filter nor operation counters are touched, so several
+ *               threads can look up the same map at once while no thread changes it and
+ *               no incremental rehash is pending.
+ */
+// ****************************************************************************************
+void * hash_map_lookup(HashMap *map, uint64_t hash, const char *key, size_t len);
+
+
+// ****************************************************************************************
+// key_arena_alloc
+// ****************************************************************************************
+/**
+ *  Obtain #size bytes for a key from #map key arena
+ * @param[in]    map        Hash Map owning the arena
+ * @param[in]    size       Number of bytes
+ * @return       Pointer to #size bytes aligned to #KEY_ARENA_ALIGN, valid until they are
+ *               given back with #key_arena_free or the map is destroyed. NULL if they can
+ *               not be allocated
+ */
+// ****************************************************************************************
+char * key_arena_alloc(HashMap *map, size_t size);
+
+
+// ****************************************************************************************
+// key_arena_free
+// ****************************************************************************************
+/**
+ *  Give back to #map key arena #size bytes obtained from #key_arena_alloc
+ * @param[in]    map        Hash Map owning the arena
+ * @param[in]    key        Bytes to give back
+ * @param[in]    size       Number of bytes, the same asked to #key_arena_alloc
+ *
+ * @details      Chunks are kept for the next keys of the same size class, allocations
+ *               longer than #KEY_ARENA_MAX_CHUNK go back to the system right away.
+ */
+// ****************************************************************************************
+void key_arena_free(HashMap *map, char *key, size_t size);
+
+
+// ****************************************************************************************
+// key_arena_bytes
+// ****************************************************************************************
+/**
+ *  Obtain the memory reserved by #map key arena, free chunks included
+ * @param[in]    map        Hash Map owning the arena
+ * @return       Bytes of every block and large allocation of the arena
+ */
+// ****************************************************************************************
+size_t key_arena_bytes(HashMap *map);
+
+
+// ****************************************************************************************
+// key_arena_destroy
+// ****************************************************************************************
+/**
+ *  Free every block of #map key arena
+ * @param[in]    map        Hash Map owning the arena
+ */
+// ****************************************************************************************
+void key_arena_destroy(HashMap *map);
+
+
+// ****************************************************************************************
+// swiss_map_init
+// ****************************************************************************************
+/**
+ *  Initialice swiss engine state of #map for at least #size pairs
+ * @param[in]    map   Hash Map whose engine is #HASH_MAP_SWISS
+ * @param[in]    size  Initial number of pairs
+ * @return       CLIB_OK    if engine is initialiced \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+int swiss_map_init(HashMap *map, int size);
+
+
+// ****************************************************************************************
+// compact_map_init
+// ****************************************************************************************
+/**
+ *  Initialice compact engine state of #map for at least #size pairs
+ * @param[in]    map   Hash Map whose engine is #HASH_MAP_COMPACT
+ * @param[in]    size  Initial number of pairs
+ * @return       CLIB_OK    if engine is initialiced \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+int compact_map_init(HashMap *map, int size);
+
+
+// ****************************************************************************************
+// cuckoo_map_init
+// ****************************************************************************************
+/**
+ *  Initialice cuckoo engine state of #map for at least #size pairs
+ * @param[in]    map   Hash Map whose engine is #HASH_MAP_CUCKOO
+ * @param[in]    size  Initial number of pairs
+ * @return       CLIB_OK    if engine is initialiced \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+int cuckoo_map_init(HashMap *map, int size);
+
+
+// ****************************************************************************************
+// filter_add
+// ****************************************************************************************
+/**
+ *  Add #hash, of a key just inserted on #map, to the Bloom filter of #map
+ * @param[in]    map   Hash Map with a filter
+ * @param[in]    hash  Full hash of the new key
+ *
+ * @details      Filter is rebuilt bigger once it holds more keys than it was sized for.
+ */
+// ****************************************************************************************
+void filter_add(HashMap *map, uint64_t hash);
+
+
+// ****************************************************************************************
+// filter_remove
+// ****************************************************************************************
+/**
+ *  Account a key removed from #map, rebuilding its Bloom filter once stale bits pile up
+ * @param[in]    map   Hash Map with a filter
+ */
+// ****************************************************************************************
+void filter_remove(HashMap *map);
+
+
+// ****************************************************************************************
+// filter_stats
+// ****************************************************************************************
+/**
+ *  Fill Bloom filter fields of #stats
+ * @param[in]    map   Hash Map with a filter
+ * @param[out]   stats Statistics of #map
+ */
+// ****************************************************************************************
+void filter_stats(HashMap *map, HashMapStats *stats);
+
+
+// ****************************************************************************************
+// filter_destroy
+// ****************************************************************************************
+/**
+ *  Free the Bloom filter of #map, if any
+ * @param[in]    map   Hash Map owning the filter
+ */
+// ****************************************************************************************
+void filter_destroy(HashMap *map);
+
+
+// ****************************************************************************************
+// parallel_run
+// ****************************************************************************************
+/**
+ *  Run #task on #threads threads, each one with its own id, and wait for all of them
+ * @param[in]    threads    Number of threads (at most #HASH_MAP_MAX_THREADS)
+ * @param[in]    task       Function to run
+ * @param[in]    ctx        State shared by every thread
+ *
+ * @details      Id 0 runs on the calling thread. Ids whose thread can not be created also
+ *               run there, after the others are started.
+ */
+// ****************************************************************************************
+void parallel_run(unsigned int threads, ParallelTask task, void *ctx);
+
+
+// ****************************************************************************************
+// hash_map_build_len
+// ****************************************************************************************
+/**
+ *  Create a Hash Map holding #n key-value pairs, built on #nthreads threads
+ * @param[in]    keys       Keys of pairs key-value
+ * @param[in]    lens       Length of every key in bytes (NULL if keys are NUL terminated)
+ * @param[in]    values     Value of every key (NULL to set every value to NULL)
+ * @param[in]    n          Number of pairs
+ * @param[in]    nthreads   Number of threads building the map
+ * @return       Pointer to a Hash Map with #HASH_MAP_CHAINED engine, NULL if it can not be
+ *               allocated
+ */
+// ****************************************************************************************
+HashMap * hash_map_build_len(const char * const *keys, const size_t *lens, void **values,
+                             size_t n, int nthreads);
+
+
+// ****************************************************************************************
+// frozen_map_build
+// ****************************************************************************************
+/**
+ *  Build a frozen engine state holding a copy of every pair of #map
+ * @param[in]    map   Hash Map to copy (left unchanged)
+ * @return       Engine state for a #HASH_MAP_FROZEN map, NULL if it can not be built
+ */
+// ****************************************************************************************
+void * frozen_map_build(HashMap *map);
+
+#endif // CLIB_HASH_MAP_ENGINE_H
@@ -0,0 +1,238 @@
+// ****************************************************************************************
+/**
+ * @file   HashMapFilter.c
+ * @brief  Blocked Bloom filter guarding Hash Map lookups of absent keys
+ *
+ * @details The filter is an array of 512 bit blocks, one cache line each. High half of
+ *          the key hash picks the block and a remix of the hash picks the bits inside it,
+ *          so a check or an insertion reads or writes a single line. Bits can not be
+ *          cleared on removal (they may be shared with other keys), so the filter is
+ *          rebuilt from the keys of the map once enough of its keys are stale.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define BLOCK_BYTES             (HASH_MAP_FILTER_BLOCK_BITS / 8)
+#define BLOCK_WORDS             (HASH_MAP_FILTER_BLOCK_BITS / 64)
+/// Smallest number of keys a filter is sized for
+#define MIN_CAPACITY            (64)
+/// Bits per key are taken 9 at a time from a 64 bit remix of the hash
+#define MAX_HASHES              (7)
+#define MAX_BITS_PER_KEY        (64)
+
+typedef struct hash_map_filter HashMapFilter;
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+static void filter_set(HashMapFilter *filter, uint64_t hash) {
+    uint64_t *block = filter_block(filter, hash);
+    uint64_t bits = filter_bits(hash);
+    for (unsigned int i = 0; i < filter->hashes; i++, bits <<= 9) {
+        unsigned int bit = (unsigned int)(bits >> 55);
+        block[bit >> 6] |= (uint64_t)1 << (bit & 63);
+    }
+}
+
+/// Visitor adding every key of a map to the filter given on #ctx
+static void filter_visitor(const char *key, size_t key_len, void *value, void *ctx) {
+    (void)value;
+    HashMap *map = ctx;
+    filter_set(map->filter, hash_bytes(key, key_len, map->seed));
+}
+
+
+// ****************************************************************************************
+// filter_create
+// ****************************************************************************************
+/*  Private function to allocate an empty filter for #capacity keys
+ * @param[in]    bits_per_key  Bits per key when #capacity keys are added
+ * @param[in]    capacity      Number of keys
+ * @return       New filter, NULL if it can not be allocated
+ */
+// ****************************************************************************************
+static HashMapFilter * filter_create(unsigned int bits_per_key, unsigned int capacity) {
+    HashMapFilter *filter = calloc(1, sizeof(HashMapFilter));
+    if (!filter)
+        return NULL;
+    filter->bits_per_key = bits_per_key;
+    filter->capacity = capacity < MIN_CAPACITY ? MIN_CAPACITY : capacity;
+    // ln(2) * bits per key minimizes false positives of a classic Bloom filter
+    filter->hashes = (bits_per_key * 7 + 5) / 10;
+    filter->hashes = filter->hashes < 1 ? 1 : filter->hashes > MAX_HASHES ? MAX_HASHES : filter->hashes;
+    filter->block_count = ((size_t)filter->capacity * bits_per_key + HASH_MAP_FILTER_BLOCK_BITS - 1) /
+                          HASH_MAP_FILTER_BLOCK_BITS;
+    filter->blocks = aligned_alloc(BLOCK_BYTES, filter->block_count * BLOCK_BYTES);
+    if (!filter->blocks) {
+        free(filter);
+        return NULL;
+    }
+    memset(filter->blocks, 0, filter->block_count * BLOCK_BYTES);
+    return filter;
+}
+
+
+// ****************************************************************************************
+// filter_rebuild
+// ****************************************************************************************
+/*  Private function to replace the filter of #map with a new one holding its current keys
+ * @param[in]    map           Hash Map to filter
+ * @param[in]    bits_per_key  Bits per key of the new filter
+ * @return       CLIB_OK    if the filter is replaced \n
+ *               CLIB_ERROR in other case (#map keeps its previous filter)
+ *
+ * @details      New filter has room for twice the current keys.
+ */
+// ****************************************************************************************
+static int filter_rebuild(HashMap *map, unsigned int bits_per_key) {
+    HashMapFilter *old = map->filter;
+    HashMapFilter *filter = filter_create(bits_per_key, map->count * 2);
+    if (!filter)
+        return CLIB_ERROR;
+
+    map->filter = filter;
+    hash_map_foreach(map, filter_visitor, map);
+    filter->keys = map->count;
+    if (old) {
+        filter->rejects = old->rejects;
+        filter->false_positives = old->false_positives;
+        free(old->blocks);
+        free(old);
+    }
+    return CLIB_OK;
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// filter_add
+// ****************************************************************************************
+/**
+ *  Add #hash, of a key just inserted on #map, to the Bloom filter of #map
+ * @param[in]    map   Hash Map with a filter
+ * @param[in]    hash  Full hash of the new key
+ *
+ * @details      Filter is rebuilt bigger once it holds more keys than it was sized for.
+ */
+// ****************************************************************************************
+void filter_add(HashMap *map, uint64_t hash) {
+    HashMapFilter *filter = map->filter;
+    // Key is set first: if the bigger filter can not be allocated this one stays valid
+    filter_set(filter, hash);
+    if (++filter->keys > filter->capacity)
+        filter_rebuild(map, filter->bits_per_key);
+}
+
+
+// ****************************************************************************************
+// filter_remove
+// ****************************************************************************************
+/**
+ *  Account a key removed from #map, rebuilding its Bloom filter once stale bits pile up
+ * @param[in]    map   Hash Map with a filter
+ */
+// ****************************************************************************************
+void filter_remove(HashMap *map) {
+    HashMapFilter *filter = map->filter;
+    if (++filter->removed * 2 >= filter->keys)
+        filter_rebuild(map, filter->bits_per_key);
+}
+
+
+// ****************************************************************************************
+// filter_stats
+// ****************************************************************************************
+/**
+ *  Fill Bloom filter fields of #stats
+ * @param[in]    map   Hash Map with a filter
+ * @param[out]   stats Statistics of #map
+ */
+// ****************************************************************************************
+void filter_stats(HashMap *map, HashMapStats *stats) {
+    HashMapFilter *filter = map->filter;
+    double fpr = 0;
+    // An absent key passes if all its bits are set: (fill of its block) ^ hashes
+    for (size_t b = 0; b < filter->block_count; b++) {
+        int set = 0;
+        for (int w = 0; w < BLOCK_WORDS; w++)
+            set += __builtin_popcountll(filter->blocks[b * BLOCK_WORDS + (size_t)w]);
+        double fill = (double)set / HASH_MAP_FILTER_BLOCK_BITS, pass = 1;
+        for (unsigned int i = 0; i < filter->hashes; i++)
+            pass *= fill;
+        fpr += pass;
+    }
+    stats->filter_bytes = sizeof(HashMapFilter) + filter->block_count * BLOCK_BYTES;
+    stats->filter_fpr = fpr / (double)filter->block_count;
+    stats->filter_rejects = filter->rejects;
+    if (filter->rejects + filter->false_positives)
+        stats->filter_measured_fpr = (double)filter->false_positives /
+                                     (double)(filter->rejects + filter->false_positives);
+}
+
+
+// ****************************************************************************************
+// filter_destroy
+// ****************************************************************************************
+/**
+ *  Free the Bloom filter of #map, if any
+ * @param[in]    map   Hash Map owning the filter
+ */
+// ****************************************************************************************
+void filter_destroy(HashMap *map) {
+    if (!map->filter)
+        return;
+    free(map->filter->blocks);
+    FREE_TO_NULL(map->filter);
+}
+
+
+// ****************************************************************************************
+// hash_map_enable_filter
+// ****************************************************************************************
+/**
+ *  Check every get and remove of #map against a Bloom filter of its keys first
+ * @param[in]    map           Hash Map to filter
+ * @param[in]    bits_per_key  Filter bits per key (#HASH_MAP_FILTER_BITS_PER_KEY), 0 to
+ *                             remove the filter
+ * @param[out]   none
+ * @return       CLIB_OK    if the filter is built \n
+ *               CLIB_ERROR if it can not be allocated (#map keeps its previous filter)
+ */
+// ****************************************************************************************
+int hash_map_enable_filter(HashMap *map, unsigned int bits_per_key) {
+    if (bits_per_key == 0) {
+        filter_destroy(map);
+        return CLIB_OK;
+    }
+    if (bits_per_key > MAX_BITS_PER_KEY)
+        return CLIB_ERROR;
+    if (filter_rebuild(map, bits_per_key) != CLIB_OK)
+        return CLIB_ERROR;
+    // A new filter starts its measures from scratch
+    map->filter->rejects = 0;
+    map->filter->false_positives = 0;
+    return CLIB_OK;
+}
@@ -0,0 +1,378 @@
+// ****************************************************************************************
+/**
+ * @file   HashMapFrozen.c
+ * @brief  Read only minimal perfect hash engine of Hash Map
+ *
+ * @details Built by #hash_map_freeze from the pairs of a map, with the CHD
+ *          (hash, displace and compress) method: keys are split on small buckets, and
+ *          every bucket gets the seed which sends all of its keys to free slots of a table
+ *          with exactly one slot per pair. A lookup reads the seed of its bucket and then
+ *          a single slot, so it does one probe and at most one key compare.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+/// Average number of keys per bucket. Higher values need less seed memory and longer builds
+#define KEYS_PER_BUCKET         (4)
+/// Max number of pairs of a frozen map, same limit than in memory tables
+#define MAX_PAIRS               (1u << 30)
+/// Seeds with this bit set hold the slot of the single key of their bucket
+#define SEED_DIRECT             (0x80000000u)
+
+/// Frozen table slot
+typedef struct {
+    char *key;                  //< Key of key-value pair (on #FrozenTable keys)
+    void *value;                //< Value of key-value pair
+    uint32_t key_len;           //< Length of key
+    uint32_t check;             //< Low 32 bits of key hash, rejects most misses without compare
+} FrozenSlot;
+
+/// Frozen table state, stored on HashMap engine_data
+typedef struct {
+    uint32_t *seeds;            //< Position seed of every bucket
+    FrozenSlot *slots;          //< One slot per pair
+    char *keys;                 //< Bytes of every key, NUL terminated
+    uint32_t buckets;           //< Number of buckets
+    uint32_t size;              //< Number of slots (number of pairs, at least 1)
+} FrozenTable;
+
+/// Pairs of the map being frozen
+typedef struct {
+    const char **keys;
+    size_t *key_lens;
+    void **values;
+    size_t count;
+} FreezeContext;
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+/// Map 32 random bits to [0, #range) without a division
+static inline uint32_t frozen_range(uint64_t bits, uint32_t range) {
+    return (uint32_t)(((bits & 0xFFFFFFFFu) * range) >> 32);
+}
+
+/// Bucket of a key, from the high bits of its hash
+static inline uint32_t frozen_bucket(const FrozenTable *table, uint64_t hash) {
+    return frozen_range(hash >> 32, table->buckets);
+}
+
+/// Slot of a key given the seed of its bucket
+static inline uint32_t frozen_slot(const FrozenTable *table, uint64_t hash, uint32_t seed) {
+    if (seed & SEED_DIRECT)
+        return seed & ~SEED_DIRECT;
+    uint64_t x = hash ^ ((uint64_t)seed * 0x9E3779B97F4A7C15ull);
+    x ^= x >> 32;
+    x *= 0xD6E8FEB86659FD93ull;
+    x ^= x >> 32;
+    return frozen_range(x, table->size);
+}
+
+static void freeze_visitor(const char *key, size_t key_len, void *value, void *ctx) {
+    FreezeContext *freeze = ctx;
+    freeze->keys[freeze->count] = key;
+    freeze->key_lens[freeze->count] = key_len;
+    freeze->values[freeze->count] = value;
+    freeze->count++;
+}
+
+
+// ****************************************************************************************
+// frozen_place
+// ****************************************************************************************
+/*  Private function to find the seeds placing every key on its own slot
+ * @param[in]    table      Table with #buckets and #size set, seeds are written
+ * @param[in]    hashes     Full hash of every key
+ * @param[in]    n          Number of keys
+ * @param[out]   owner      Key of every slot
+ * @return       CLIB_OK    if every bucket got a seed \n
+ *               CLIB_ERROR in other case (allocation failed or keys with equal full hash)
+ *
+ * @details      Buckets are placed from the biggest to the smallest, while the table still
+ *               has many free slots for them. Seeds are tried in order until all the keys
+ *               of the bucket land on free and different slots. Buckets of a single key
+ *               come last, when free slots are scarce, so instead of searching a seed they
+ *               store the slot of their key directly (#SEED_DIRECT).
+ */
+// ****************************************************************************************
+static int frozen_place(FrozenTable *table, const uint64_t *hashes, size_t n, uint32_t *owner) {
+    uint32_t *start = calloc((size_t)table->buckets + 1, sizeof(uint32_t));
+    uint32_t *order = malloc((n ? n : 1) * sizeof(uint32_t));
+    uint32_t *by_size = malloc((size_t)table->buckets * sizeof(uint32_t));
+    // Probes only read this bitmap of used slots, small enough to stay on cache
+    uint64_t *used = calloc((size_t)table->size / 64 + 1, sizeof(uint64_t));
+    uint32_t sizes[65] = { 0 };
+    uint32_t slots[64];
+    int result = CLIB_ERROR;
+    if (!start || !order || !by_size || !used)
+        goto out;
+
+    // Counting sort of keys by bucket
+    for (size_t i = 0; i < n; i++)
+        start[frozen_bucket(table, hashes[i]) + 1]++;
+    for (uint32_t b = 0; b < table->buckets; b++) {
+        start[b + 1] += start[b];
+        uint32_t size = start[b + 1] - start[b];
+        // Buckets over 64 keys only come from a broken hash
+        if (size > 64)
+            goto out;
+        sizes[size]++;
+    }
+    // #by_size is free until buckets are sorted, so it is the fill cursor of every bucket
+    uint32_t *fill = by_size;
+    for (uint32_t b = 0; b < table->buckets; b++)
+        fill[b] = start[b];
+    for (size_t i = 0; i < n; i++)
+        order[fill[frozen_bucket(table, hashes[i])]++] = (uint32_t)i;
+
+    // Counting sort of buckets by size, biggest first
+    uint32_t first[65];
+    first[64] = 0;
+    for (int size = 63; size >= 0; size--)
+        first[size] = first[size + 1] + sizes[size + 1];
+    for (uint32_t b = 0; b < table->buckets; b++)
+        by_size[first[start[b + 1] - start[b]]++] = b;
+
+    uint64_t max_tries = (uint64_t)n * 64 + 1024;
+    uint32_t free_slot = 0;
+    for (uint32_t i = 0; i < table->buckets; i++) {
+        uint32_t b = by_size[i], count = start[b + 1] - start[b];
+        if (count == 0)
+            break;
+        if (count == 1) {
+            while (used[free_slot / 64] & (1ull << (free_slot % 64)))
+                free_slot++;
+            used[free_slot / 64] |= 1ull << (free_slot % 64);
+            owner[free_slot] = order[start[b]];
+            table->seeds[b] = SEED_DIRECT | free_slot;
+            continue;
+        }
+        uint64_t seed = 0;
+        for (;; seed++) {
+            if (seed >= max_tries || seed >= SEED_DIRECT)
+                goto out;
+            uint32_t placed = 0;
+            for (; placed < count; placed++) {
+                uint32_t slot = frozen_slot(table, hashes[order[start[b] + placed]], (uint32_t)seed);
+                if (used[slot / 64] & (1ull << (slot % 64)))
+                    break;
+                used[slot / 64] |= 1ull << (slot % 64);
+                slots[placed] = slot;
+            }
+            if (placed == count)
+                break;
+            // Collision with a placed key or with a key of this bucket, undo and retry
+            while (placed > 0) {
+                placed--;
+                used[slots[placed] / 64] &= ~(1ull << (slots[placed] % 64));
+            }
+        }
+        for (uint32_t k = 0; k < count; k++)
+            owner[slots[k]] = order[start[b] + k];
+        table->seeds[b] = (uint32_t)seed;
+    }
+    result = CLIB_OK;
+
+out:
+    free(start);
+    free(order);
+    free(by_size);
+    free(used);
+    return result;
+}
+
+
+/******************************************************************************/
+/************************** Engine Operations Implementations *****************/
+/******************************************************************************/
+
+static void * frozen_get(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    FrozenTable *table = map->engine_data;
+    FrozenSlot *slot = &table->slots[frozen_slot(table, hash, table->seeds[frozen_bucket(table, hash)])];
+    HASH_MAP_COUNT(map, probes);
+    if (slot->check != (uint32_t)hash || slot->key_len != len || !slot->key)
+        return NULL;
+    HASH_MAP_COUNT(map, compares);
+    return memcmp(slot->key, key, len) == 0 ? slot->value : NULL;
+}
+
+static void ** frozen_insert(HashMap *map, uint64_t hash, const char *key, size_t len, bool *inserted) {
+    (void)map;
+    (void)hash;
+    (void)key;
+    (void)len;
+    *inserted = false;
+    return NULL;
+}
+
+static bool frozen_erase(HashMap *map, uint64_t hash, const char *key, size_t len, void **value) {
+    (void)map;
+    (void)hash;
+    (void)key;
+    (void)len;
+    (void)value;
+    return false;
+}
+
+static int frozen_reserve(HashMap *map, unsigned int count) {
+    return count <= map->count ? CLIB_OK : CLIB_ERROR;
+}
+
+static void frozen_foreach(HashMap *map, EntryVisitor visit, void *ctx) {
+    FrozenTable *table = map->engine_data;
+    for (uint32_t i = 0; i < map->count; i++)
+        (*visit)(table->slots[i].key, table->slots[i].key_len, table->slots[i].value, ctx);
+}
+
+static bool frozen_iter_next(HashMap *map, HashMapIter *it) {
+    FrozenTable *table = map->engine_data;
+    if (it->position >= map->count)
+        return false;
+    FrozenSlot *slot = &table->slots[it->position++];
+    it->key = slot->key;
+    it->key_len = slot->key_len;
+    it->value = slot->value;
+    return true;
+}
+
+static void frozen_prefetch(HashMap *map, uint64_t hash, int stage) {
+    FrozenTable *table = map->engine_data;
+    uint32_t *seed = &table->seeds[frozen_bucket(table, hash)];
+    if (stage == 0) {
+        HASH_MAP_PREFETCH(seed);
+        return;
+    }
+    FrozenSlot *slot = &table->slots[frozen_slot(table, hash, *seed)];
+    if (stage == 1)
+        HASH_MAP_PREFETCH(slot);
+    else if (slot->key)
+        HASH_MAP_PREFETCH(slot->key);
+}
+
+static void frozen_stats(HashMap *map, HashMapStats *stats) {
+    // Every slot holds exactly one pair
+    stats->chain_histogram[1] = map->count;
+    stats->max_chain = map->count ? 1 : 0;
+}
+
+static void frozen_destroy(HashMap *map) {
+    FrozenTable *table = map->engine_data;
+    free(table->seeds);
+    free(table->slots);
+    free(table->keys);
+    FREE_TO_NULL(map->engine_data);
+}
+
+const HashMapOps FROZEN_MAP_OPS = {
+    .get = frozen_get,
+    .insert = frozen_insert,
+    .erase = frozen_erase,
+    .reserve = frozen_reserve,
+    .foreach = frozen_foreach,
+    .iter_next = frozen_iter_next,
+    .prefetch = frozen_prefetch,
+    .stats = frozen_stats,
+    .destroy = frozen_destroy,
+};
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// frozen_map_build
+// ****************************************************************************************
+/**
+ *  Build a frozen engine state holding a copy of every pair of #map
+ * @param[in]    map   Hash Map to copy (left unchanged)
+ * @return       Engine state for a #HASH_MAP_FROZEN map, NULL if it can not be built
+ */
+// ****************************************************************************************
+void * frozen_map_build(HashMap *map) {
+    size_t n = map->count, total = 0;
+    if (n > MAX_PAIRS)
+        return NULL;
+    FreezeContext freeze = {
+        .keys = malloc((n ? n : 1) * sizeof(char *)),
+        .key_lens = malloc((n ? n : 1) * sizeof(size_t)),
+        .values = malloc((n ? n : 1) * sizeof(void *)),
+        .count = 0,
+    };
+    FrozenTable *table = calloc(1, sizeof(FrozenTable));
+    uint64_t *hashes = malloc((n ? n : 1) * sizeof(uint64_t));
+    uint32_t *owner = NULL;
+    if (!freeze.keys || !freeze.key_lens || !freeze.values || !table || !hashes)
+        goto fail;
+
+    hash_map_foreach(map, freeze_visitor, &freeze);
+    for (size_t i = 0; i < n; i++) {
+        hashes[i] = hash_bytes(freeze.keys[i], freeze.key_lens[i], map->seed);
+        total += freeze.key_lens[i] + 1;
+    }
+
+    table->size = n ? (uint32_t)n : 1;
+    table->buckets = (uint32_t)((n + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET);
+    if (table->buckets == 0)
+        table->buckets = 1;
+    table->seeds = calloc(table->buckets, sizeof(uint32_t));
+    table->slots = calloc(table->size, sizeof(FrozenSlot));
+    table->keys = malloc(total ? total : 1);
+    owner = malloc(table->size * sizeof(uint32_t));
+    if (!table->seeds || !table->slots || !table->keys || !owner ||
+        frozen_place(table, hashes, n, owner) != CLIB_OK)
+        goto fail;
+
+    // Keys are copied in slot order, so iterating the map reads the key bytes sequentially
+    char *key = table->keys;
+    for (uint32_t slot = 0; slot < n; slot++) {
+        uint32_t pair = owner[slot];
+        memcpy(key, freeze.keys[pair], freeze.key_lens[pair]);
+        key[freeze.key_lens[pair]] = '\0';
+        table->slots[slot].key = key;
+        table->slots[slot].value = freeze.values[pair];
+        table->slots[slot].key_len = (uint32_t)freeze.key_lens[pair];
+        table->slots[slot].check = (uint32_t)hashes[pair];
+        key += freeze.key_lens[pair] + 1;
+    }
+    free(freeze.keys);
+    free(freeze.key_lens);
+    free(freeze.values);
+    free(hashes);
+    free(owner);
+    return table;
+
+fail:
+    if (table) {
+        free(table->seeds);
+        free(table->slots);
+        free(table->keys);
+        free(table);
+    }
+    free(freeze.keys);
+    free(freeze.key_lens);
+    free(freeze.values);
+    free(hashes);
+    free(owner);
+    return NULL;
+}
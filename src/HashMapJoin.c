@@ -0,0 +1,379 @@
+// ****************************************************************************************
+/**
+ * @file   HashMapJoin.c
+ * @brief  Parallel intersection, union and join of two Hash Maps
+ *
+ * @details Pairs of one map (the scanned map) are copied to arrays, hashed with the seed
+ *          of the other map (the probed map) and partitioned by the low bits of that hash,
+ *          which pick the table entry of a key on the probed map. Every thread then looks
+ *          up the keys of its own partition, so it only reads its own range of the probed
+ *          table, and writes its results on its own range of the output arrays.
+ *          Result maps are built from the output arrays with #hash_map_build_len.
+ *
+ *          A join runs in three phases, each one on every thread:
+ *              1. Hash a range of scanned keys, counting keys per partition.
+ *              2. Scatter the key indexes of the range to their partition.
+ *              3. Look up the keys of a partition on the probed map.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+/// Scanned pairs per partition at least, so small maps do not pay for threads
+#define MIN_PARTITION_PAIRS     (4096)
+
+/// Pairs a probe phase writes on the output
+typedef enum {
+    JOIN_MATCHES,               //< Pairs whose key is on both maps, with combined value
+    JOIN_ALL,                   //< Every scanned pair, with combined value if on both maps
+    JOIN_MISSES,                //< Scanned pairs whose key is not on the probed map
+    JOIN_VISIT,                 //< No output, the visitor is called for every match
+} JoinEmit;
+
+/// Pairs of a map on arrays
+typedef struct {
+    const char **keys;
+    size_t *lens;
+    void **values;
+    size_t count;
+} PairArray;
+
+/// State shared by every thread of a join
+typedef struct {
+    PairArray scanned;          //< Pairs of the scanned map
+    HashMap *probed;            //< Map searched for every scanned key
+    bool swapped;               //< Scanned map is the second map of the call
+    JoinEmit emit;              //< Pairs written on #out
+    CombineFunction combine;    //< Value of keys on both maps (NULL for the value of the first map)
+    JoinVisitor visit;          //< Visitor of #JOIN_VISIT
+    void *ctx;                  //< Context of #visit
+    uint64_t *hashes;           //< Hash of every scanned key with the seed of #probed
+    uint32_t *order;            //< Scanned indexes grouped by partition
+    size_t *counts;             //< Keys of [thread][partition], then their first #order position
+    size_t *part_start;         //< First #order position (and #out position) of every partition
+    size_t *emitted;            //< Pairs written on #out by every partition
+    PairArray out;              //< Output pairs
+    unsigned int partitions;    //< Number of partitions and threads (power of two)
+    int shift;                  //< (hash & #mask) >> #shift is the partition of a key
+    uint64_t mask;              //< Hash bits picking a table entry of #probed
+} JoinJob;
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+static inline unsigned int join_partition_of(const JoinJob *job, uint64_t hash) {
+    return (unsigned int)((hash & job->mask) >> job->shift);
+}
+
+/// First scanned index of the range of thread #id
+static inline size_t join_range(const JoinJob *job, unsigned int id) {
+    size_t n = job->scanned.count;
+    return n / job->partitions * id + (n % job->partitions) * id / job->partitions;
+}
+
+/// Visitor appending every pair of a map to the #PairArray given on #ctx
+static void collect_visitor(const char *key, size_t key_len, void *value, void *ctx) {
+    PairArray *pairs = ctx;
+    pairs->keys[pairs->count] = key;
+    pairs->lens[pairs->count] = key_len;
+    pairs->values[pairs->count] = value;
+    pairs->count++;
+}
+
+/// Phase 1: hash keys of the range of #id and count them per partition
+static void join_hash(void *ctx, unsigned int id) {
+    JoinJob *job = ctx;
+    size_t *counts = &job->counts[(size_t)id * job->partitions];
+    uint64_t seed = job->probed->seed;
+    for (size_t i = join_range(job, id); i < join_range(job, id + 1); i++) {
+        job->hashes[i] = hash_bytes(job->scanned.keys[i], job->scanned.lens[i], seed);
+        counts[join_partition_of(job, job->hashes[i])]++;
+    }
+}
+
+/// Phase 2: place scanned indexes of the range of #id on the #order positions of their partition
+static void join_scatter(void *ctx, unsigned int id) {
+    JoinJob *job = ctx;
+    size_t *next = &job->counts[(size_t)id * job->partitions];
+    for (size_t i = join_range(job, id); i < join_range(job, id + 1); i++)
+        job->order[next[join_partition_of(job, job->hashes[i])]++] = (uint32_t)i;
+}
+
+/// Phase 3: look up the keys of partition #id on the probed map, writing its output pairs
+static void join_probe(void *ctx, unsigned int id) {
+    JoinJob *job = ctx;
+    HashMap *probed = job->probed;
+    size_t out = job->part_start[id];
+
+    for (size_t k = job->part_start[id]; k < job->part_start[id + 1]; k++) {
+        size_t i = job->order[k];
+        const char *key = job->scanned.keys[i];
+        size_t len = job->scanned.lens[i];
+        void *value = job->scanned.values[i];
+        void *found = NULL;
+        if (!probed->filter || filter_may_contain(probed->filter, job->hashes[i]))
+            found = hash_map_lookup(probed, job->hashes[i], key, len);
+
+        if (found) {
+            void *first = job->swapped ? found : value, *second = job->swapped ? value : found;
+            switch (job->emit) {
+                case JOIN_VISIT:
+                    (*job->visit)(key, len, first, second, job->ctx);
+                    continue;
+                case JOIN_MISSES:
+                    continue;
+                case JOIN_MATCHES:
+                case JOIN_ALL:
+                default:
+                    value = job->combine ? (*job->combine)(key, len, first, second) : first;
+                    break;
+            }
+        } else if (job->emit != JOIN_ALL && job->emit != JOIN_MISSES) {
+            continue;
+        }
+        job->out.keys[out] = key;
+        job->out.lens[out] = len;
+        job->out.values[out] = value;
+        out++;
+    }
+    job->emitted[id] = out - job->part_start[id];
+}
+
+
+/// Allocate arrays for #room pairs on #pairs, CLIB_ERROR if they can not be allocated
+static int pairs_alloc(PairArray *pairs, size_t room) {
+    pairs->keys = malloc(room * sizeof(char *) + 1);
+    pairs->lens = malloc(room * sizeof(size_t) + 1);
+    pairs->values = malloc(room * sizeof(void *) + 1);
+    pairs->count = 0;
+    return pairs->keys && pairs->lens && pairs->values ? CLIB_OK : CLIB_ERROR;
+}
+
+static void pairs_free(PairArray *pairs) {
+    free(pairs->keys);
+    free(pairs->lens);
+    free(pairs->values);
+}
+
+
+// ****************************************************************************************
+// join_run
+// ****************************************************************************************
+/*  Private function to look up every key of #scanned on #probed, on #nthreads threads
+ * @param[in]    job        Join state with #scanned, #probed, #emit and user functions set,
+ *                          and #out pointing where output pairs are written
+ * @param[in]    nthreads   Number of threads
+ * @return       Number of pairs written on job->out (consecutive), or SIZE_MAX if the join
+ *               state can not be allocated
+ */
+// ****************************************************************************************
+static size_t join_run(JoinJob *job, int nthreads) {
+    HashMap *probed = job->probed;
+    size_t n = job->scanned.count;
+    if (n > UINT32_MAX)
+        return SIZE_MAX;
+
+    // Lookups from several threads need every pair of the probed map on its current table
+    if (probed->old_list) {
+        HashMapIter it;
+        hash_map_iter_begin(probed, &it);
+    }
+
+    int bits = probed->size > 1 ? 64 - __builtin_clzll((uint64_t)probed->size - 1) : 0;
+    job->mask = bits ? ~0ull >> (64 - bits) : 0;
+    job->partitions = 1;
+    while ((int)job->partitions * 2 <= nthreads && job->partitions * 2 <= HASH_MAP_MAX_THREADS &&
+           n / (job->partitions * 2) >= MIN_PARTITION_PAIRS &&
+           __builtin_ctz(job->partitions * 2) <= bits)
+        job->partitions *= 2;
+    job->shift = bits - __builtin_ctz(job->partitions);
+
+    unsigned int parts = job->partitions;
+    size_t written = SIZE_MAX;
+    job->hashes = malloc(n * sizeof(uint64_t) + 1);
+    job->order = malloc(n * sizeof(uint32_t) + 1);
+    job->counts = calloc((size_t)parts * parts, sizeof(size_t));
+    job->part_start = malloc((parts + 1) * sizeof(size_t));
+    job->emitted = malloc(parts * sizeof(size_t));
+    if (job->hashes && job->order && job->counts && job->part_start && job->emitted) {
+        parallel_run(parts, join_hash, job);
+        // Turn counts into #order positions, lower threads first inside a partition
+        size_t position = 0;
+        for (unsigned int p = 0; p < parts; p++) {
+            job->part_start[p] = position;
+            for (unsigned int t = 0; t < parts; t++) {
+                size_t count = job->counts[(size_t)t * parts + p];
+                job->counts[(size_t)t * parts + p] = position;
+                position += count;
+            }
+        }
+        job->part_start[parts] = position;
+        parallel_run(parts, join_scatter, job);
+        parallel_run(parts, join_probe, job);
+
+        // Partitions write from their #part_start, so their outputs are packed together
+        written = job->emitted[0];
+        for (unsigned int p = 1; p < parts; p++) {
+            memmove(&job->out.keys[written], &job->out.keys[job->part_start[p]], job->emitted[p] * sizeof(char *));
+            memmove(&job->out.lens[written], &job->out.lens[job->part_start[p]], job->emitted[p] * sizeof(size_t));
+            memmove(&job->out.values[written], &job->out.values[job->part_start[p]], job->emitted[p] * sizeof(void *));
+            written += job->emitted[p];
+        }
+    }
+
+    free(job->hashes);
+    free(job->order);
+    free(job->counts);
+    free(job->part_start);
+    free(job->emitted);
+    return written;
+}
+
+
+// ****************************************************************************************
+// join_maps
+// ****************************************************************************************
+/*  Private function to run the join of #a and #b given by #emit
+ * @param[in]    a          First map
+ * @param[in]    b          Second map
+ * @param[in]    emit       #JOIN_MATCHES (intersection), #JOIN_ALL (union) or #JOIN_VISIT
+ * @param[in]    combine    Value of keys on both maps (NULL for the value on #a)
+ * @param[in]    visit      Visitor of #JOIN_VISIT
+ * @param[in]    ctx        Context of #visit
+ * @param[in]    nthreads   Number of threads
+ * @param[out]   result     New map with output pairs (not built for #JOIN_VISIT)
+ * @return       CLIB_OK    if the join is done \n
+ *               CLIB_ERROR if memory can not be allocated
+ */
+// ****************************************************************************************
+static int join_maps(HashMap *a, HashMap *b, JoinEmit emit, CombineFunction combine,
+                     JoinVisitor visit, void *ctx, int nthreads, HashMap **result) {
+    JoinJob job = { .emit = emit, .combine = combine, .visit = visit, .ctx = ctx };
+    PairArray out = { NULL, NULL, NULL, 0 };
+    // Matches are found from either side, so the smaller map is hashed and scattered
+    job.swapped = emit != JOIN_ALL && b->count < a->count;
+    job.probed = job.swapped ? a : b;
+    HashMap *scanned = job.swapped ? b : a;
+
+    // Output of a union are every pair of #a, then pairs of #b missing on #a
+    size_t room = emit == JOIN_VISIT ? 0 : scanned->count + (emit == JOIN_ALL ? (size_t)b->count : 0);
+    int status = CLIB_ERROR;
+    if (pairs_alloc(&job.scanned, scanned->count) != CLIB_OK || pairs_alloc(&out, room) != CLIB_OK)
+        goto out;
+    hash_map_foreach(scanned, collect_visitor, &job.scanned);
+    job.out = out;
+    size_t total = join_run(&job, nthreads);
+    if (total == SIZE_MAX)
+        goto out;
+
+    if (emit == JOIN_ALL) {
+        JoinJob misses = { .probed = a, .emit = JOIN_MISSES };
+        if (pairs_alloc(&misses.scanned, b->count) != CLIB_OK) {
+            pairs_free(&misses.scanned);
+            goto out;
+        }
+        hash_map_foreach(b, collect_visitor, &misses.scanned);
+        misses.out = (PairArray){ out.keys + total, out.lens + total, out.values + total, 0 };
+        size_t missing = join_run(&misses, nthreads);
+        pairs_free(&misses.scanned);
+        if (missing == SIZE_MAX)
+            goto out;
+        total += missing;
+    }
+
+    if (emit != JOIN_VISIT) {
+        *result = hash_map_build_len(out.keys, out.lens, out.values, total, nthreads);
+        if (!*result)
+            goto out;
+    }
+    status = CLIB_OK;
+
+out:
+    pairs_free(&job.scanned);
+    pairs_free(&out);
+    return status;
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// hash_map_intersect
+// ****************************************************************************************
+/**
+ *  Create a Hash Map with the keys present on both #a and #b, on #nthreads threads
+ * @param[in]    a          First map
+ * @param[in]    b          Second map
+ * @param[in]    combine    Value of every key of the result (NULL for its value on #a)
+ * @param[in]    nthreads   Number of threads
+ * @return       Pointer to a Hash Map with #HASH_MAP_CHAINED engine, NULL if it can not be
+ *               allocated
+ */
+// ****************************************************************************************
+HashMap * hash_map_intersect(HashMap *a, HashMap *b, CombineFunction combine, int nthreads) {
+    HashMap *result = NULL;
+    if (join_maps(a, b, JOIN_MATCHES, combine, NULL, NULL, nthreads, &result) != CLIB_OK)
+        return NULL;
+    return result;
+}
+
+
+// ****************************************************************************************
+// hash_map_union
+// ****************************************************************************************
+/**
+ *  Create a Hash Map with the keys present on #a or #b, on #nthreads threads
+ * @param[in]    a          First map
+ * @param[in]    b          Second map
+ * @param[in]    combine    Value of keys on both maps (NULL for their value on #a)
+ * @param[in]    nthreads   Number of threads
+ * @return       Pointer to a Hash Map with #HASH_MAP_CHAINED engine, NULL if it can not be
+ *               allocated
+ */
+// ****************************************************************************************
+HashMap * hash_map_union(HashMap *a, HashMap *b, CombineFunction combine, int nthreads) {
+    HashMap *result = NULL;
+    if (join_maps(a, b, JOIN_ALL, combine, NULL, NULL, nthreads, &result) != CLIB_OK)
+        return NULL;
+    return result;
+}
+
+
+// ****************************************************************************************
+// hash_map_join
+// ****************************************************************************************
+/**
+ *  Call #visit for every key present on both #a and #b, on #nthreads threads
+ * @param[in]    a          First map
+ * @param[in]    b          Second map
+ * @param[in]    visit      Function called with the key and its values on #a and #b
+ * @param[in]    ctx        Context given to #visit
+ * @param[in]    nthreads   Number of threads
+ * @return       CLIB_OK    if every common key is visited \n
+ *               CLIB_ERROR if memory can not be allocated (no key is visited)
+ */
+// ****************************************************************************************
+int hash_map_join(HashMap *a, HashMap *b, JoinVisitor visit, void *ctx, int nthreads) {
+    return join_maps(a, b, JOIN_VISIT, NULL, visit, ctx, nthreads, NULL);
+}
@@ -0,0 +1,470 @@
+// ****************************************************************************************
+/**
+ * @file   HashMapMapped.c
+ * @brief  Read only Hash Map engine answering lookups from a memory mapped image
+ *
+ * @details #hash_map_save writes every pair of a map as a position independent image:
+ *
+ *          | header | bucket index | entries | keys and values |
+ *
+ *          Bucket index holds count + 1 entry numbers, pairs of bucket b being the
+ *          entries from index[b] to index[b + 1]. Entries hold the full hash of their key
+ *          and the offsets of key and value bytes from the start of the file.
+ *          #hash_map_open_mapped maps the file and uses it as is.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define MAPPED_MAGIC            "CLIBHMAP"
+#define MAPPED_VERSION          (1)
+/// Written as is, so images of other byte order are detected on open
+#define MAPPED_BYTE_ORDER       (0x0102030405060708ull)
+/// Alignment of every value on the image
+#define MAPPED_ALIGN            (8)
+/// Max number of buckets, same limit than in memory tables
+#define MAPPED_MAX_BUCKETS      (1ull << 30)
+
+/// Image header, at offset 0
+typedef struct {
+    char magic[8];              //< MAPPED_MAGIC without NUL terminator
+    uint32_t version;           //< MAPPED_VERSION
+    uint32_t entry_size;        //< sizeof(MappedEntry) of the writer
+    uint64_t byte_order;        //< MAPPED_BYTE_ORDER of the writer
+    uint64_t seed;              //< Hash seed of the saved map
+    uint64_t count;             //< Number of pairs
+    uint64_t buckets;           //< Number of buckets (power of two)
+    uint64_t bucket_offset;     //< Offset of the bucket index (buckets + 1 uint64_t)
+    uint64_t entry_offset;      //< Offset of the entries (count MappedEntry)
+    uint64_t data_offset;       //< Offset of keys and values
+    uint64_t file_size;         //< Size of the whole image
+} MappedHeader;
+
+/// Image entry of a pair
+typedef struct {
+    uint64_t hash;              //< Full hash of key
+    uint64_t key;               //< Offset of key (NUL terminated)
+    uint64_t value;             //< Offset of value (aligned to MAPPED_ALIGN)
+    uint32_t key_len;           //< Length of key
+    uint32_t value_len;         //< Length of value
+} MappedEntry;
+
+/// Mapped engine state, stored on HashMap engine_data
+typedef struct {
+    uint8_t *base;              //< Start of the mapping
+    size_t length;              //< Bytes mapped
+    uint64_t *buckets;          //< Bucket index
+    MappedEntry *entries;       //< Entries, grouped by bucket
+    uint64_t mask;              //< Number of buckets - 1
+} MappedTable;
+
+/// Pairs of the map being saved
+typedef struct {
+    const char **keys;
+    size_t *key_lens;
+    void **values;
+    size_t count;
+} SaveContext;
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+static size_t string_size(const void *value) {
+    return value ? strlen(value) + 1 : 1;
+}
+
+static void string_encode(const void *value, void *buffer) {
+    memcpy(buffer, value ? value : "", string_size(value));
+}
+
+const ValueCodec VALUE_CODEC_STRING = { string_size, string_encode };
+
+
+static inline uint64_t mapped_align(uint64_t offset) {
+    return (offset + MAPPED_ALIGN - 1) & ~(uint64_t)(MAPPED_ALIGN - 1);
+}
+
+static void save_visitor(const char *key, size_t key_len, void *value, void *ctx) {
+    SaveContext *save = ctx;
+    save->keys[save->count] = key;
+    save->key_lens[save->count] = key_len;
+    save->values[save->count] = value;
+    save->count++;
+}
+
+
+// ****************************************************************************************
+// save_write
+// ****************************************************************************************
+/*  Private function to write the image of #save pairs on #file
+ * @param[in]    file       File opened for writing, at offset 0
+ * @param[in]    save       Pairs to write
+ * @param[in]    seed       Hash seed of the saved map
+ * @param[in]    codec      Serialization of values, NULL to save keys only
+ * @return       CLIB_OK    if image is written \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+static int save_write(FILE *file, SaveContext *save, uint64_t seed, const ValueCodec *codec) {
+    static const uint8_t padding[MAPPED_ALIGN] = { 0 };
+    size_t count = save->count ? save->count : 1;
+    uint64_t buckets = 1, offset;
+    while (buckets < save->count && buckets < MAPPED_MAX_BUCKETS)
+        buckets <<= 1;
+
+    uint64_t *index = calloc(buckets + 1, sizeof(uint64_t));
+    uint64_t *fill = malloc(buckets * sizeof(uint64_t));
+    uint64_t *hashes = malloc(count * sizeof(uint64_t));
+    size_t *order = malloc(count * sizeof(size_t));
+    MappedEntry *entries = malloc(count * sizeof(MappedEntry));
+    // Encoding buffer of values, never NULL even if every value is empty
+    size_t buffer_size = MAPPED_ALIGN;
+    uint8_t *buffer = malloc(buffer_size);
+    MappedHeader header;
+    int result = CLIB_ERROR;
+    if (!index || !fill || !hashes || !order || !entries || !buffer)
+        goto out;
+
+    // Counting sort of pairs by bucket, so every bucket is a contiguous run of entries
+    for (size_t i = 0; i < save->count; i++) {
+        hashes[i] = hash_bytes(save->keys[i], save->key_lens[i], seed);
+        index[(hashes[i] & (buckets - 1)) + 1]++;
+    }
+    for (uint64_t b = 0; b < buckets; b++) {
+        index[b + 1] += index[b];
+        fill[b] = index[b];
+    }
+    for (size_t i = 0; i < save->count; i++)
+        order[fill[hashes[i] & (buckets - 1)]++] = i;
+
+    memcpy(header.magic, MAPPED_MAGIC, sizeof(header.magic));
+    header.version = MAPPED_VERSION;
+    header.entry_size = sizeof(MappedEntry);
+    header.byte_order = MAPPED_BYTE_ORDER;
+    header.seed = seed;
+    header.count = save->count;
+    header.buckets = buckets;
+    header.bucket_offset = sizeof(MappedHeader);
+    header.entry_offset = header.bucket_offset + (buckets + 1) * sizeof(uint64_t);
+    header.data_offset = header.entry_offset + save->count * sizeof(MappedEntry);
+
+    // Keys and values follow entry order, so the keys of a bucket are also close together
+    offset = header.data_offset;
+    for (size_t i = 0; i < save->count; i++) {
+        size_t pair = order[i];
+        size_t value_len = codec ? (*codec->size)(save->values[pair]) : 0;
+        if (save->key_lens[pair] > UINT32_MAX || value_len > UINT32_MAX)
+            goto out;
+        entries[i].hash = hashes[pair];
+        entries[i].key = offset;
+        entries[i].key_len = (uint32_t)save->key_lens[pair];
+        entries[i].value = mapped_align(offset + save->key_lens[pair] + 1);
+        entries[i].value_len = (uint32_t)value_len;
+        offset = mapped_align(entries[i].value + value_len);
+    }
+    header.file_size = offset;
+
+    if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+        fwrite(index, sizeof(uint64_t), buckets + 1, file) != buckets + 1 ||
+        fwrite(entries, sizeof(MappedEntry), save->count, file) != save->count)
+        goto out;
+
+    for (size_t i = 0; i < save->count; i++) {
+        size_t pair = order[i];
+        size_t key_end = save->key_lens[pair] + 1;
+        size_t key_pad = (size_t)(entries[i].value - entries[i].key) - key_end;
+        size_t value_end = (size_t)(mapped_align(entries[i].value + entries[i].value_len) - entries[i].value);
+        if (value_end > buffer_size) {
+            uint8_t *grown = realloc(buffer, value_end);
+            if (!grown)
+                goto out;
+            buffer = grown;
+            buffer_size = value_end;
+        }
+        if (codec)
+            (*codec->encode)(save->values[pair], buffer);
+        memset(buffer + entries[i].value_len, 0, value_end - entries[i].value_len);
+
+        // Keys given by foreach are NUL terminated, so the terminator is copied with them
+        if (fwrite(save->keys[pair], 1, key_end, file) != key_end ||
+            fwrite(padding, 1, key_pad, file) != key_pad ||
+            fwrite(buffer, 1, value_end, file) != value_end)
+            goto out;
+    }
+    result = CLIB_OK;
+
+out:
+    free(index);
+    free(fill);
+    free(hashes);
+    free(order);
+    free(entries);
+    free(buffer);
+    return result;
+}
+
+
+// ****************************************************************************************
+// mapped_check
+// ****************************************************************************************
+/*  Private function to check #header describes an image of this build fitting on #size bytes
+ * @param[in]    header     Header of the image
+ * @param[in]    size       Size of the image file
+ * @return       true if the image can be used
+ */
+// ****************************************************************************************
+static bool mapped_check(const MappedHeader *header, uint64_t size) {
+    if (memcmp(header->magic, MAPPED_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != MAPPED_VERSION ||
+        header->entry_size != sizeof(MappedEntry) ||
+        header->byte_order != MAPPED_BYTE_ORDER ||
+        header->file_size != size)
+        return false;
+    if (header->buckets == 0 || header->buckets > MAPPED_MAX_BUCKETS ||
+        (header->buckets & (header->buckets - 1)) != 0 || header->count > UINT32_MAX)
+        return false;
+    // Sections in order, each one inside the file (sizes are bounded, so no overflow)
+    return header->bucket_offset >= sizeof(MappedHeader) &&
+           header->bucket_offset % MAPPED_ALIGN == 0 &&
+           header->entry_offset >= header->bucket_offset + (header->buckets + 1) * sizeof(uint64_t) &&
+           header->entry_offset % MAPPED_ALIGN == 0 &&
+           header->data_offset >= header->entry_offset + header->count * sizeof(MappedEntry) &&
+           header->data_offset <= size;
+}
+
+
+//=======================================================================================//
+//                                                                                       //
+//                                Mapped engine                                          //
+//                                                                                       //
+//=======================================================================================//
+
+static void * mapped_get(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    MappedTable *table = map->engine_data;
+    uint64_t bucket = hash & table->mask;
+    for (uint64_t i = table->buckets[bucket]; i < table->buckets[bucket + 1]; i++) {
+        MappedEntry *entry = &table->entries[i];
+        HASH_MAP_COUNT(map, probes);
+        if (entry->hash == hash && entry->key_len == len) {
+            HASH_MAP_COUNT(map, compares);
+            if (memcmp(table->base + entry->key, key, len) == 0)
+                return table->base + entry->value;
+        }
+    }
+    return NULL;
+}
+
+static void ** mapped_insert(HashMap *map, uint64_t hash, const char *key, size_t len, bool *inserted) {
+    (void)map;
+    (void)hash;
+    (void)key;
+    (void)len;
+    *inserted = false;
+    return NULL;
+}
+
+static bool mapped_erase(HashMap *map, uint64_t hash, const char *key, size_t len, void **value) {
+    (void)map;
+    (void)hash;
+    (void)key;
+    (void)len;
+    (void)value;
+    return false;
+}
+
+static int mapped_reserve(HashMap *map, unsigned int count) {
+    return count <= map->count ? CLIB_OK : CLIB_ERROR;
+}
+
+static void mapped_foreach(HashMap *map, EntryVisitor visit, void *ctx) {
+    MappedTable *table = map->engine_data;
+    for (unsigned int i = 0; i < map->count; i++) {
+        MappedEntry *entry = &table->entries[i];
+        (*visit)((char *)table->base + entry->key, entry->key_len, table->base + entry->value, ctx);
+    }
+}
+
+static bool mapped_iter_next(HashMap *map, HashMapIter *it) {
+    MappedTable *table = map->engine_data;
+    if (it->position >= map->count)
+        return false;
+    MappedEntry *entry = &table->entries[it->position++];
+    it->key = (char *)table->base + entry->key;
+    it->key_len = entry->key_len;
+    it->value = table->base + entry->value;
+    return true;
+}
+
+static void mapped_prefetch(HashMap *map, uint64_t hash, int stage) {
+    MappedTable *table = map->engine_data;
+    uint64_t bucket = hash & table->mask;
+    if (stage == 0) {
+        HASH_MAP_PREFETCH(&table->buckets[bucket]);
+        return;
+    }
+    uint64_t first = table->buckets[bucket];
+    if (first == table->buckets[bucket + 1])
+        return;
+    if (stage == 1)
+        HASH_MAP_PREFETCH(&table->entries[first]);
+    else
+        HASH_MAP_PREFETCH(table->base + table->entries[first].key);
+}
+
+static void mapped_stats(HashMap *map, HashMapStats *stats) {
+    MappedTable *table = map->engine_data;
+    for (uint64_t bucket = 0; bucket <= table->mask; bucket++) {
+        unsigned int chain = (unsigned int)(table->buckets[bucket + 1] - table->buckets[bucket]);
+        stats->chain_histogram[chain < HASH_MAP_STATS_HISTOGRAM ? chain : HASH_MAP_STATS_HISTOGRAM - 1]++;
+        if (chain > stats->max_chain)
+            stats->max_chain = chain;
+    }
+}
+
+static void mapped_destroy(HashMap *map) {
+    MappedTable *table = map->engine_data;
+    munmap(table->base, table->length);
+    FREE_TO_NULL(map->engine_data);
+}
+
+const HashMapOps MAPPED_MAP_OPS = {
+    .get = mapped_get,
+    .insert = mapped_insert,
+    .erase = mapped_erase,
+    .reserve = mapped_reserve,
+    .foreach = mapped_foreach,
+    .iter_next = mapped_iter_next,
+    .prefetch = mapped_prefetch,
+    .stats = mapped_stats,
+    .destroy = mapped_destroy,
+};
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// hash_map_save
+// ****************************************************************************************
+/**
+ *  Write every pair of #map on #path as an image #hash_map_open_mapped can map
+ * @param[in]    map        Hash Map to save (any engine)
+ * @param[in]    path       File to write (replaced atomically if it exists)
+ * @param[in]    codec      Serialization of values, NULL to save keys only
+ * @return       CLIB_OK    if image is written \n
+ *               CLIB_ERROR in other case
+ *
+ * @details      Image is written on "#path.tmp", flushed to disk and renamed over #path,
+ *               so readers never map a partially written image.
+ */
+// ****************************************************************************************
+int hash_map_save(HashMap *map, const char *path, const ValueCodec *codec) {
+    size_t count = map->count ? map->count : 1;
+    SaveContext save = {
+        .keys = malloc(count * sizeof(char *)),
+        .key_lens = malloc(count * sizeof(size_t)),
+        .values = malloc(count * sizeof(void *)),
+        .count = 0,
+    };
+    char *tmp_path = malloc(strlen(path) + sizeof(".tmp"));
+    int result = CLIB_ERROR;
+
+    if (save.keys && save.key_lens && save.values && tmp_path) {
+        hash_map_foreach(map, save_visitor, &save);
+        sprintf(tmp_path, "%s.tmp", path);
+        FILE *file = fopen(tmp_path, "wb");
+        if (file) {
+            result = save_write(file, &save, map->seed, codec);
+            if (fflush(file) != 0 || fsync(fileno(file)) != 0)
+                result = CLIB_ERROR;
+            if (fclose(file) != 0)
+                result = CLIB_ERROR;
+            if (result == CLIB_OK && rename(tmp_path, path) != 0)
+                result = CLIB_ERROR;
+            if (result != CLIB_OK)
+                remove(tmp_path);
+        }
+    }
+    free(save.keys);
+    free(save.key_lens);
+    free(save.values);
+    free(tmp_path);
+    return result;
+}
+
+
+// ****************************************************************************************
+// hash_map_open_mapped
+// ****************************************************************************************
+/**
+ *  Open an image written by #hash_map_save as a read only Hash Map
+ * @param[in]    path       Image file
+ * @param[out]   none
+ * @return       Pointer to a #HASH_MAP_MAPPED Hash Map, NULL if #path is not a valid image
+ *
+ * @details      File descriptor is closed once mapped, the mapping keeps the file alive
+ *               even if #path is replaced by a newer image.
+ */
+// ****************************************************************************************
+HashMap * hash_map_open_mapped(const char *path) {
+    struct stat st;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return NULL;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(MappedHeader)) {
+        close(fd);
+        return NULL;
+    }
+    size_t length = (size_t)st.st_size;
+    void *base = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return NULL;
+
+    MappedHeader *header = base;
+    MappedTable *table = malloc(sizeof(MappedTable));
+    HashMap *map = NULL;
+    if (!table || !mapped_check(header, length) ||
+        ((uint64_t *)(void *)((uint8_t *)base + header->bucket_offset))[header->buckets] != header->count ||
+        !(map = hash_map_alloc(1, HASH_MAP_MAPPED))) {
+        free(table);
+        munmap(base, length);
+        return NULL;
+    }
+
+    table->base = base;
+    table->length = length;
+    table->buckets = (uint64_t *)(void *)(table->base + header->bucket_offset);
+    table->entries = (MappedEntry *)(void *)(table->base + header->entry_offset);
+    table->mask = header->buckets - 1;
+    map->engine_data = table;
+    map->seed = header->seed;
+    map->size = (int)header->buckets;
+    map->count = (unsigned int)header->count;
+    return map;
+}
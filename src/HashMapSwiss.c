@@ -0,0 +1,437 @@
+// ****************************************************************************************
+/**
+ * @file   HashMapSwiss.c
+ * @brief  Open addressing "swiss table" engine of Hash Map
+ *
+ * @details Pairs live on a flat array of slots. Every slot has a 1 byte control tag which
+ *          is either EMPTY, DELETED or the 7 high bits of the key hash. Slots are grouped
+ *          on aligned groups of 16, and a lookup compares the whole group of tags against
+ *          the key tag at once, only comparing keys of matching slots.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define GROUP_WIDTH             (16)
+#define CTRL_EMPTY              ((uint8_t)0x80)
+#define CTRL_DELETED            ((uint8_t)0xFE)
+#define MIN_CAPACITY            (GROUP_WIDTH)
+
+/// Swiss table slot
+typedef struct {
+    uint64_t hash;              //< Full hash of key
+    char *key;                  //< Key of key-value pair
+    size_t key_len;             //< Length of key
+    void *value;                //< Value of key-value pair
+} SwissSlot;
+
+/// Swiss table state, stored on HashMap engine_data
+typedef struct {
+    uint8_t *ctrl;              //< Control tag of every slot
+    SwissSlot *slots;           //< Slots of the table
+    size_t capacity;            //< Number of slots (power of two, multiple of GROUP_WIDTH)
+    size_t growth_left;         //< Number of EMPTY slots that can be used before growing
+} SwissTable;
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+/// Tag stored on control bytes of full slots
+static inline uint8_t swiss_tag(uint64_t hash) {
+    return (uint8_t)(hash >> 57);
+}
+
+/// Max number of pairs of a table with #capacity slots (7/8 load factor)
+static inline size_t swiss_max_load(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+
+// ****************************************************************************************
+// group_match
+// ****************************************************************************************
+/*  Private function to obtain a bitmask of the slots of a group whose tag is #tag
+ * @param[in]    ctrl       First control tag of the group
+ * @param[in]    tag        Tag to match
+ */
+// ****************************************************************************************
+static inline uint32_t group_match(const uint8_t *ctrl, uint8_t tag) {
+#ifdef __SSE2__
+    __m128i group = _mm_load_si128((const __m128i *)(const void *)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)tag)));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; ++i)
+        mask |= (uint32_t)(ctrl[i] == tag) << i;
+    return mask;
+#endif
+}
+
+// ****************************************************************************************
+// group_match_free
+// ****************************************************************************************
+/*  Private function to obtain a bitmask of the EMPTY or DELETED slots of a group
+ * @param[in]    ctrl       First control tag of the group
+ */
+// ****************************************************************************************
+static inline uint32_t group_match_free(const uint8_t *ctrl) {
+#ifdef __SSE2__
+    // Only EMPTY and DELETED tags have the high bit set
+    return (uint32_t)_mm_movemask_epi8(_mm_load_si128((const __m128i *)(const void *)ctrl));
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; ++i)
+        mask |= (uint32_t)(ctrl[i] >> 7) << i;
+    return mask;
+#endif
+}
+
+/// Bitmask of the EMPTY slots of a group
+static inline uint32_t group_match_empty(const uint8_t *ctrl) {
+    return group_match(ctrl, CTRL_EMPTY);
+}
+
+static inline int lowest_bit(uint32_t mask) {
+    return __builtin_ctz(mask);
+}
+
+
+// ****************************************************************************************
+// swiss_alloc
+// ****************************************************************************************
+/*  Private function to allocate empty slots and tags for #capacity slots
+ * @param[in]    table      Table to initialice
+ * @param[in]    capacity   Number of slots
+ */
+// ****************************************************************************************
+static int swiss_alloc(SwissTable *table, size_t capacity) {
+    // Control tags are loaded 16 bytes at a time, so they must be aligned to 16
+    table->ctrl = aligned_alloc(GROUP_WIDTH, capacity);
+    table->slots = malloc(capacity * sizeof(SwissSlot));
+    if (!table->ctrl || !table->slots) {
+        free(table->ctrl);
+        free(table->slots);
+        return CLIB_ERROR;
+    }
+    memset(table->ctrl, CTRL_EMPTY, capacity);
+    table->capacity = capacity;
+    table->growth_left = swiss_max_load(capacity);
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// swiss_find_free
+// ****************************************************************************************
+/*  Private function to find the first EMPTY or DELETED slot on the probe sequence of #hash
+ * @param[in]    table      Table to search
+ * @param[in]    hash       Full hash of the key to place
+ *
+ * @details      Groups are probed with triangular numbers, which visits every group of a
+ *               power of two table.
+ */
+// ****************************************************************************************
+static size_t swiss_find_free(SwissTable *table, uint64_t hash) {
+    size_t group_mask = table->capacity / GROUP_WIDTH - 1;
+    size_t group = (size_t)hash & group_mask;
+    for (size_t probe = 1;; ++probe) {
+        uint32_t mask = group_match_free(table->ctrl + group * GROUP_WIDTH);
+        if (mask)
+            return group * GROUP_WIDTH + (size_t)lowest_bit(mask);
+        group = (group + probe) & group_mask;
+    }
+}
+
+
+// ****************************************************************************************
+// swiss_find
+// ****************************************************************************************
+/*  Private function to find the slot of #key
+ * @param[in]    map        Hash Map whose swiss table is searched
+ * @param[in]    hash       Full hash of #key
+ * @param[in]    key        Key to find
+ * @param[in]    len        Length of #key
+ * @return       Slot of #key, or NULL if #key does not exist
+ */
+// ****************************************************************************************
+static SwissSlot * swiss_find(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    SwissTable *table = map->engine_data;
+    size_t group_mask = table->capacity / GROUP_WIDTH - 1;
+    size_t group = (size_t)hash & group_mask;
+    uint8_t tag = swiss_tag(hash);
+
+    for (size_t probe = 1;; ++probe) {
+        const uint8_t *ctrl = table->ctrl + group * GROUP_WIDTH;
+        uint32_t mask = group_match(ctrl, tag);
+        HASH_MAP_COUNT(map, probes);
+        while (mask) {
+            SwissSlot *slot = &table->slots[group * GROUP_WIDTH + (size_t)lowest_bit(mask)];
+            if (slot->hash == hash && slot->key_len == len) {
+                HASH_MAP_COUNT(map, compares);
+                if (memcmp(slot->key, key, len) == 0)
+                    return slot;
+            }
+            mask &= mask - 1;
+        }
+        // An EMPTY slot ends every probe sequence which passed through this group
+        if (group_match_empty(ctrl))
+            return NULL;
+        group = (group + probe) & group_mask;
+    }
+}
+
+
+// ****************************************************************************************
+// swiss_rehash
+// ****************************************************************************************
+/*  Private function to move every pair of #table into a new table of #capacity slots
+ * @param[in]    table      Table to rehash (DELETED tags are dropped)
+ * @param[in]    capacity   New number of slots
+ */
+// ****************************************************************************************
+static int swiss_rehash(SwissTable *table, size_t capacity) {
+    SwissTable old = *table;
+    if (swiss_alloc(table, capacity) != CLIB_OK) {
+        *table = old;
+        return CLIB_ERROR;
+    }
+    for (size_t i = 0; i < old.capacity; ++i) {
+        if (old.ctrl[i] & 0x80)
+            continue;
+        size_t pos = swiss_find_free(table, old.slots[i].hash);
+        table->ctrl[pos] = old.ctrl[i];
+        table->slots[pos] = old.slots[i];
+        table->growth_left--;
+    }
+    free(old.ctrl);
+    free(old.slots);
+    return CLIB_OK;
+}
+
+/// Smallest valid capacity able to hold #count pairs
+static size_t swiss_capacity_for(size_t count) {
+    size_t capacity = MIN_CAPACITY;
+    while (swiss_max_load(capacity) < count)
+        capacity <<= 1;
+    return capacity;
+}
+
+
+/******************************************************************************/
+/************************** Engine Operations Implementations *****************/
+/******************************************************************************/
+
+static void * swiss_get(HashMap *map, uint64_t hash, const char *key, size_t len) {
+    SwissSlot *slot = swiss_find(map, hash, key, len);
+    return slot ? slot->value : NULL;
+}
+
+static void ** swiss_insert(HashMap *map, uint64_t hash, const char *key, size_t len, bool *inserted) {
+    SwissTable *table = map->engine_data;
+    SwissSlot *slot = swiss_find(map, hash, key, len);
+    if (slot) {
+        *inserted = false;
+        return &slot->value;
+    }
+
+    size_t pos = swiss_find_free(table, hash);
+    // Reusing a DELETED slot does not shorten any probe sequence, using an EMPTY one does
+    if (table->ctrl[pos] == CTRL_EMPTY && table->growth_left == 0) {
+        // Drop tombstones if they are a big part of the table, double it in other case
+        size_t capacity = map->count * 2 < swiss_max_load(table->capacity)
+            ? table->capacity : table->capacity * 2;
+        if (swiss_rehash(table, capacity) != CLIB_OK)
+            return NULL;
+        map->size = (int)table->capacity;
+        pos = swiss_find_free(table, hash);
+    }
+    // Key is allocated before the slot is claimed, so a failure leaves the table untouched
+    char *slot_key = key_arena_alloc(map, len + 1);
+    if (!slot_key)
+        return NULL;
+    if (table->ctrl[pos] == CTRL_EMPTY)
+        table->growth_left--;
+
+    slot = &table->slots[pos];
+    table->ctrl[pos] = swiss_tag(hash);
+    slot->hash = hash;
+    slot->key = slot_key;
+    memcpy(slot->key, key, len);
+    slot->key[len] = '\0';
+    slot->key_len = len;
+    slot->value = NULL;
+    map->count++;
+
+    *inserted = true;
+    return &slot->value;
+}
+
+static bool swiss_erase(HashMap *map, uint64_t hash, const char *key, size_t len, void **value) {
+    SwissTable *table = map->engine_data;
+    SwissSlot *slot = swiss_find(map, hash, key, len);
+    if (!slot)
+        return false;
+
+    size_t pos = (size_t)(slot - table->slots);
+    // If the group still has an EMPTY slot no probe sequence continues past it,
+    // so the slot can become EMPTY again instead of a tombstone
+    if (group_match_empty(table->ctrl + (pos & ~(size_t)(GROUP_WIDTH - 1)))) {
+        table->ctrl[pos] = CTRL_EMPTY;
+        table->growth_left++;
+    } else {
+        table->ctrl[pos] = CTRL_DELETED;
+    }
+    *value = slot->value;
+    // Key space goes back to the arena for the next keys of a similar length
+    key_arena_free(map, slot->key, slot->key_len + 1);
+    map->count--;
+    return true;
+}
+
+static int swiss_reserve(HashMap *map, unsigned int count) {
+    SwissTable *table = map->engine_data;
+    size_t capacity = swiss_capacity_for(count);
+    if (capacity <= table->capacity)
+        return CLIB_OK;
+    if (swiss_rehash(table, capacity) != CLIB_OK)
+        return CLIB_ERROR;
+    map->size = (int)table->capacity;
+    return CLIB_OK;
+}
+
+static void swiss_foreach(HashMap *map, EntryVisitor visit, void *ctx) {
+    SwissTable *table = map->engine_data;
+    for (size_t group = 0; group < table->capacity; group += GROUP_WIDTH) {
+        uint32_t mask = ~group_match_free(table->ctrl + group) & 0xFFFF;
+        while (mask) {
+            SwissSlot *slot = &table->slots[group + (size_t)lowest_bit(mask)];
+            (*visit)(slot->key, slot->key_len, slot->value, ctx);
+            mask &= mask - 1;
+        }
+    }
+}
+
+static bool swiss_iter_next(HashMap *map, HashMapIter *it) {
+    SwissTable *table = map->engine_data;
+    while (it->position < table->capacity) {
+        size_t group = it->position & ~(size_t)(GROUP_WIDTH - 1);
+        // Full slots of the group not visited yet
+        uint32_t mask = ~group_match_free(table->ctrl + group) & (0xFFFFu << (it->position - group)) & 0xFFFF;
+        if (mask) {
+            SwissSlot *slot = &table->slots[group + (size_t)lowest_bit(mask)];
+            it->position = group + (size_t)lowest_bit(mask) + 1;
+            it->key = slot->key;
+            it->key_len = slot->key_len;
+            it->value = slot->value;
+            return true;
+        }
+        it->position = group + GROUP_WIDTH;
+    }
+    return false;
+}
+
+static void swiss_stats(HashMap *map, HashMapStats *stats) {
+    SwissTable *table = map->engine_data;
+    size_t group_mask = table->capacity / GROUP_WIDTH - 1;
+    for (size_t pos = 0; pos < table->capacity; pos++) {
+        // EMPTY and DELETED tags have the high bit set
+        if (table->ctrl[pos] & 0x80)
+            continue;
+        // Follow the probe sequence of the key until the group holding it
+        size_t group = (size_t)table->slots[pos].hash & group_mask;
+        unsigned int distance = 0;
+        for (size_t probe = 1; group != pos / GROUP_WIDTH; ++probe, ++distance)
+            group = (group + probe) & group_mask;
+        stats->chain_histogram[distance < HASH_MAP_STATS_HISTOGRAM ? distance : HASH_MAP_STATS_HISTOGRAM - 1]++;
+        if (distance + 1 > stats->max_chain)
+            stats->max_chain = distance + 1;
+    }
+}
+
+static void swiss_prefetch(HashMap *map, uint64_t hash, int stage) {
+    SwissTable *table = map->engine_data;
+    size_t group = (size_t)hash & (table->capacity / GROUP_WIDTH - 1);
+    const uint8_t *ctrl = table->ctrl + group * GROUP_WIDTH;
+    if (stage == 0) {
+        HASH_MAP_PREFETCH(ctrl);
+        return;
+    }
+    // Later stages follow the first tag match, the usual case on hits
+    uint32_t mask = group_match(ctrl, swiss_tag(hash));
+    if (!mask)
+        return;
+    SwissSlot *slot = &table->slots[group * GROUP_WIDTH + (size_t)lowest_bit(mask)];
+    if (stage == 1)
+        HASH_MAP_PREFETCH(slot);
+    else
+        HASH_MAP_PREFETCH(slot->key);
+}
+
+static void swiss_destroy(HashMap *map) {
+    SwissTable *table = map->engine_data;
+    free(table->ctrl);
+    free(table->slots);
+    FREE_TO_NULL(map->engine_data);
+}
+
+const HashMapOps SWISS_MAP_OPS = {
+    .get = swiss_get,
+    .insert = swiss_insert,
+    .erase = swiss_erase,
+    .reserve = swiss_reserve,
+    .foreach = swiss_foreach,
+    .iter_next = swiss_iter_next,
+    .prefetch = swiss_prefetch,
+    .stats = swiss_stats,
+    .destroy = swiss_destroy,
+};
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// swiss_map_init
+// ****************************************************************************************
+/**
+ *  Initialice swiss engine state of #map for at least #size pairs
+ * @param[in]    map   Hash Map whose engine is #HASH_MAP_SWISS
+ * @param[in]    size  Initial number of pairs
+ * @return       CLIB_OK    if engine is initialiced \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+int swiss_map_init(HashMap *map, int size) {
+    SwissTable *table = malloc(sizeof(SwissTable));
+    if (!table || swiss_alloc(table, swiss_capacity_for(size > 0 ? (size_t)size : 1)) != CLIB_OK) {
+        free(table);
+        return CLIB_ERROR;
+    }
+    map->engine_data = table;
+    map->size = (int)table->capacity;
+    return CLIB_OK;
+}
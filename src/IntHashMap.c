@@ -0,0 +1,350 @@
+// ****************************************************************************************
+/**
+ * @file   IntHashMap.c
+ * @brief  Implementation of a hash map with 64 bit integer keys on C
+ *
+ * @details Open addressing table with linear probing and backward shift deletion.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+
+
+//=======================================================================================//
+//                                                                                       //
+//                              Integer Hash Map API                                     //
+//                                                                                       //
+//=======================================================================================//
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+/// Smallest number of slots of an Integer Hash Map
+#define INT_MAP_MIN_SIZE                (8)
+
+
+// ****************************************************************************************
+// int_slot
+// ****************************************************************************************
+/*  Private function to calculate the home slot of #key (murmur3 finalizer of seeded key)
+ * @param[in]    map        Integer Hash Map of the key
+ * @param[in]    key        Key to place
+ */
+// ****************************************************************************************
+static inline int int_slot(IntHashMap *map, uint64_t key) {
+    key ^= map->seed;
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return (int)(key & (uint64_t)(map->size - 1));
+}
+
+
+// ****************************************************************************************
+// int_find
+// ****************************************************************************************
+/*  Private function to find the slot of #key, or the empty slot ending its probe sequence
+ * @param[in]    map        Integer Hash Map to search (#key must not be 0)
+ * @param[in]    key        Key to find
+ */
+// ****************************************************************************************
+static inline IntMapSlot * int_find(IntHashMap *map, uint64_t key) {
+    int mask = map->size - 1;
+    int pos = int_slot(map, key);
+    while (map->slots[pos].key != key && map->slots[pos].key != 0)
+        pos = (pos + 1) & mask;
+    return &map->slots[pos];
+}
+
+
+// ****************************************************************************************
+// int_resize
+// ****************************************************************************************
+/*  Private function to move every pair of #map into a table of #size slots
+ * @param[in]    map        Integer Hash Map to resize
+ * @param[in]    size       New number of slots (power of two)
+ * @return       CLIB_OK    if new table is allocated \n
+ *               CLIB_ERROR in other case
+ */
+// ****************************************************************************************
+static int int_resize(IntHashMap *map, int size) {
+    IntMapSlot *slots = calloc((size_t)size, sizeof(IntMapSlot));
+    if (!slots)
+        return CLIB_ERROR;
+
+    IntMapSlot *old_slots = map->slots;
+    int old_size = map->size;
+    map->slots = slots;
+    map->size = size;
+    for (int i = 0; i < old_size; i++) {
+        if (old_slots[i].key != 0)
+            *int_find(map, old_slots[i].key) = old_slots[i];
+    }
+    free(old_slots);
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// int_capacity
+// ****************************************************************************************
+/*  Private function to obtain the number of slots needed to hold #count pairs at 3/4 load
+ * @param[in]    count      Number of pairs
+ */
+// ****************************************************************************************
+static int int_capacity(unsigned long count) {
+    unsigned long needed = count + count / 3 + 1;
+    int size = INT_MAP_MIN_SIZE;
+    while ((unsigned long)size < needed && size < (1 << 30))
+        size <<= 1;
+    return size;
+}
+
+
+// ****************************************************************************************
+// int_erase
+// ****************************************************************************************
+/*  Private function to remove #key from #map, shifting back the pairs probed after it
+ * @param[in]    map        Integer Hash Map to remove pair
+ * @param[in]    key        Key to remove
+ * @param[out]   value      Value of removed pair
+ * @return       true if #key existed
+ */
+// ****************************************************************************************
+static bool int_erase(IntHashMap *map, uint64_t key, void **value) {
+    if (key == 0) {
+        if (!map->has_zero)
+            return false;
+        *value = map->zero_value;
+        map->has_zero = false;
+        map->zero_value = NULL;
+        map->count--;
+        return true;
+    }
+
+    IntMapSlot *slot = int_find(map, key);
+    if (slot->key == 0)
+        return false;
+    *value = slot->value;
+    map->count--;
+
+    // Move back every following pair whose home slot is not between the hole and itself
+    int mask = map->size - 1;
+    int hole = (int)(slot - map->slots);
+    int pos = hole;
+    for (;;) {
+        pos = (pos + 1) & mask;
+        if (map->slots[pos].key == 0)
+            break;
+        int home = int_slot(map, map->slots[pos].key);
+        if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+            map->slots[hole] = map->slots[pos];
+            hole = pos;
+        }
+    }
+    map->slots[hole].key = 0;
+    map->slots[hole].value = NULL;
+    return true;
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// create_int_hash_map
+// ****************************************************************************************
+/**
+ *  Initialice a Hash Map whose keys are 64 bit integers
+ * @param[in]    size  Initial number of pairs the map holds without growing
+ * @param[out]   none
+ * @return       Pointer to a valid Integer Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Pairs live on a flat slot array probed linearly, so neither keys nor
+ *               nodes are allocated and a lookup usually reads a single cache line.
+ *               Removed pairs are not left as tombstones: following pairs of the probe
+ *               sequence are shifted back instead. The table doubles at 3/4 load.
+ */
+// ****************************************************************************************
+IntHashMap * create_int_hash_map(int size) {
+    IntHashMap *map = malloc(sizeof(IntHashMap));
+    if (!map)
+        return NULL;
+    map->size = int_capacity(size > 0 ? (unsigned long)size : 0);
+    map->slots = calloc((size_t)map->size, sizeof(IntMapSlot));
+    if (!map->slots) {
+        free(map);
+        return NULL;
+    }
+    map->count = 0;
+    map->has_zero = false;
+    map->zero_value = NULL;
+    map->seed = hash_map_new_seed(map);
+    return map;
+}
+
+
+// ****************************************************************************************
+// int_hash_map_set
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key. If key already exist, update its value
+ * @param[in]    map        Integer Hash Map to be set
+ * @param[in]    key        Key of pair key-value
+ * @param[in]    value      Value of pair key-value
+ * @return       Pointer to previous value if #key already exists, or NULL in other case
+ */
+// ****************************************************************************************
+void * int_hash_map_set(IntHashMap *map, uint64_t key, void *value) {
+    void *prev_value = NULL;
+    if (key == 0) {
+        if (map->has_zero)
+            prev_value = map->zero_value;
+        else
+            map->count++;
+        map->has_zero = true;
+        map->zero_value = value;
+        return prev_value;
+    }
+
+    IntMapSlot *slot = int_find(map, key);
+    if (slot->key == key) {
+        prev_value = slot->value;
+        slot->value = value;
+        return prev_value;
+    }
+
+    // Grow before filling past 3/4 of the slots, probe sequences get long after that
+    unsigned int used = map->count - (map->has_zero ? 1u : 0u);
+    if ((unsigned long)(used + 1) * 4 > (unsigned long)map->size * 3) {
+        if (int_resize(map, map->size * 2) != CLIB_OK)
+            return NULL;
+        slot = int_find(map, key);
+    }
+    slot->key = key;
+    slot->value = value;
+    map->count++;
+    return NULL;
+}
+
+
+// ****************************************************************************************
+// int_hash_map_get
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key
+ * @param[in]    map        Integer Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ */
+// ****************************************************************************************
+void * int_hash_map_get(IntHashMap *map, uint64_t key) {
+    if (key == 0)
+        return map->zero_value;
+    IntMapSlot *slot = int_find(map, key);
+    return slot->value;
+}
+
+
+// ****************************************************************************************
+// int_hash_map_remove
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key
+ * @param[in]    map        Integer Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @param[in]    free_value Function to free value (NULL if value must not be freed)
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ */
+// ****************************************************************************************
+int int_hash_map_remove(IntHashMap *map, uint64_t key, void (*free_value)(void *)) {
+    void *value;
+    if (!int_erase(map, key, &value))
+        return CLIB_ERROR;
+    if (free_value)
+        (*free_value)(value);
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// int_hash_map_pop
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key and return value
+ * @param[in]    map        Integer Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @return       Value of removed pair, or NULL if #key does not exist
+ */
+// ****************************************************************************************
+void * int_hash_map_pop(IntHashMap *map, uint64_t key) {
+    void *value;
+    if (!int_erase(map, key, &value))
+        return NULL;
+    return value;
+}
+
+
+// ****************************************************************************************
+// int_hash_map_reserve
+// ****************************************************************************************
+/**
+ *  Grow #map table so it can hold #count pairs without growing again
+ * @param[in]    map        Integer Hash Map to grow
+ * @param[in]    count      Number of pairs expected on the map
+ * @param[out]   none
+ * @return       CLIB_OK    if table is big enough \n
+ *               CLIB_ERROR if table can not be allocated
+ */
+// ****************************************************************************************
+int int_hash_map_reserve(IntHashMap *map, unsigned int count) {
+    int size = int_capacity(count);
+    if (size <= map->size)
+        return CLIB_OK;
+    return int_resize(map, size);
+}
+
+
+// ****************************************************************************************
+// int_hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every value given #free_value
+ * @param[in]    map         Integer Hash Map to be destroyed
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void int_hash_map_destroy(IntHashMap *map, void (*free_value)(void *)) {
+    if (free_value) {
+        for (int i = 0; i < map->size; i++) {
+            if (map->slots[i].key != 0)
+                (*free_value)(map->slots[i].value);
+        }
+        if (map->has_zero)
+            (*free_value)(map->zero_value);
+    }
+    free(map->slots);
+    free(map);
+}
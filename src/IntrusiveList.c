@@ -0,0 +1,246 @@
+// ****************************************************************************************
+/**
+ * @file   IntrusiveList.c
+ * @brief  Intrusive List: doubly linked list of links embedded on the caller objects
+ *
+ * @details The list is circular around a sentinel link inside the list structure, so
+ *          every insertion and removal relinks two neighbours without checking for list
+ *          ends, and nothing is ever allocated.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+/// Link #link between #prev and #next, which are neighbours
+static inline void link_between(ListLink *link, ListLink *prev, ListLink *next) {
+    link->prev = prev;
+    link->next = next;
+    prev->next = link;
+    next->prev = link;
+}
+
+/// Unlink #link from its neighbours, clearing it so a stale use fails fast
+static inline void link_unlink(ListLink *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = NULL;
+    link->next = NULL;
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// intrusive_list_init
+// ****************************************************************************************
+/**
+ *  Initialice intrusive list on caller owned storage
+ * @param[in]    list  Intrusive list to initialice
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void intrusive_list_init(IntrusiveList *list) {
+    list->root.prev = &list->root;
+    list->root.next = &list->root;
+    list->size = 0;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_push_front
+// ****************************************************************************************
+/**
+ *  Link #link on the first position of #list
+ * @param[in]    list  Intrusive list to insert #link
+ * @param[in]    link  Link of the object to insert (not on any list)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void intrusive_list_push_front(IntrusiveList *list, ListLink *link) {
+    link_between(link, &list->root, list->root.next);
+    list->size++;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_push_back
+// ****************************************************************************************
+/**
+ *  Link #link on the last position of #list
+ * @param[in]    list  Intrusive list to insert #link
+ * @param[in]    link  Link of the object to insert (not on any list)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void intrusive_list_push_back(IntrusiveList *list, ListLink *link) {
+    link_between(link, list->root.prev, &list->root);
+    list->size++;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_pop_front
+// ****************************************************************************************
+/**
+ *  Unlink the first link of #list, returning it
+ * @param[in]    list  Intrusive list to pop first link
+ * @param[out]   none
+ * @return       First link of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_pop_front(IntrusiveList *list) {
+    ListLink *link = list->root.next;
+    if (link == &list->root)
+        return NULL;
+    link_unlink(link);
+    list->size--;
+    return link;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_pop_back
+// ****************************************************************************************
+/**
+ *  Unlink the last link of #list, returning it
+ * @param[in]    list  Intrusive list to pop last link
+ * @param[out]   none
+ * @return       Last link of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_pop_back(IntrusiveList *list) {
+    ListLink *link = list->root.prev;
+    if (link == &list->root)
+        return NULL;
+    link_unlink(link);
+    list->size--;
+    return link;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_remove
+// ****************************************************************************************
+/**
+ *  Unlink #link from #list
+ * @param[in]    list  Intrusive list owning #link
+ * @param[in]    link  Link to remove
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void intrusive_list_remove(IntrusiveList *list, ListLink *link) {
+    link_unlink(link);
+    list->size--;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_get_first
+// ****************************************************************************************
+/**
+ *  Get the first link of #list without unlinking it
+ * @param[in]    list  Intrusive list to get first link
+ * @param[out]   none
+ * @return       First link of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_get_first(IntrusiveList *list) {
+    return list->root.next == &list->root ? NULL : list->root.next;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_get_last
+// ****************************************************************************************
+/**
+ *  Get the last link of #list without unlinking it
+ * @param[in]    list  Intrusive list to get last link
+ * @param[out]   none
+ * @return       Last link of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_get_last(IntrusiveList *list) {
+    return list->root.prev == &list->root ? NULL : list->root.prev;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_next
+// ****************************************************************************************
+/**
+ *  Get the link following #link on #list
+ * @param[in]    list  Intrusive list owning #link
+ * @param[in]    link  Current link
+ * @param[out]   none
+ * @return       Next link (NULL if #link is the last one)
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_next(IntrusiveList *list, ListLink *link) {
+    return link->next == &list->root ? NULL : link->next;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_prev
+// ****************************************************************************************
+/**
+ *  Get the link preceding #link on #list
+ * @param[in]    list  Intrusive list owning #link
+ * @param[in]    link  Current link
+ * @param[out]   none
+ * @return       Previous link (NULL if #link is the first one)
+ */
+// ****************************************************************************************
+ListLink * intrusive_list_prev(IntrusiveList *list, ListLink *link) {
+    return link->prev == &list->root ? NULL : link->prev;
+}
+
+
+// ****************************************************************************************
+// intrusive_list_get_size
+// ****************************************************************************************
+/**
+ *  Get the list current size
+ * @param[in]    list  Intrusive list to obtain current size
+ * @param[out]   none
+ * @return       Size of list
+ */
+// ****************************************************************************************
+unsigned int intrusive_list_get_size(IntrusiveList *list) { return list->size; }
+
+
+// ****************************************************************************************
+// intrusive_list_is_empty
+// ****************************************************************************************
+/**
+ *  Check if #list is empty
+ * @param[in]    list  Intrusive list to check if is empty
+ * @param[out]   none
+ * @return       List empty
+ */
+// ****************************************************************************************
+bool intrusive_list_is_empty(IntrusiveList *list) { return list->size == 0; }
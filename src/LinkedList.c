@@ -67,13 +67,13 @@ ContentComparator COMPARE_STRING = compareStrings;
 /******************************************************************************/
 
 // ****************************************************************************************
-// create_linked_list
+// list_init
 // ****************************************************************************************
 /**
- *  Initialice linked list
- * @param[in]    none
+ *  Initialice linked list on caller owned storage
+ * @param[in]    list  Linked list to initialice
  * @param[out]   none
- * @return       valid pointer to linked list structure
+ * @return       none
  *
  * @details
  *
@@ -87,20 +87,37 @@ ContentComparator COMPARE_STRING = compareStrings;
  *                 ----------           ----------
  */
 // ****************************************************************************************
-LinkedList *create_linked_list(void) {
-
-    LinkedList *l = malloc(sizeof(LinkedList));
+void list_init(LinkedList *l) {
     l->size = 0;
-    l->head = malloc(sizeof(ListNode));
-    l->tail = malloc(sizeof(ListNode));
-    l->head->next = NULL;
-    l->head->prev = l->tail;
-    l->tail->next = l->head;
-    l->tail->prev = NULL;
+    l->finger = NULL;
+    l->finger_index = 0;
+    l->head.next = NULL;
+    l->head.prev = &l->tail;
+    l->tail.next = &l->head;
+    l->tail.prev = NULL;
     // Needed to return NULL when list is empty
-    l->head->content = NULL;
-    l->tail->content = NULL;
+    l->head.content = NULL;
+    l->tail.content = NULL;
+}
+
 
+// ****************************************************************************************
+// create_linked_list
+// ****************************************************************************************
+/**
+ *  Initialice linked list
+ * @param[in]    none
+ * @param[out]   none
+ * @return       valid pointer to linked list structure, NULL if it can not be allocated
+ *
+ * @details      Sentinels are part of the list structure, so this is the only allocation
+ *               made until the first value is inserted.
+ */
+// ****************************************************************************************
+LinkedList *create_linked_list(void) {
+    LinkedList *l = malloc(sizeof(LinkedList));
+    if (l)
+        list_init(l);
     return l;
 }
 
@@ -139,11 +156,13 @@ void list_push_front(LinkedList *list, void *value) {
     ListNode *add = malloc(sizeof(ListNode));
     add->content = value;
 
-    list->head->prev->next = add;
-    add->prev = list->head->prev;
-    add->next = list->head;
-    list->head->prev = add;
+    list->head.prev->next = add;
+    add->prev = list->head.prev;
+    add->next = &list->head;
+    list->head.prev = add;
     list->size++;
+    // Every node moves one position further from the first
+    list->finger_index++;
 }
 
 // ****************************************************************************************
@@ -180,10 +199,10 @@ void list_push_back(LinkedList *l, void *value) {
     ListNode *add = malloc(sizeof(ListNode));
     add->content = value;
 
-    l->tail->next->prev = add; // Last element in queue set prev to new element
-    add->next = l->tail->next; // New element next set to last element in queue
-    add->prev = l->tail;       // Set prev add element to queue tail
-    l->tail->next = add;       // Set tail element to new element
+    l->tail.next->prev = add; // Last element in queue set prev to new element
+    add->next = l->tail.next; // New element next set to last element in queue
+    add->prev = &l->tail;       // Set prev add element to queue tail
+    l->tail.next = add;       // Set tail element to new element
     l->size++;
 }
 
@@ -218,12 +237,15 @@ void list_push_back(LinkedList *l, void *value) {
 // ****************************************************************************************
 void * list_pop_front(LinkedList *list) {
     if (list->size) {
-        ListNode *head = list->head->prev; // Get returning node
+        ListNode *head = list->head.prev; // Get returning node
 
-        list->head->prev =
+        list->head.prev =
             head->prev; // Set new head to previous element of the beginning
-        head->prev->next = list->head; // Set new head element next to head node
+        head->prev->next = &list->head; // Set new head element next to head node
         void *content = head->content;
+        if (list->finger == head)
+            list->finger = NULL;
+        list->finger_index--;
         free(head);
         list->size--;
         return content; // Remember to free content after use!!!
@@ -261,11 +283,13 @@ void * list_pop_front(LinkedList *list) {
 // ****************************************************************************************
 void * list_pop_back(LinkedList *list) {
     if (list->size) {
-        ListNode *lastNode = list->tail->next; // Get returning node
+        ListNode *lastNode = list->tail.next; // Get returning node
 
-        list->tail->next = lastNode->next; // Set new tail to next element of the last node
-        lastNode->next->prev = list->tail;
+        list->tail.next = lastNode->next; // Set new tail to next element of the last node
+        lastNode->next->prev = &list->tail;
         void *content = lastNode->content;
+        if (list->finger == lastNode)
+            list->finger = NULL;
         free(lastNode);
         list->size--;
         return content; // Remember to free content after use!!!
@@ -283,7 +307,7 @@ void * list_pop_back(LinkedList *list) {
  * @return       Pointer to data stored on the first position of #list (NULL if list is empty)
  */
 // ****************************************************************************************
-void * list_get_first(LinkedList *list) { return list->head->prev->content; }
+void * list_get_first(LinkedList *list) { return list->head.prev->content; }
 
 // ****************************************************************************************
 // list_get_last
@@ -295,7 +319,7 @@ void * list_get_first(LinkedList *list) { return list->head->prev->content; }
  * @return       Pointer to data stored on the last position of #list (NULL if list is empty)
  */
 // ****************************************************************************************
-void * list_get_last(LinkedList *list) { return list->tail->next->content; }
+void * list_get_last(LinkedList *list) { return list->tail.next->content; }
 
 // ****************************************************************************************
 // list_get_size
@@ -335,22 +359,34 @@ inline bool list_is_empty(LinkedList *list) { return list->size == 0; }
 // ****************************************************************************************
 void * list_get_element(LinkedList *list, unsigned int position) {
     unsigned int size = list->size;
-    ListNode *node;
+    ListNode *node = list->head.prev;
+    unsigned int index = 0;
+    unsigned int distance = position;
 
     if (position >= size)
         return NULL;    // Maybe return error
 
-    if (position < size / 2){
-        node = list->head->prev;
-        while (position--)
-        /*for (int i = 0; i <= position; ++i)*/
-            node = node->prev;
-    } else {
-        node = list->tail->next;
-        for (unsigned int i = size - 1; i > position; --i)
-            node = node->next;
+    // Start from the nearest of first node, last node and finger
+    if (size - 1 - position < distance){
+        node = list->tail.next;
+        index = size - 1;
+        distance = size - 1 - position;
+    }
+    if (list->finger){
+        unsigned int finger_distance = position > list->finger_index ?
+                                       position - list->finger_index : list->finger_index - position;
+        if (finger_distance < distance){
+            node = list->finger;
+            index = list->finger_index;
+        }
     }
+    for (; index < position; ++index)
+        node = node->prev;
+    for (; index > position; --index)
+        node = node->next;
 
+    list->finger = node;
+    list->finger_index = position;
     return node->content;
 }
 
@@ -368,7 +404,7 @@ void * list_get_element(LinkedList *list, unsigned int position) {
  */
 // ****************************************************************************************
 ListNode * list_find_node(LinkedList *list, void * pattern, ContentComparator comparator) {
-    ListNode *node = list->head->prev;
+    ListNode *node = list->head.prev;
     for (unsigned int i = 0; i < list->size; ++i){
         if (comparator(pattern, node->content) == 0){
             return node;
@@ -418,6 +454,8 @@ void list_append_before(LinkedList *list, ListNode *node, void * value) {
     newNode->prev = node;
     node->next = newNode;
     next_old->prev = newNode;
+    list->size++;
+    list->finger = NULL;
 }
 
 
@@ -459,6 +497,8 @@ void list_append_after(LinkedList *list, ListNode *node, void * value) {
     newNode->prev = prev_old;
     node->prev = newNode;
     prev_old->next = newNode;
+    list->size++;
+    list->finger = NULL;
 }
 
 
@@ -474,7 +514,7 @@ void list_append_after(LinkedList *list, ListNode *node, void * value) {
  */
 // ****************************************************************************************
 void list_print(LinkedList *list, void (*print_func)(void *)) {
-    ListNode *node = list->head->prev;
+    ListNode *node = list->head.prev;
     for (unsigned int i = 0; i < list->size; i++) {
         print_func(node->content);
         node = node->prev;
@@ -482,9 +522,169 @@ void list_print(LinkedList *list, void (*print_func)(void *)) {
 }
 
 
-// TODO comment out FREE_TO_NULL not working
-void list_destroy(LinkedList *list){
-    ListNode *current = list->head->prev;
+// ****************************************************************************************
+// list_remove_node
+// ****************************************************************************************
+/**
+ *  Unlink #node from #list and free it, returning its content
+ * @param[in]    list  Linked list owning #node
+ * @param[in]    node  Node to remove (not the head or tail sentinels)
+ * @param[out]   none
+ * @return       Pointer to data stored on #node
+ *
+ * @details      Constant time: neighbours of #node are relinked, no search is done.
+ */
+// ****************************************************************************************
+void * list_remove_node(LinkedList *list, ListNode *node) {
+    node->next->prev = node->prev;
+    node->prev->next = node->next;
+    void *content = node->content;
+    free(node);
+    list->size--;
+    list->finger = NULL;
+    return content;
+}
+
+
+// ****************************************************************************************
+// list_move_front
+// ****************************************************************************************
+/**
+ *  Move #node to the first position of #list
+ * @param[in]    list  Linked list owning #node
+ * @param[in]    node  Node to move (not the head or tail sentinels)
+ * @param[out]   none
+ * @return       none
+ *
+ * @details      Constant time, #node is relinked instead of freed and allocated again, so
+ *               pointers to it stay valid.
+ */
+// ****************************************************************************************
+void list_move_front(LinkedList *list, ListNode *node) {
+    if (list->head.prev == node)
+        return;
+    node->next->prev = node->prev;
+    node->prev->next = node->next;
+
+    list->head.prev->next = node;
+    node->prev = list->head.prev;
+    node->next = &list->head;
+    list->head.prev = node;
+    list->finger = NULL;
+}
+
+
+// ****************************************************************************************
+// list_iter_begin
+// ****************************************************************************************
+/**
+ *  Place #it before the first node of #list
+ * @param[in]    list       Linked list to iterate
+ * @param[out]   it         Iterator to initialice
+ * @return       none
+ */
+// ****************************************************************************************
+void list_iter_begin(LinkedList *list, ListIterator *it) {
+    it->list = list;
+    it->node = &list->head;
+    it->value = NULL;
+    it->removed = false;
+}
+
+
+// ****************************************************************************************
+// list_iter_end
+// ****************************************************************************************
+/**
+ *  Place #it after the last node of #list
+ * @param[in]    list       Linked list to iterate
+ * @param[out]   it         Iterator to initialice
+ * @return       none
+ */
+// ****************************************************************************************
+void list_iter_end(LinkedList *list, ListIterator *it) {
+    it->list = list;
+    it->node = &list->tail;
+    it->value = NULL;
+    it->removed = false;
+}
+
+
+// ****************************************************************************************
+// list_iter_next
+// ****************************************************************************************
+/**
+ *  Move #it to the next node of its list
+ * @param[in]    it         Iterator initialiced by #list_iter_begin or #list_iter_end
+ * @return       true if #it points to a node, false if #it went past the last node
+ */
+// ****************************************************************************************
+bool list_iter_next(ListIterator *it) {
+    // Nodes follow each other on #prev, towards the tail sentinel
+    it->removed = false;
+    if (it->node != &it->list->tail)
+        it->node = it->node->prev;
+    it->value = it->node->content;
+    return it->node != &it->list->tail;
+}
+
+
+// ****************************************************************************************
+// list_iter_prev
+// ****************************************************************************************
+/**
+ *  Move #it to the previous node of its list
+ * @param[in]    it         Iterator initialiced by #list_iter_begin or #list_iter_end
+ * @return       true if #it points to a node, false if #it went past the first node
+ */
+// ****************************************************************************************
+bool list_iter_prev(ListIterator *it) {
+    // After a removal #it already sits after the node preceding the removed one
+    if (it->removed)
+        it->removed = false;
+    else if (it->node != &it->list->head)
+        it->node = it->node->next;
+    it->value = it->node->content;
+    return it->node != &it->list->head;
+}
+
+
+// ****************************************************************************************
+// list_iter_remove
+// ****************************************************************************************
+/**
+ *  Remove the current node of #it from its list, leaving #it between its neighbours
+ * @param[in]    it         Iterator pointing to a node
+ * @return       Pointer to data stored on the removed node (NULL if #it points to none)
+ */
+// ****************************************************************************************
+void * list_iter_remove(ListIterator *it) {
+    ListNode *node = it->node;
+    if (it->removed || node == &it->list->head || node == &it->list->tail)
+        return NULL;
+    // Preceding node becomes current, flagged so a backward step does not skip it
+    it->node = node->next;
+    it->value = NULL;
+    it->removed = true;
+    return list_remove_node(it->list, node);
+}
+
+
+// ****************************************************************************************
+// list_clear
+// ****************************************************************************************
+/**
+ *  Free every node of #list, leaving it empty
+ * @param[in]    list  Linked list to be cleared
+ * @param[out]   none
+ * @return       none
+ *
+ * @details      Contents are not freed. Lists initialiced by #list_init must be cleared
+ *               before their storage goes away.
+ */
+// ****************************************************************************************
+void list_clear(LinkedList *list){
+    ListNode *current = list->head.prev;
     ListNode *previous;
     for (unsigned int i = 0; i < list->size; i++) {
         previous = current;
@@ -492,8 +692,12 @@ void list_destroy(LinkedList *list){
         /*free(previous->content);*/
         free(previous);
     }
+    list_init(list);
+}
 
-    free(list->head);
-    free(list->tail);
+
+// TODO comment out FREE_TO_NULL not working
+void list_destroy(LinkedList *list){
+    list_clear(list);
     free(list);
 }
@@ -0,0 +1,504 @@
+// ****************************************************************************************
+/**
+ * @file   RcuHashMap.c
+ * @brief  Implementation of a read mostly hash map with lock free readers on C
+ *
+ * @details Chains of Hash Map nodes read with atomic loads only. Writers publish changes
+ *          with atomic pointer stores and free removed memory after a grace period
+ *          (quiescent state based reclamation).
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+#include "HashMapEngine.h"
+#include <sched.h>
+
+
+//=======================================================================================//
+//                                                                                       //
+//                                RCU Hash Map API                                       //
+//                                                                                       //
+//=======================================================================================//
+
+/// Table of a RCU Hash Map, immutable once published except for its chain links
+struct rcu_table{
+    int size;                   //< Number of table entries (always a power of two)
+    MapNode **list;             //< Table of list nodes
+};
+
+/// Memory waiting for every reader to pass a quiescent state
+struct rcu_retired{
+    struct rcu_retired *next;   //< Next (older) retired memory
+    uint64_t epoch;             //< Map epoch right after retirement
+    void *ptr;                  //< Memory to free
+    void (*free_func)(void *);  //< Function freeing #ptr
+};
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+static void rcu_free_node(void *ptr) {
+    MapNode *node = ptr;
+    if (node->key != node->key_data)
+        free(node->key);
+    free(node);
+}
+
+static void rcu_free_table(void *ptr) {
+    struct rcu_table *table = ptr;
+    MapNode *tmp, *next;
+    for (int i = 0; i < table->size; i++) {
+        tmp = table->list[i];
+        while (tmp) {
+            next = tmp->next;
+            rcu_free_node(tmp);
+            tmp = next;
+        }
+    }
+    free(table->list);
+    free(table);
+}
+
+
+// ****************************************************************************************
+// rcu_create_table
+// ****************************************************************************************
+/*  Private function to allocate an empty table of #size entries
+ * @param[in]    size       Number of entries (power of two)
+ */
+// ****************************************************************************************
+static struct rcu_table * rcu_create_table(int size) {
+    struct rcu_table *table = malloc(sizeof(struct rcu_table));
+    if (!table)
+        return NULL;
+    table->size = size;
+    table->list = calloc((size_t)size, sizeof(MapNode *));
+    if (!table->list) {
+        free(table);
+        return NULL;
+    }
+    return table;
+}
+
+
+// ****************************************************************************************
+// rcu_create_node
+// ****************************************************************************************
+/*  Private function to allocate a node owning a copy of #key
+ * @param[in]    hash       Full hash of #key
+ * @param[in]    key        Key of the node
+ * @param[in]    len        Length of #key
+ * @param[in]    value      Value of the node
+ */
+// ****************************************************************************************
+static MapNode * rcu_create_node(uint64_t hash, const char *key, size_t len, void *value) {
+    MapNode *node = malloc(sizeof(MapNode));
+    if (!node)
+        return NULL;
+    node->key = len < MAP_NODE_INLINE_KEY ? node->key_data : malloc(len + 1);
+    if (!node->key) {
+        free(node);
+        return NULL;
+    }
+    memcpy(node->key, key, len);
+    node->key[len] = '\0';
+    node->key_len = (uint32_t)len;
+    node->hash = hash;
+    node->value = value;
+    node->next = NULL;
+    return node;
+}
+
+
+// ****************************************************************************************
+// rcu_retire
+// ****************************************************************************************
+/*  Private function to free #ptr once no reader can reference it (write lock held)
+ * @param[in]    map        RCU Hash Map which unpublished #ptr
+ * @param[in]    ptr        Memory no longer reachable from #map
+ * @param[in]    free_func  Function freeing #ptr
+ *
+ * @details      Epoch is increased after #ptr is unpublished, so a reader announcing this
+ *               epoch or a later one can not hold #ptr anymore.
+ */
+// ****************************************************************************************
+static void rcu_retire(RcuHashMap *map, void *ptr, void (*free_func)(void *)) {
+    struct rcu_retired *retired = malloc(sizeof(struct rcu_retired));
+    uint64_t epoch = __atomic_add_fetch(&map->epoch, 1, __ATOMIC_SEQ_CST);
+    if (!retired) {
+        // Without memory to remember it, wait for the grace period right now
+        for (RcuReader *reader = map->readers; reader; reader = reader->next) {
+            while (__atomic_load_n(&reader->seen_epoch, __ATOMIC_ACQUIRE) < epoch)
+                sched_yield();
+        }
+        (*free_func)(ptr);
+        return;
+    }
+    retired->ptr = ptr;
+    retired->free_func = free_func;
+    retired->epoch = epoch;
+    retired->next = map->retired;
+    map->retired = retired;
+}
+
+
+// ****************************************************************************************
+// rcu_reclaim
+// ****************************************************************************************
+/*  Private function to free every retired memory whose grace period ended (write lock held)
+ * @param[in]    map        RCU Hash Map
+ */
+// ****************************************************************************************
+static void rcu_reclaim(RcuHashMap *map) {
+    uint64_t safe_epoch = __atomic_load_n(&map->epoch, __ATOMIC_SEQ_CST);
+    for (RcuReader *reader = map->readers; reader; reader = reader->next) {
+        uint64_t seen = __atomic_load_n(&reader->seen_epoch, __ATOMIC_ACQUIRE);
+        if (seen < safe_epoch)
+            safe_epoch = seen;
+    }
+
+    struct rcu_retired **link = &map->retired;
+    while (*link) {
+        struct rcu_retired *retired = *link;
+        if (retired->epoch <= safe_epoch) {
+            *link = retired->next;
+            (*retired->free_func)(retired->ptr);
+            free(retired);
+        } else {
+            link = &retired->next;
+        }
+    }
+}
+
+
+// ****************************************************************************************
+// rcu_resize
+// ****************************************************************************************
+/*  Private function to publish a table of #size entries with a copy of every node (write
+ *  lock held). Readers on the old table keep reading it until their next quiescent state.
+ * @param[in]    map        RCU Hash Map to resize
+ * @param[in]    size       New number of entries (power of two)
+ */
+// ****************************************************************************************
+static void rcu_resize(RcuHashMap *map, int size) {
+    struct rcu_table *old_table = map->table;
+    struct rcu_table *table = rcu_create_table(size);
+    if (!table)
+        return;
+
+    for (int i = 0; i < old_table->size; i++) {
+        for (MapNode *node = old_table->list[i]; node; node = node->next) {
+            MapNode *copy = rcu_create_node(node->hash, node->key, node->key_len, node->value);
+            if (!copy) {
+                rcu_free_table(table);
+                return;
+            }
+            MapNode **bucket = &table->list[node->hash & (uint64_t)(size - 1)];
+            copy->next = *bucket;
+            *bucket = copy;
+        }
+    }
+    __atomic_store_n(&map->table, table, __ATOMIC_RELEASE);
+    rcu_retire(map, old_table, rcu_free_table);
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// create_rcu_hash_map
+// ****************************************************************************************
+/**
+ *  Initialice a read mostly Hash Map whose gets take no locks
+ * @param[in]    size        Initial size for the Hash Map (rounded up to a power of two)
+ * @param[in]    free_value  Function to free values once no reader can see them (NULL if
+ *                           values must not be freed)
+ * @param[out]   none
+ * @return       Pointer to a valid RCU Hash Map structure, NULL if it can not be allocated
+ *
+ * @details      Readers follow the chains with atomic loads only, writing no shared memory.
+ *               Writers are serialized by a mutex and publish every change with a single
+ *               atomic pointer store: new nodes are linked at the head of their chain,
+ *               removed nodes are unlinked, new values replace the value pointer of the
+ *               node, and a grown table replaces the table pointer (its nodes are copies).
+ *
+ *               Removed nodes, replaced values and old tables are freed after a grace
+ *               period (quiescent state based reclamation): every thread calling
+ *               #rcu_hash_map_get registers with #rcu_hash_map_register_reader and calls
+ *               #rcu_hash_map_quiescent when it holds no pointer obtained from the map,
+ *               e.g. once per request. Memory is freed by writers once every registered
+ *               reader announced a quiescent state after its removal.
+ */
+// ****************************************************************************************
+RcuHashMap * create_rcu_hash_map(int size, void (*free_value)(void *)) {
+    RcuHashMap *map = malloc(sizeof(RcuHashMap));
+    if (!map)
+        return NULL;
+    int table_size = 1;
+    while (table_size < size && table_size < (1 << 30))
+        table_size <<= 1;
+    map->table = rcu_create_table(table_size);
+    if (!map->table) {
+        free(map);
+        return NULL;
+    }
+    map->count = 0;
+    map->free_value = free_value;
+    map->epoch = 1;
+    map->readers = NULL;
+    map->retired = NULL;
+    pthread_mutex_init(&map->write_lock, NULL);
+    map->seed = hash_map_new_seed(map);
+    return map;
+}
+
+
+// ****************************************************************************************
+// rcu_hash_map_register_reader
+// ****************************************************************************************
+/**
+ *  Register the calling thread as a reader of #map
+ * @param[in]    map        RCU Hash Map to read
+ * @return       Reader handle to be given to #rcu_hash_map_quiescent, NULL if it can not be allocated
+ */
+// ****************************************************************************************
+RcuReader * rcu_hash_map_register_reader(RcuHashMap *map) {
+    RcuReader *reader = aligned_alloc(CLIB_CACHE_LINE, sizeof(RcuReader));
+    if (!reader)
+        return NULL;
+    pthread_mutex_lock(&map->write_lock);
+    reader->seen_epoch = __atomic_load_n(&map->epoch, __ATOMIC_SEQ_CST);
+    reader->next = map->readers;
+    map->readers = reader;
+    pthread_mutex_unlock(&map->write_lock);
+    return reader;
+}
+
+
+// ****************************************************************************************
+// rcu_hash_map_unregister_reader
+// ****************************************************************************************
+/**
+ *  Unregister and free a reader of #map, once it will not read the map anymore
+ * @param[in]    map        RCU Hash Map
+ * @param[in]    reader     Reader handle given by #rcu_hash_map_register_reader
+ */
+// ****************************************************************************************
+void rcu_hash_map_unregister_reader(RcuHashMap *map, RcuReader *reader) {
+    pthread_mutex_lock(&map->write_lock);
+    RcuReader **link = &map->readers;
+    while (*link && *link != reader)
+        link = &(*link)->next;
+    if (*link)
+        *link = reader->next;
+    rcu_reclaim(map);
+    pthread_mutex_unlock(&map->write_lock);
+    free(reader);
+}
+
+
+// ****************************************************************************************
+// rcu_hash_map_quiescent
+// ****************************************************************************************
+/**
+ *  Announce that #reader holds no node, key or value obtained from #map
+ * @param[in]    map        RCU Hash Map
+ * @param[in]    reader     Reader handle of the calling thread
+ *
+ * @details      It only writes #reader cache line. Memory is not reclaimed while some
+ *               registered reader does not call it, so long running readers must call
+ *               it periodically.
+ */
+// ****************************************************************************************
+void rcu_hash_map_quiescent(RcuHashMap *map, RcuReader *reader) {
+    __atomic_store_n(&reader->seen_epoch, __atomic_load_n(&map->epoch, __ATOMIC_SEQ_CST),
+                     __ATOMIC_RELEASE);
+}
+
+
+// ****************************************************************************************
+// rcu_hash_map_get
+// ****************************************************************************************
+/**
+ *  Get a key-value pair on #map given a #key, without taking any lock
+ * @param[in]    map        RCU Hash Map to obtain value
+ * @param[in]    key        Key of pair key-value to obtain
+ * @return       Pointer value if #key exists, or NULL if it does not exist
+ *
+ * @details      Value is valid until the calling reader next calls #rcu_hash_map_quiescent.
+ */
+// ****************************************************************************************
+void * rcu_hash_map_get(RcuHashMap *map, const char *key) {
+    size_t len = strlen(key);
+    uint64_t hash = hash_bytes(key, len, map->seed);
+    struct rcu_table *table = __atomic_load_n(&map->table, __ATOMIC_ACQUIRE);
+    MapNode *node = __atomic_load_n(&table->list[hash & (uint64_t)(table->size - 1)], __ATOMIC_ACQUIRE);
+    while (node) {
+        if (node->hash == hash && node->key_len == len && memcmp(node->key, key, len) == 0)
+            return __atomic_load_n(&node->value, __ATOMIC_ACQUIRE);
+        node = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+    }
+    return NULL;
+}
+
+
+// ****************************************************************************************
+// rcu_hash_map_set
+// ****************************************************************************************
+/**
+ *  Set a key-value pair on #map given a #key. If key already exist, replace its value
+ * @param[in]    map        RCU Hash Map to be set
+ * @param[in]    key        Key of pair key-value (it is copied)
+ * @param[in]    value      Value of pair key-value
+ * @return       CLIB_OK    if pair is set \n
+ *               CLIB_ERROR if it can not be allocated
+ *
+ * @details      A replaced value is freed with the map free_value after a grace period.
+ */
+// ****************************************************************************************
+int rcu_hash_map_set(RcuHashMap *map, const char *key, void *value) {
+    size_t len = strlen(key);
+    uint64_t hash = hash_bytes(key, len, map->seed);
+    int result = CLIB_OK;
+
+    pthread_mutex_lock(&map->write_lock);
+    struct rcu_table *table = map->table;
+    MapNode **bucket = &table->list[hash & (uint64_t)(table->size - 1)];
+    MapNode *node = *bucket;
+    while (node && !(node->hash == hash && node->key_len == len && memcmp(node->key, key, len) == 0))
+        node = node->next;
+
+    if (node) {
+        void *old_value = node->value;
+        __atomic_store_n(&node->value, value, __ATOMIC_RELEASE);
+        if (map->free_value && old_value && old_value != value)
+            rcu_retire(map, old_value, map->free_value);
+    } else if (len <= UINT32_MAX && (node = rcu_create_node(hash, key, len, value))) {
+        // Node is complete before the release store makes it reachable
+        node->next = *bucket;
+        __atomic_store_n(bucket, node, __ATOMIC_RELEASE);
+        if (++map->count > (unsigned int)table->size && table->size < (1 << 30))
+            rcu_resize(map, table->size * 2);
+    } else {
+        result = CLIB_ERROR;
+    }
+    rcu_reclaim(map);
+    pthread_mutex_unlock(&map->write_lock);
+    return result;
+}
+
+
+// ****************************************************************************************
+// rcu_hash_map_remove
+// ****************************************************************************************
+/**
+ *  Remove a key-value pair on #map given a #key
+ * @param[in]    map        RCU Hash Map to remove pair
+ * @param[in]    key        Key of pair key-value to be removed
+ * @return       CLIB_OK    if key exist \n
+ *               CLIB_ERROR if key does not exist
+ *
+ * @details      Node and value are freed after a grace period.
+ */
+// ****************************************************************************************
+int rcu_hash_map_remove(RcuHashMap *map, const char *key) {
+    size_t len = strlen(key);
+    uint64_t hash = hash_bytes(key, len, map->seed);
+
+    pthread_mutex_lock(&map->write_lock);
+    struct rcu_table *table = map->table;
+    MapNode **link = &table->list[hash & (uint64_t)(table->size - 1)];
+    while (*link && !((*link)->hash == hash && (*link)->key_len == len
+                      && memcmp((*link)->key, key, len) == 0))
+        link = &(*link)->next;
+
+    MapNode *node = *link;
+    if (node) {
+        // Readers standing on #node still reach the rest of the chain through its next
+        __atomic_store_n(link, node->next, __ATOMIC_RELEASE);
+        map->count--;
+        if (map->free_value && node->value)
+            rcu_retire(map, node->value, map->free_value);
+        rcu_retire(map, node, rcu_free_node);
+    }
+    rcu_reclaim(map);
+    pthread_mutex_unlock(&map->write_lock);
+    return node ? CLIB_OK : CLIB_ERROR;
+}
+
+
+// ****************************************************************************************
+// rcu_hash_map_synchronize
+// ****************************************************************************************
+/**
+ *  Wait until every memory removed from #map so far is freed
+ * @param[in]    map        RCU Hash Map
+ *
+ * @details      Waits for every registered reader to call #rcu_hash_map_quiescent, so it
+ *               must not be called by a registered reader of #map.
+ */
+// ****************************************************************************************
+void rcu_hash_map_synchronize(RcuHashMap *map) {
+    bool pending;
+    do {
+        pthread_mutex_lock(&map->write_lock);
+        rcu_reclaim(map);
+        pending = map->retired != NULL;
+        pthread_mutex_unlock(&map->write_lock);
+        if (pending)
+            sched_yield();
+    } while (pending);
+}
+
+
+// ****************************************************************************************
+// rcu_hash_map_destroy
+// ****************************************************************************************
+/**
+ *  Delete #map, freeing every node, key, value and reader
+ * @param[in]    map         RCU Hash Map to be destroyed (no thread may be using it)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void rcu_hash_map_destroy(RcuHashMap *map) {
+    while (map->retired) {
+        struct rcu_retired *retired = map->retired;
+        map->retired = retired->next;
+        (*retired->free_func)(retired->ptr);
+        free(retired);
+    }
+    while (map->readers) {
+        RcuReader *reader = map->readers;
+        map->readers = reader->next;
+        free(reader);
+    }
+    if (map->free_value) {
+        for (int i = 0; i < map->table->size; i++) {
+            for (MapNode *node = map->table->list[i]; node; node = node->next) {
+                if (node->value)
+                    (*map->free_value)(node->value);
+            }
+        }
+    }
+    rcu_free_table(map->table);
+    pthread_mutex_destroy(&map->write_lock);
+    free(map);
+}
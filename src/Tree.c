@@ -65,7 +65,7 @@ void tree_insert(Tree *tree, void *content){
     if (tree->size == 0){
         tree->root = malloc(sizeof(TreeNode));
         tree->root->content = content;
-        tree->root->children = create_linked_list();
+        list_init(&tree->root->children);
     } else {
         // Start find method in order to locate correct position
         // TODO
@@ -0,0 +1,375 @@
+// ****************************************************************************************
+/**
+ * @file   UnrolledList.c
+ * @brief  Unrolled List: doubly linked list of cache aligned chunks of values
+ *
+ * @details Values live on arrays of #UNROLLED_LIST_CHUNK_ITEMS pointers. Only the first
+ *          and last chunks may be partially filled: the first one holds its values at the
+ *          end of its array and the last one at the start, so pushes and pops at both
+ *          ends touch a single chunk and never move values.
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+// ****************************************************************************************
+// ********************************** Include Files ***************************************
+// ****************************************************************************************
+#include "Clib.h"
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define CACHE_LINE              (64)
+#define CHUNK_ITEMS             ((uint32_t)UNROLLED_LIST_CHUNK_ITEMS)
+
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// chunk_take
+// ****************************************************************************************
+/*  Private function to get an empty chunk, the spare one of #list if there is one
+ * @param[in]    list  Unrolled list needing a chunk
+ * @param[in]    start Index of the first value the chunk will hold
+ * @return       Empty chunk, NULL if it can not be allocated
+ */
+// ****************************************************************************************
+static UnrolledChunk * chunk_take(UnrolledList *list, uint32_t start) {
+    UnrolledChunk *chunk = list->spare;
+    if (chunk)
+        list->spare = NULL;
+    else if (!(chunk = aligned_alloc(CACHE_LINE, sizeof(UnrolledChunk))))
+        return NULL;
+    chunk->prev = NULL;
+    chunk->next = NULL;
+    chunk->start = start;
+    chunk->count = 0;
+    return chunk;
+}
+
+/// Keep #chunk, just emptied, as spare of #list, or free it if there is one already
+static void chunk_release(UnrolledList *list, UnrolledChunk *chunk) {
+    if (list->spare)
+        free(chunk);
+    else
+        list->spare = chunk;
+}
+
+
+/******************************************************************************/
+/*********************** Public Functions Implementations *********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// create_unrolled_list
+// ****************************************************************************************
+/**
+ *  Initialice unrolled list
+ * @param[in]    none
+ * @param[out]   none
+ * @return       valid pointer to unrolled list structure, NULL if it can not be allocated
+ */
+// ****************************************************************************************
+UnrolledList * create_unrolled_list(void) {
+    UnrolledList *list = malloc(sizeof(UnrolledList));
+    if (!list)
+        return NULL;
+    list->first = NULL;
+    list->last = NULL;
+    list->spare = NULL;
+    list->size = 0;
+    return list;
+}
+
+
+// ****************************************************************************************
+// unrolled_list_push_front
+// ****************************************************************************************
+/**
+ *  Insert #value on the first position of #list
+ * @param[in]    list  Unrolled list to insert #value
+ * @param[in]    value Pointer to data to be stored on the first position of list
+ * @param[out]   none
+ * @return       CLIB_OK    if #value is inserted \n
+ *               CLIB_ERROR if a new chunk can not be allocated
+ */
+// ****************************************************************************************
+int unrolled_list_push_front(UnrolledList *list, void *value) {
+    UnrolledChunk *chunk = list->first;
+    if (!chunk || chunk->start == 0) {
+        // New first chunk fills from its end towards its start
+        UnrolledChunk *add = chunk_take(list, CHUNK_ITEMS);
+        if (!add)
+            return CLIB_ERROR;
+        add->next = chunk;
+        if (chunk)
+            chunk->prev = add;
+        else
+            list->last = add;
+        list->first = chunk = add;
+    }
+    chunk->items[--chunk->start] = value;
+    chunk->count++;
+    list->size++;
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// unrolled_list_push_back
+// ****************************************************************************************
+/**
+ *  Insert #value on the last position of #list
+ * @param[in]    list  Unrolled list to insert #value
+ * @param[in]    value Pointer to data to be stored on the last position of list
+ * @param[out]   none
+ * @return       CLIB_OK    if #value is inserted \n
+ *               CLIB_ERROR if a new chunk can not be allocated
+ */
+// ****************************************************************************************
+int unrolled_list_push_back(UnrolledList *list, void *value) {
+    UnrolledChunk *chunk = list->last;
+    if (!chunk || chunk->start + chunk->count == CHUNK_ITEMS) {
+        UnrolledChunk *add = chunk_take(list, 0);
+        if (!add)
+            return CLIB_ERROR;
+        add->prev = chunk;
+        if (chunk)
+            chunk->next = add;
+        else
+            list->first = add;
+        list->last = chunk = add;
+    }
+    chunk->items[chunk->start + chunk->count++] = value;
+    list->size++;
+    return CLIB_OK;
+}
+
+
+// ****************************************************************************************
+// unrolled_list_pop_front
+// ****************************************************************************************
+/**
+ *  Extract first value of #list, returning it
+ * @param[in]    list  Unrolled list to pop first value
+ * @param[out]   none
+ * @return       Pointer to data stored on the first position of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+void * unrolled_list_pop_front(UnrolledList *list) {
+    UnrolledChunk *chunk = list->first;
+    if (!chunk)
+        return NULL;
+    void *value = chunk->items[chunk->start++];
+    list->size--;
+    if (--chunk->count == 0) {
+        list->first = chunk->next;
+        if (list->first)
+            list->first->prev = NULL;
+        else
+            list->last = NULL;
+        chunk_release(list, chunk);
+    }
+    return value;
+}
+
+
+// ****************************************************************************************
+// unrolled_list_pop_back
+// ****************************************************************************************
+/**
+ *  Extract last value of #list, returning it
+ * @param[in]    list  Unrolled list to pop last value
+ * @param[out]   none
+ * @return       Pointer to data stored on the last position of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+void * unrolled_list_pop_back(UnrolledList *list) {
+    UnrolledChunk *chunk = list->last;
+    if (!chunk)
+        return NULL;
+    void *value = chunk->items[chunk->start + --chunk->count];
+    list->size--;
+    if (chunk->count == 0) {
+        list->last = chunk->prev;
+        if (list->last)
+            list->last->next = NULL;
+        else
+            list->first = NULL;
+        chunk_release(list, chunk);
+    }
+    return value;
+}
+
+
+// ****************************************************************************************
+// unrolled_list_get_first
+// ****************************************************************************************
+/**
+ *  Get the first value of #list without extracting it
+ * @param[in]    list  Unrolled list to get first value
+ * @param[out]   none
+ * @return       Pointer to data stored on the first position of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+void * unrolled_list_get_first(UnrolledList *list) {
+    return list->first ? list->first->items[list->first->start] : NULL;
+}
+
+
+// ****************************************************************************************
+// unrolled_list_get_last
+// ****************************************************************************************
+/**
+ *  Get the last value of #list without extracting it
+ * @param[in]    list  Unrolled list to get last value
+ * @param[out]   none
+ * @return       Pointer to data stored on the last position of #list (NULL if list is empty)
+ */
+// ****************************************************************************************
+void * unrolled_list_get_last(UnrolledList *list) {
+    return list->last ? list->last->items[list->last->start + list->last->count - 1] : NULL;
+}
+
+
+// ****************************************************************************************
+// unrolled_list_get_size
+// ****************************************************************************************
+/**
+ *  Get the list current size
+ * @param[in]    list  Unrolled list to obtain current size
+ * @param[out]   none
+ * @return       Size of list
+ */
+// ****************************************************************************************
+unsigned int unrolled_list_get_size(UnrolledList *list) { return list->size; }
+
+
+// ****************************************************************************************
+// unrolled_list_is_empty
+// ****************************************************************************************
+/**
+ *  Check if #list is empty
+ * @param[in]    list  Unrolled list to check if is empty
+ * @param[out]   none
+ * @return       List empty
+ */
+// ****************************************************************************************
+bool unrolled_list_is_empty(UnrolledList *list) { return list->size == 0; }
+
+
+// ****************************************************************************************
+// unrolled_list_get_element
+// ****************************************************************************************
+/**
+ *  Get element of list given a #position
+ * @param[in]    list      Unrolled list to get element
+ * @param[in]    position  Position inside list
+ * @param[out]   none
+ * @return       Element on given position (NULL if #position is out of the list)
+ */
+// ****************************************************************************************
+void * unrolled_list_get_element(UnrolledList *list, unsigned int position) {
+    if (position >= list->size)
+        return NULL;
+
+    UnrolledChunk *chunk;
+    if (position < list->size / 2) {
+        chunk = list->first;
+        while (position >= chunk->count) {
+            position -= chunk->count;
+            chunk = chunk->next;
+        }
+    } else {
+        // Count positions from the end of the list, then turn them into chunk indexes
+        unsigned int from_end = list->size - 1 - position;
+        chunk = list->last;
+        while (from_end >= chunk->count) {
+            from_end -= chunk->count;
+            chunk = chunk->prev;
+        }
+        position = chunk->count - 1 - from_end;
+    }
+    return chunk->items[chunk->start + position];
+}
+
+
+// ****************************************************************************************
+// unrolled_list_find
+// ****************************************************************************************
+/**
+ *  Find and return first #list value which match pattern
+ * @param[in]    list       Unrolled list to find value
+ * @param[in]    pattern    Content to find
+ * @param[in]    comparator Function which compares contents
+ * @param[out]   none
+ * @return       First value matching given #pattern (NULL if there is none)
+ */
+// ****************************************************************************************
+void * unrolled_list_find(UnrolledList *list, void *pattern, ContentComparator comparator) {
+    for (UnrolledChunk *chunk = list->first; chunk; chunk = chunk->next) {
+        void **items = &chunk->items[chunk->start];
+        for (uint32_t i = 0; i < chunk->count; ++i) {
+            if (comparator(pattern, items[i]) == 0)
+                return items[i];
+        }
+    }
+    return NULL;
+}
+
+
+// ****************************************************************************************
+// unrolled_list_print
+// ****************************************************************************************
+/**
+ *  Print all list elements starting from the first element given a print function
+ * @param[in]    list        Unrolled list to be printed
+ * @param[in]    print_func  Function pointer to print value
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void unrolled_list_print(UnrolledList *list, void (*print_func)(void *)) {
+    for (UnrolledChunk *chunk = list->first; chunk; chunk = chunk->next) {
+        for (uint32_t i = chunk->start; i < chunk->start + chunk->count; ++i)
+            print_func(chunk->items[i]);
+    }
+}
+
+
+// ****************************************************************************************
+// unrolled_list_destroy
+// ****************************************************************************************
+/**
+ *  Delete #list and every chunk of it
+ * @param[in]    list        Unrolled list to be destroyed
+ * @param[in]    free_value  Function to free values (NULL if values must not be freed)
+ * @param[out]   none
+ * @return       none
+ */
+// ****************************************************************************************
+void unrolled_list_destroy(UnrolledList *list, void (*free_value)(void *)) {
+    UnrolledChunk *chunk = list->first;
+    while (chunk) {
+        UnrolledChunk *next = chunk->next;
+        if (free_value) {
+            for (uint32_t i = chunk->start; i < chunk->start + chunk->count; ++i)
+                free_value(chunk->items[i]);
+        }
+        free(chunk);
+        chunk = next;
+    }
+    free(list->spare);
+    free(list);
+}
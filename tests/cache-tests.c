@@ -0,0 +1,311 @@
+// ****************************************************************************************
+/**
+ * @file   cache-tests.c
+ * @brief  Unit tests of cache structure
+ *
+ * @details
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+#include "Clib.h"
+#include <stdio.h>
+#include "unity.h"
+
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+Cache *cache;
+int test_nums[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 };
+
+/// Keys given to #record_eviction, in eviction order
+char evicted[16][16];
+unsigned int evicted_count;
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+void record_eviction(const char *key, void *value, void *ctx){
+    (void)value;
+    (void)ctx;
+    snprintf(evicted[evicted_count++ % 16], sizeof(evicted[0]), "%s", key);
+}
+
+void free_int(void *ptr){
+    // Values are not allocated, count calls instead
+    (void)ptr;
+    evicted_count++;
+}
+
+
+/******************************************************************************/
+/******************** Public Test Function Implementations ********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// test_create_cache
+// ****************************************************************************************
+/**
+ *  Check creation of caches
+ *
+ * Function under testing:
+ *  #create_cache
+ *
+ * Check:
+ * 	- Caches without room are not created
+ * 	- New cache is empty and keeps its capacity and policy
+ */
+// ****************************************************************************************
+void test_create_cache(void){
+    TEST_ASSERT_NULL(create_cache(0, CACHE_LRU, NULL, NULL));
+    TEST_ASSERT_NOT_NULL(cache);
+    TEST_ASSERT_EQUAL_UINT(3, cache->capacity);
+    TEST_ASSERT_EQUAL_INT(CACHE_LRU, cache->policy);
+    TEST_ASSERT_EQUAL_UINT(0, cache->map->count);
+    TEST_ASSERT_TRUE(list_is_empty(cache->entries));
+}
+
+
+// ****************************************************************************************
+// test_cache_put_get
+// ****************************************************************************************
+/**
+ *  Check setting and getting entries
+ *
+ * Function under testing:
+ *  #cache_put
+ *  #cache_get
+ *
+ * Check:
+ * 	- Values are found, updates return the previous value and do not evict
+ * 	- Hits and misses are counted
+ */
+// ****************************************************************************************
+void test_cache_put_get(void){
+    TEST_ASSERT_NULL(cache_get(cache, "a"));
+    TEST_ASSERT_NULL(cache_put(cache, "a", &test_nums[1]));
+    TEST_ASSERT_NULL(cache_put(cache, "b", &test_nums[2]));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[1], cache_get(cache, "a"));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[1], cache_put(cache, "a", &test_nums[3]));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[3], cache_get(cache, "a"));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[2], cache_get(cache, "b"));
+    TEST_ASSERT_EQUAL_UINT(2, cache->map->count);
+    TEST_ASSERT_EQUAL_UINT(2, list_get_size(cache->entries));
+    TEST_ASSERT_EQUAL_UINT(3, cache->hits);
+    TEST_ASSERT_EQUAL_UINT(1, cache->misses);
+    TEST_ASSERT_EQUAL_UINT(0, cache->evictions);
+}
+
+
+// ****************************************************************************************
+// test_cache_lru
+// ****************************************************************************************
+/**
+ *  Check LRU eviction
+ *
+ * Function under testing:
+ *  #cache_put
+ *  #cache_get
+ *
+ * Check:
+ * 	- Least recently used entry is evicted, gets and updates count as uses
+ * 	- Eviction callback receives every evicted key
+ */
+// ****************************************************************************************
+void test_cache_lru(void){
+    Cache *lru = create_cache(3, CACHE_LRU, record_eviction, NULL);
+    cache_put(lru, "a", &test_nums[0]);
+    cache_put(lru, "b", &test_nums[1]);
+    cache_put(lru, "c", &test_nums[2]);
+    cache_get(lru, "a");
+    cache_put(lru, "d", &test_nums[3]);
+    TEST_ASSERT_EQUAL_UINT(1, evicted_count);
+    TEST_ASSERT_EQUAL_STRING("b", evicted[0]);
+    TEST_ASSERT_NULL(cache_get(lru, "b"));
+
+    cache_put(lru, "c", &test_nums[4]);
+    cache_put(lru, "e", &test_nums[5]);
+    TEST_ASSERT_EQUAL_STRING("a", evicted[1]);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[4], cache_get(lru, "c"));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[3], cache_get(lru, "d"));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[5], cache_get(lru, "e"));
+    TEST_ASSERT_EQUAL_UINT(2, lru->evictions);
+    TEST_ASSERT_EQUAL_UINT(3, lru->map->count);
+    cache_destroy(lru, NULL);
+}
+
+
+// ****************************************************************************************
+// test_cache_sieve
+// ****************************************************************************************
+/**
+ *  Check SIEVE eviction
+ *
+ * Function under testing:
+ *  #cache_put
+ *  #cache_get
+ *  #cache_remove
+ *
+ * Check:
+ * 	- Hand skips visited entries once, clearing their mark, and evicts the first unmarked one
+ * 	- Hand continues from the entry newer than the last victim
+ * 	- Hits do not move entries, and removing the entry under the hand moves the hand
+ */
+// ****************************************************************************************
+void test_cache_sieve(void){
+    Cache *sieve = create_cache(3, CACHE_SIEVE, record_eviction, NULL);
+    cache_put(sieve, "a", &test_nums[0]);
+    cache_put(sieve, "b", &test_nums[1]);
+    cache_put(sieve, "c", &test_nums[2]);
+    ListNode *oldest = sieve->entries->tail.next;
+    cache_get(sieve, "a");
+    TEST_ASSERT_EQUAL_PTR(oldest, sieve->entries->tail.next);
+
+    cache_put(sieve, "d", &test_nums[3]);
+    TEST_ASSERT_EQUAL_STRING("b", evicted[0]);
+    cache_put(sieve, "e", &test_nums[4]);
+    TEST_ASSERT_EQUAL_STRING("c", evicted[1]);
+    cache_put(sieve, "f", &test_nums[5]);
+    TEST_ASSERT_EQUAL_STRING("d", evicted[2]);
+    cache_get(sieve, "f");
+    cache_put(sieve, "g", &test_nums[6]);
+    TEST_ASSERT_EQUAL_STRING("e", evicted[3]);
+    // Hand skips "f", clearing its mark, and leaves after the newest entry
+    cache_put(sieve, "h", &test_nums[7]);
+    TEST_ASSERT_EQUAL_STRING("g", evicted[4]);
+    // Hand wrapped: "a" lost its mark on the first pass, so it goes now
+    cache_put(sieve, "i", &test_nums[8]);
+    TEST_ASSERT_EQUAL_STRING("a", evicted[5]);
+    TEST_ASSERT_EQUAL_UINT(6, evicted_count);
+
+    // Hand is on "f", the entry after "a"
+    TEST_ASSERT_EQUAL_INT(CLIB_OK, cache_remove(sieve, "f", NULL));
+    TEST_ASSERT_EQUAL_INT(CLIB_ERROR, cache_remove(sieve, "f", NULL));
+    cache_put(sieve, "j", &test_nums[9]);
+    TEST_ASSERT_EQUAL_UINT(6, evicted_count);
+    cache_put(sieve, "k", &test_nums[10]);
+    TEST_ASSERT_EQUAL_STRING("h", evicted[6]);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[8], cache_get(sieve, "i"));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[9], cache_get(sieve, "j"));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[10], cache_get(sieve, "k"));
+    cache_destroy(sieve, NULL);
+}
+
+
+// ****************************************************************************************
+// test_cache_churn
+// ****************************************************************************************
+/**
+ *  Check both policies under many random operations
+ *
+ * Function under testing:
+ *  #cache_put
+ *  #cache_get
+ *  #cache_remove
+ *  #cache_destroy
+ *
+ * Check:
+ * 	- Cache never holds more than its capacity, list and map stay in sync
+ * 	- Cached keys always return their last value
+ * 	- Destroy frees every value left
+ */
+// ****************************************************************************************
+void test_cache_churn(void){
+    static const CachePolicy policies[] = { CACHE_LRU, CACHE_SIEVE };
+    char key[16];
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); ++p){
+        Cache *churn = create_cache(50, policies[p], NULL, NULL);
+        unsigned int state = 7;
+        for (int i = 0; i < 20000; ++i){
+            state = state * 1103515245u + 12345u;
+            unsigned int k = (state >> 16) % 200;
+            snprintf(key, sizeof(key), "key-%u", k);
+            if (i % 7 == 0)
+                cache_remove(churn, key, NULL);
+            else if (i % 3 == 0)
+                cache_put(churn, key, &test_nums[k % 14]);
+            else if (cache_get(churn, key))
+                TEST_ASSERT_EQUAL_PTR(&test_nums[k % 14], cache_get(churn, key));
+            TEST_ASSERT_TRUE(churn->map->count <= 50);
+            TEST_ASSERT_EQUAL_UINT(churn->map->count, list_get_size(churn->entries));
+        }
+        TEST_ASSERT_TRUE(churn->evictions > 0);
+        unsigned int left = churn->map->count;
+        evicted_count = 0;
+        cache_destroy(churn, free_int);
+        TEST_ASSERT_EQUAL_UINT(left, evicted_count);
+    }
+}
+
+
+
+// ****************************************************************************************
+// test_cache_footprint
+// ****************************************************************************************
+/**
+ *  Check a full cache keeps its footprint while new keys keep evicting old ones
+ *
+ * Function under testing:
+ *  #cache_put
+ *
+ * Check:
+ * 	- Key storage of the cache map stays the same after cycling 100 times its capacity
+ */
+// ****************************************************************************************
+void test_cache_footprint(void){
+    static const CachePolicy policies[] = { CACHE_LRU, CACHE_SIEVE };
+    char key[48];
+    for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); ++p){
+        Cache *churn = create_cache(1000, policies[p], NULL, NULL);
+        HashMapStats stats;
+        size_t filled = 0;
+        for (unsigned int i = 0; i < 100 * 1000; ++i){
+            // Session id like keys, too long to be stored inline on map nodes
+            snprintf(key, sizeof(key), "session-%032u", i);
+            TEST_ASSERT_NULL(cache_put(churn, key, &test_nums[i % 14]));
+            if (i == 2 * 1000){
+                hash_map_stats(churn->map, &stats);
+                filled = stats.key_arena_bytes;
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT(1000, churn->map->count);
+        hash_map_stats(churn->map, &stats);
+        TEST_ASSERT_TRUE(filled > 0);
+        TEST_ASSERT_EQUAL_UINT64(filled, stats.key_arena_bytes);
+        cache_destroy(churn, NULL);
+    }
+}
+
+// Needed by Unity test framework. This functions will be executed before and after each test.
+void setUp(void){
+    cache = create_cache(3, CACHE_LRU, NULL, NULL);
+    evicted_count = 0;
+}
+
+void tearDown(void){
+    cache_destroy(cache, NULL);
+}
+
+
+int main (void){
+    UNITY_BEGIN();
+    RUN_TEST(test_create_cache);
+    RUN_TEST(test_cache_put_get);
+    RUN_TEST(test_cache_lru);
+    RUN_TEST(test_cache_sieve);
+    RUN_TEST(test_cache_churn);
+    RUN_TEST(test_cache_footprint);
+    return UNITY_END();
+
+}
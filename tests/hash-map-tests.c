@@ -129,6 +129,1491 @@ void test_hash_map_remove(void){
     }
 }
 
+// ****************************************************************************************
+// test_hash_bytes
+// ****************************************************************************************
+/**
+ *  Check hash function quality basics
+ *
+ * Function under testing:
+ *  #hash_bytes
+ *
+ * Check:
+ * 	- Same bytes and seed always give the same hash
+ * 	- Different seeds give different hashes
+ * 	- Anagrams and keys of same length do not collide (additive hashes did)
+ */
+// ****************************************************************************************
+void test_hash_bytes(void){
+    const char *key = "session-0123456789abcdef";
+    size_t len = strlen(key);
+
+    TEST_ASSERT_TRUE(hash_bytes(key, len, 1) == hash_bytes(key, len, 1));
+    TEST_ASSERT_TRUE(hash_bytes(key, len, 1) != hash_bytes(key, len, 2));
+    TEST_ASSERT_TRUE(hash_bytes("abc", 3, 0) != hash_bytes("cba", 3, 0));
+    TEST_ASSERT_TRUE(hash_bytes("ab", 2, 0) != hash_bytes("ba", 2, 0));
+    TEST_ASSERT_TRUE(hash_bytes(key, len, 0) != hash_bytes(key, len - 1, 0));
+    TEST_ASSERT_TRUE(hash_bytes("", 0, 0) != hash_bytes("", 0, 1));
+}
+
+// ****************************************************************************************
+// test_hash_map_cached_hash
+// ****************************************************************************************
+/**
+ *  Check nodes store the full hash of their key
+ *
+ * Function under testing:
+ *  #hash_map_set
+ *
+ * Check:
+ * 	- Stored hash corresponds to the key hashed with the map seed
+ */
+// ****************************************************************************************
+void test_hash_map_cached_hash(void){
+    char key_buff[10];
+    for (int i = 0; i < TEST_LEN; ++i){
+        sprintf(key_buff, "%d", test_nums[i]);
+        hash_map_set(map, key_buff, &test_nums[i]);
+    }
+    for (int i = 0; i < map->size; ++i){
+        for (MapNode *node = map->list[i]; node; node = node->next){
+            TEST_ASSERT_TRUE(node->hash == hash_bytes(node->key, strlen(node->key), map->seed));
+        }
+    }
+}
+
+// ****************************************************************************************
+// test_hash_map_growth
+// ****************************************************************************************
+/**
+ *  Check table doubles and keys remain reachable while nodes are being rehashed
+ *
+ * Function under testing:
+ *  #hash_map_set
+ *  #hash_map_get
+ *  #hash_map_pop
+ *
+ * Check:
+ * 	- Table grows once max load factor is exceeded
+ * 	- Rehash is incremental (old table is kept after the doubling insertion)
+ * 	- Every key is found on every step of the rehash
+ */
+// ****************************************************************************************
+void test_hash_map_growth(void){
+    char key_buff[16];
+    HashMap *grow_map = create_hash_map(1);
+    bool incremental = false;
+
+    for (int i = 0; i < 1000; ++i){
+        sprintf(key_buff, "key-%d", i);
+        hash_map_set(grow_map, key_buff, &test_nums[i % TEST_LEN]);
+        incremental |= grow_map->old_list != NULL;
+        for (int j = 0; j <= i; j += 37){
+            sprintf(key_buff, "key-%d", j);
+            TEST_ASSERT_EQUAL_PTR(&test_nums[j % TEST_LEN], hash_map_get(grow_map, key_buff));
+        }
+    }
+    TEST_ASSERT_TRUE(incremental);
+    TEST_ASSERT_EQUAL_UINT(1000, grow_map->count);
+    TEST_ASSERT_TRUE(grow_map->size >= 1000);
+
+    for (int i = 0; i < 1000; ++i){
+        sprintf(key_buff, "key-%d", i);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i % TEST_LEN], hash_map_pop(grow_map, key_buff));
+    }
+    TEST_ASSERT_EQUAL_UINT(0, grow_map->count);
+    hash_map_destroy(grow_map, NULL);
+}
+
+// ****************************************************************************************
+// test_hash_map_reserve
+// ****************************************************************************************
+/**
+ *  Check table is presized by reserve and load factor configuration
+ *
+ * Function under testing:
+ *  #hash_map_reserve
+ *  #hash_map_set_max_load_factor
+ *
+ * Check:
+ * 	- Invalid load factors are rejected
+ * 	- Reserved table fits the requested count without rehashing afterwards
+ */
+// ****************************************************************************************
+void test_hash_map_reserve(void){
+    char key_buff[16];
+
+    TEST_ASSERT_EQUAL_INT(CLIB_ERROR, hash_map_set_max_load_factor(map, 0));
+    TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_set_max_load_factor(map, 0.5f));
+    TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_reserve(map, 100));
+    TEST_ASSERT_TRUE(map->size >= 200);
+    TEST_ASSERT_NULL(map->old_list);
+
+    int size = map->size;
+    for (int i = 0; i < 100; ++i){
+        sprintf(key_buff, "key-%d", i);
+        hash_map_set(map, key_buff, &test_nums[i % TEST_LEN]);
+    }
+    TEST_ASSERT_EQUAL_INT(size, map->size);
+    TEST_ASSERT_NULL(map->old_list);
+}
+
+// ****************************************************************************************
+// test_hash_map_swiss_engine
+// ****************************************************************************************
+/**
+ *  Check swiss engine keeps Hash Map semantics
+ *
+ * Function under testing:
+ *  #create_hash_map_engine
+ *  #hash_map_set
+ *  #hash_map_get
+ *  #hash_map_pop
+ *  #hash_map_remove
+ *
+ * Check:
+ * 	- Set returns previous value on update
+ * 	- Every key is found while the table grows
+ * 	- Removed keys are not found and remaining keys are, with deleted slots reused
+ * 	- Remove frees the value once
+ */
+// ****************************************************************************************
+void free_counter(void *ptr){
+    ++*(int *)ptr;
+}
+
+void test_hash_map_swiss_engine(void){
+    char key_buff[16];
+    int removed = 0;
+    HashMap *swiss = create_hash_map_engine(1, HASH_MAP_SWISS);
+
+    TEST_ASSERT_NOT_NULL(swiss);
+    for (int i = 0; i < 2000; ++i){
+        sprintf(key_buff, "key-%d", i);
+        TEST_ASSERT_NULL(hash_map_set(swiss, key_buff, &test_nums[i % TEST_LEN]));
+    }
+    TEST_ASSERT_EQUAL_UINT(2000, swiss->count);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[0], hash_map_set(swiss, "key-0", &test_nums[1]));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[1], hash_map_get(swiss, "key-0"));
+    TEST_ASSERT_NULL(hash_map_get(swiss, "missing"));
+
+    // Remove half of the keys, twice, to fill table with deleted slots
+    for (int round = 0; round < 2; ++round){
+        for (int i = 0; i < 2000; i += 2){
+            sprintf(key_buff, "key-%d", i);
+            if (round == 0)
+                TEST_ASSERT_NOT_NULL(hash_map_pop(swiss, key_buff));
+            else
+                TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_remove(swiss, key_buff, free_counter));
+            TEST_ASSERT_NULL(hash_map_get(swiss, key_buff));
+            TEST_ASSERT_EQUAL_INT(CLIB_ERROR, hash_map_remove(swiss, key_buff, free_counter));
+        }
+        for (int i = 0; i < 2000; i += 2){
+            sprintf(key_buff, "key-%d", i);
+            hash_map_set(swiss, key_buff, &removed);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(1000, removed);
+    TEST_ASSERT_EQUAL_UINT(2000, swiss->count);
+    for (int i = 0; i < 2000; ++i){
+        sprintf(key_buff, "key-%d", i);
+        TEST_ASSERT_EQUAL_PTR(i % 2 ? &test_nums[i % TEST_LEN] : &removed, hash_map_get(swiss, key_buff));
+    }
+    hash_map_destroy(swiss, NULL);
+}
+
+// ****************************************************************************************
+// test_hash_map_len_keys
+// ****************************************************************************************
+/**
+ *  Check length aware API with binary keys pointing into a shared buffer
+ *
+ * Function under testing:
+ *  #hash_map_set_len
+ *  #hash_map_get_len
+ *  #hash_map_pop_len
+ *  #hash_map_remove_len
+ *
+ * Check:
+ * 	- Keys with embedded NUL bytes and keys which are prefixes of others are different
+ * 	- Keys are copied on insertion, so the source buffer can be reused
+ * 	- String API finds keys set with the length API
+ */
+// ****************************************************************************************
+void test_hash_map_len_keys(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        HashMap *len_map = create_hash_map_engine(4, engines[e]);
+        char buffer[] = "ab\0cab\0dab";
+
+        hash_map_set_len(len_map, buffer, 4, &test_nums[1]);        // "ab\0c"
+        hash_map_set_len(len_map, buffer + 4, 4, &test_nums[2]);    // "ab\0d"
+        hash_map_set_len(len_map, buffer + 8, 2, &test_nums[3]);    // "ab"
+        memset(buffer, 'x', sizeof(buffer));
+
+        TEST_ASSERT_EQUAL_UINT(3, len_map->count);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[1], hash_map_get_len(len_map, "ab\0c", 4));
+        TEST_ASSERT_EQUAL_PTR(&test_nums[2], hash_map_get_len(len_map, "ab\0d", 4));
+        TEST_ASSERT_EQUAL_PTR(&test_nums[3], hash_map_get(len_map, "ab"));
+        TEST_ASSERT_NULL(hash_map_get_len(len_map, "ab\0", 3));
+        TEST_ASSERT_NULL(hash_map_get_len(len_map, "a", 1));
+
+        TEST_ASSERT_EQUAL_PTR(&test_nums[2], hash_map_pop_len(len_map, "ab\0d", 4));
+        TEST_ASSERT_NULL(hash_map_pop_len(len_map, "ab\0d", 4));
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_remove_len(len_map, "ab\0c", 4, NULL));
+        TEST_ASSERT_EQUAL_INT(CLIB_ERROR, hash_map_remove_len(len_map, "ab\0c", 4, NULL));
+        TEST_ASSERT_EQUAL_PTR(&test_nums[3], hash_map_get_len(len_map, "ab", 2));
+        TEST_ASSERT_EQUAL_UINT(1, len_map->count);
+        hash_map_destroy(len_map, NULL);
+    }
+}
+
+// ****************************************************************************************
+// test_hash_map_key_storage
+// ****************************************************************************************
+/**
+ *  Check short keys are stored inline on their node and long keys on the map arena
+ *
+ * Function under testing:
+ *  #hash_map_set
+ *  #hash_map_get
+ *
+ * Check:
+ * 	- Keys are copied, so the source buffer can be reused between insertions
+ * 	- Only keys shorter than MAP_NODE_INLINE_KEY are stored inside their node
+ * 	- Long keys make the map allocate its key arena
+ */
+// ****************************************************************************************
+void test_hash_map_key_storage(void){
+    HashMap *key_map = create_hash_map(2);
+    char key[64];
+
+    for (int i = 0; i < 1000; ++i){
+        snprintf(key, sizeof(key), i % 2 ? "%d" : "a long key that must live on the arena %d", i);
+        hash_map_set(key_map, key, &test_nums[i % 10]);
+    }
+    for (int i = 0; i < 1000; ++i){
+        snprintf(key, sizeof(key), i % 2 ? "%d" : "a long key that must live on the arena %d", i);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i % 10], hash_map_get(key_map, key));
+    }
+
+    // Every short key is stored inside its node
+    int inline_keys = 0;
+    for (int i = 0; i < key_map->size; ++i){
+        for (MapNode *node = key_map->list[i]; node; node = node->next){
+            TEST_ASSERT_TRUE((node->key == node->key_data) == (node->key_len < MAP_NODE_INLINE_KEY));
+            inline_keys += node->key == node->key_data;
+        }
+    }
+    for (int i = 0; key_map->old_list && i < key_map->old_size; ++i){
+        for (MapNode *node = key_map->old_list[i]; node; node = node->next)
+            inline_keys += node->key == node->key_data;
+    }
+    TEST_ASSERT_EQUAL_INT(500, inline_keys);
+    TEST_ASSERT_NOT_NULL(key_map->key_arena);
+    hash_map_destroy(key_map, NULL);
+}
+
+// ****************************************************************************************
+// test_hash_map_key_churn
+// ****************************************************************************************
+/**
+ *  Check key storage of removed pairs is reused under steady insert / remove churn
+ *
+ * Function under testing:
+ *  #hash_map_set
+ *  #hash_map_pop
+ *  #hash_map_stats
+ *
+ * Check:
+ * 	- Cycling many more keys than the map holds at once does not grow its key arena
+ * 	- Long keys with their own allocation are given back too
+ */
+// ****************************************************************************************
+#define CHURN_LIVE          (1000)
+#define CHURN_KEYS          (100 * CHURN_LIVE)
+
+/// Write the #i th churn key on #key: 40 bytes, and 600 bytes for every 8th key
+void churn_key(char *key, unsigned int i){
+    int len = snprintf(key, 48, "session-%032u", i);
+    if (i % 8 == 0){
+        memset(key + len, 'x', 600 - (size_t)len);
+        key[600] = '\0';
+    }
+}
+
+void test_hash_map_key_churn(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        HashMap *churn = create_hash_map_engine(CHURN_LIVE, engines[e]);
+        HashMapStats stats;
+        size_t filled = 0;
+        char key[640];
+
+        for (unsigned int i = 0; i < CHURN_KEYS; ++i){
+            churn_key(key, i);
+            TEST_ASSERT_NULL(hash_map_set(churn, key, &test_nums[i % 10]));
+            if (i >= CHURN_LIVE){
+                churn_key(key, i - CHURN_LIVE);
+                TEST_ASSERT_EQUAL_PTR(&test_nums[(i - CHURN_LIVE) % 10], hash_map_pop(churn, key));
+            }
+            if (i == 2 * CHURN_LIVE){
+                hash_map_stats(churn, &stats);
+                filled = stats.key_arena_bytes;
+            }
+        }
+        TEST_ASSERT_EQUAL_UINT(CHURN_LIVE, churn->count);
+        hash_map_stats(churn, &stats);
+        TEST_ASSERT_TRUE(filled > 0);
+        TEST_ASSERT_EQUAL_UINT64(filled, stats.key_arena_bytes);
+        hash_map_destroy(churn, NULL);
+    }
+}
+
+// ****************************************************************************************
+// test_generic_hash_map
+// ****************************************************************************************
+/**
+ *  Check Hash Map with integer keys given by pointer and user callbacks
+ *
+ * Function under testing:
+ *  #create_generic_hash_map
+ *  #generic_hash_map_set
+ *  #generic_hash_map_get
+ *  #generic_hash_map_pop
+ *  #generic_hash_map_remove
+ *
+ * Check:
+ * 	- Keys are compared by content, not by pointer
+ * 	- Map grows past its initial size keeping every pair
+ */
+// ****************************************************************************************
+void test_generic_hash_map(void){
+    static int keys[1000];
+    int removed = 0;
+    GenericHashMap *int_keys = create_generic_hash_map(2, HASH_INT, COMPARE_INT);
+
+    TEST_ASSERT_NOT_NULL(int_keys);
+    for (int i = 0; i < 1000; ++i){
+        keys[i] = i * 7;
+        TEST_ASSERT_NULL(generic_hash_map_set(int_keys, &keys[i], &test_nums[i % TEST_LEN]));
+    }
+    TEST_ASSERT_EQUAL_UINT(1000, int_keys->count);
+    TEST_ASSERT_TRUE(int_keys->size >= 1000);
+    for (int i = 0; i < 1000; ++i){
+        int key = i * 7;
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i % TEST_LEN], generic_hash_map_get(int_keys, &key));
+    }
+    int key = 1;
+    TEST_ASSERT_NULL(generic_hash_map_get(int_keys, &key));
+    key = 7;
+    TEST_ASSERT_EQUAL_PTR(&test_nums[1], generic_hash_map_set(int_keys, &key, &removed));
+    TEST_ASSERT_EQUAL_PTR(&removed, generic_hash_map_pop(int_keys, &key));
+    TEST_ASSERT_NULL(generic_hash_map_pop(int_keys, &key));
+    key = 14;
+    TEST_ASSERT_EQUAL_INT(CLIB_OK, generic_hash_map_remove(int_keys, &key, free_counter));
+    TEST_ASSERT_EQUAL_INT(CLIB_ERROR, generic_hash_map_remove(int_keys, &key, free_counter));
+    TEST_ASSERT_EQUAL_INT(3, test_nums[2]);
+    test_nums[2] = 2;
+    TEST_ASSERT_EQUAL_UINT(998, int_keys->count);
+    generic_hash_map_destroy(int_keys, NULL);
+
+    GenericHashMap *string_keys = create_generic_hash_map(4, HASH_STRING, COMPARE_STRING);
+    char key_buff[] = "key", same_key[] = "key";
+    generic_hash_map_set(string_keys, key_buff, &test_nums[3]);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[3], generic_hash_map_get(string_keys, same_key));
+    generic_hash_map_destroy(string_keys, NULL);
+}
+
+// ****************************************************************************************
+// test_int_hash_map
+// ****************************************************************************************
+/**
+ *  Check Hash Map with 64 bit integer keys against a plain array
+ *
+ * Function under testing:
+ *  #create_int_hash_map
+ *  #int_hash_map_set
+ *  #int_hash_map_get
+ *  #int_hash_map_pop
+ *  #int_hash_map_remove
+ *  #int_hash_map_reserve
+ *
+ * Check:
+ * 	- Key 0 is a valid key
+ * 	- Pairs are still found after random removals shift back their probe sequences
+ */
+// ****************************************************************************************
+void test_int_hash_map(void){
+    enum { KEYS = 4096 };
+    static bool present[KEYS];
+    int removed = 0;
+    IntHashMap *ints = create_int_hash_map(0);
+    uint64_t rand_state = 1;
+
+    TEST_ASSERT_NOT_NULL(ints);
+    TEST_ASSERT_NULL(int_hash_map_get(ints, 0));
+    TEST_ASSERT_NULL(int_hash_map_set(ints, 0, &test_nums[0]));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[0], int_hash_map_get(ints, 0));
+    TEST_ASSERT_EQUAL_UINT(1, ints->count);
+
+    memset(present, 0, sizeof(present));
+    present[0] = true;
+    for (int op = 0; op < 100000; ++op){
+        rand_state = rand_state * 6364136223846793005ull + 1442695040888963407ull;
+        uint64_t key = (rand_state >> 33) % KEYS;
+        if ((rand_state >> 20) % 3){
+            TEST_ASSERT_EQUAL_PTR(present[key] ? &test_nums[key % (uint64_t)TEST_LEN] : NULL,
+                                  int_hash_map_set(ints, key, &test_nums[key % (uint64_t)TEST_LEN]));
+            present[key] = true;
+        } else {
+            TEST_ASSERT_EQUAL_PTR(present[key] ? &test_nums[key % (uint64_t)TEST_LEN] : NULL,
+                                  int_hash_map_pop(ints, key));
+            present[key] = false;
+        }
+    }
+    unsigned int count = 0;
+    for (uint64_t key = 0; key < KEYS; ++key){
+        count += present[key];
+        TEST_ASSERT_EQUAL_PTR(present[key] ? &test_nums[key % (uint64_t)TEST_LEN] : NULL, int_hash_map_get(ints, key));
+    }
+    TEST_ASSERT_EQUAL_UINT(count, ints->count);
+
+    TEST_ASSERT_EQUAL_INT(CLIB_OK, int_hash_map_reserve(ints, 100000));
+    TEST_ASSERT_NULL(int_hash_map_set(ints, UINT64_MAX, &removed));
+    TEST_ASSERT_EQUAL_INT(CLIB_OK, int_hash_map_remove(ints, UINT64_MAX, free_counter));
+    TEST_ASSERT_EQUAL_INT(CLIB_ERROR, int_hash_map_remove(ints, UINT64_MAX, free_counter));
+    TEST_ASSERT_EQUAL_INT(1, removed);
+    for (uint64_t key = 0; key < KEYS; ++key)
+        TEST_ASSERT_EQUAL_PTR(present[key] ? &test_nums[key % (uint64_t)TEST_LEN] : NULL, int_hash_map_get(ints, key));
+    int_hash_map_destroy(ints, NULL);
+}
+
+// ****************************************************************************************
+// test_hash_map_upsert
+// ****************************************************************************************
+/**
+ *  Check single probe read-modify-write API counting repeated words
+ *
+ * Function under testing:
+ *  #hash_map_get_or_insert
+ *  #hash_map_get_or_insert_len
+ *  #hash_map_update
+ *
+ * Check:
+ * 	- New keys get a NULL value slot, existing keys their current slot
+ * 	- Update function receives current value and its result is stored
+ */
+// ****************************************************************************************
+void * add_ctx(void *value, void *ctx){
+    return (void *)((uintptr_t)value + (uintptr_t)*(int *)ctx);
+}
+
+void test_hash_map_upsert(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    char key_buff[16];
+    int step = 2;
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        HashMap *counters = create_hash_map_engine(1, engines[e]);
+
+        for (int i = 0; i < 3000; ++i){
+            sprintf(key_buff, "word-%d", i % 100);
+            void **slot = hash_map_get_or_insert(counters, key_buff);
+            TEST_ASSERT_NOT_NULL(slot);
+            if (i < 100)
+                TEST_ASSERT_NULL(*slot);
+            *slot = (void *)((uintptr_t)*slot + 1);
+        }
+        TEST_ASSERT_EQUAL_UINT(100, counters->count);
+        TEST_ASSERT_EQUAL_PTR((void *)30, hash_map_get(counters, "word-42"));
+
+        TEST_ASSERT_EQUAL_PTR((void *)32, hash_map_update(counters, "word-42", add_ctx, &step));
+        TEST_ASSERT_EQUAL_PTR((void *)2, hash_map_update(counters, "new", add_ctx, &step));
+        TEST_ASSERT_EQUAL_PTR((void *)32, *hash_map_get_or_insert_len(counters, "word-42-suffix", 7));
+        TEST_ASSERT_EQUAL_UINT(101, counters->count);
+        hash_map_destroy(counters, NULL);
+    }
+}
+
+// ****************************************************************************************
+// test_hash_map_many
+// ****************************************************************************************
+/**
+ *  Check batched set and get, with batches not multiple of the internal batch size
+ *
+ * Function under testing:
+ *  #hash_map_set_many
+ *  #hash_map_get_many
+ *
+ * Check:
+ * 	- Every key of the batch gets its own value, missing keys get NULL
+ * 	- Repeated keys on a batch keep the last value
+ */
+// ****************************************************************************************
+void test_hash_map_many(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    enum { N = 1000 };
+    static char key_buff[N][40];
+    const char *keys[N];
+    void *values[N], *out[N];
+
+    for (int i = 0; i < N; ++i){
+        // Half of the keys are long enough to live on the key arena
+        sprintf(key_buff[i], i % 2 ? "key-%d" : "a longer key outside the node %d", i);
+        keys[i] = key_buff[i];
+        values[i] = &test_nums[i % TEST_LEN];
+    }
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        HashMap *batched = create_hash_map_engine(1, engines[e]);
+
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_set_many(batched, keys, values, N - 1));
+        TEST_ASSERT_EQUAL_UINT(N - 1, batched->count);
+        hash_map_get_many(batched, keys, N, out);
+        for (int i = 0; i < N - 1; ++i)
+            TEST_ASSERT_EQUAL_PTR(values[i], out[i]);
+        TEST_ASSERT_NULL(out[N - 1]);
+
+        keys[1] = keys[0];
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_set_many(batched, keys, values, 3));
+        TEST_ASSERT_EQUAL_PTR(values[1], hash_map_get(batched, keys[0]));
+        keys[1] = key_buff[1];
+        hash_map_destroy(batched, NULL);
+    }
+}
+
+// ****************************************************************************************
+// test_concurrent_hash_map
+// ****************************************************************************************
+/**
+ *  Check Concurrent Hash Map with several threads inserting, updating and removing
+ *
+ * Function under testing:
+ *  #create_concurrent_hash_map
+ *  #concurrent_hash_map_set
+ *  #concurrent_hash_map_get
+ *  #concurrent_hash_map_update
+ *  #concurrent_hash_map_pop
+ *  #concurrent_hash_map_remove
+ *
+ * Check:
+ * 	- No update of shared counters is lost
+ * 	- Keys of every thread survive table doubling made by other threads
+ */
+// ****************************************************************************************
+#define CONCURRENT_THREADS  (4)
+#define CONCURRENT_KEYS     (5000)
+
+ConcurrentHashMap *shared_map;
+
+void * add_one(void *value, void *ctx){
+    (void)ctx;
+    return (void *)((uintptr_t)value + 1);
+}
+
+void * concurrent_worker(void *arg){
+    int id = *(int *)arg;
+    char key_buff[32];
+    for (int i = 0; i < CONCURRENT_KEYS; ++i){
+        sprintf(key_buff, "thread-%d-key-%d", id, i);
+        concurrent_hash_map_set(shared_map, key_buff, &test_nums[id]);
+        sprintf(key_buff, "shared-%d", i % 10);
+        concurrent_hash_map_update(shared_map, key_buff, add_one, NULL);
+    }
+    for (int i = 0; i < CONCURRENT_KEYS; i += 2){
+        sprintf(key_buff, "thread-%d-key-%d", id, i);
+        if (concurrent_hash_map_pop(shared_map, key_buff) != &test_nums[id])
+            return NULL;
+    }
+    return arg;
+}
+
+void test_concurrent_hash_map(void){
+    pthread_t threads[CONCURRENT_THREADS];
+    int ids[CONCURRENT_THREADS];
+    char key_buff[32];
+
+    shared_map = create_concurrent_hash_map(1);
+    TEST_ASSERT_NOT_NULL(shared_map);
+    for (int t = 0; t < CONCURRENT_THREADS; ++t){
+        ids[t] = t;
+        pthread_create(&threads[t], NULL, concurrent_worker, &ids[t]);
+    }
+    for (int t = 0; t < CONCURRENT_THREADS; ++t){
+        void *result;
+        pthread_join(threads[t], &result);
+        TEST_ASSERT_EQUAL_PTR(&ids[t], result);
+    }
+
+    TEST_ASSERT_EQUAL_UINT(CONCURRENT_THREADS * CONCURRENT_KEYS / 2 + 10, concurrent_hash_map_count(shared_map));
+    TEST_ASSERT_TRUE(shared_map->size > CONCURRENT_MAP_STRIPES);
+    for (int i = 0; i < 10; ++i){
+        sprintf(key_buff, "shared-%d", i);
+        TEST_ASSERT_EQUAL_PTR((void *)(uintptr_t)(CONCURRENT_THREADS * CONCURRENT_KEYS / 10),
+                              concurrent_hash_map_get(shared_map, key_buff));
+    }
+    for (int t = 0; t < CONCURRENT_THREADS; ++t){
+        for (int i = 0; i < CONCURRENT_KEYS; ++i){
+            sprintf(key_buff, "thread-%d-key-%d", t, i);
+            TEST_ASSERT_EQUAL_PTR(i % 2 ? &test_nums[t] : NULL, concurrent_hash_map_get(shared_map, key_buff));
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(CLIB_OK, concurrent_hash_map_remove(shared_map, "shared-0", NULL));
+    TEST_ASSERT_EQUAL_INT(CLIB_ERROR, concurrent_hash_map_remove(shared_map, "shared-0", NULL));
+    concurrent_hash_map_destroy(shared_map, NULL);
+}
+
+// ****************************************************************************************
+// test_rcu_hash_map
+// ****************************************************************************************
+/**
+ *  Check RCU Hash Map with lock free readers while a writer replaces and removes values
+ *
+ * Function under testing:
+ *  #create_rcu_hash_map
+ *  #rcu_hash_map_register_reader
+ *  #rcu_hash_map_quiescent
+ *  #rcu_hash_map_get
+ *  #rcu_hash_map_set
+ *  #rcu_hash_map_remove
+ *  #rcu_hash_map_synchronize
+ *
+ * Check:
+ * 	- Readers never see a freed value (values are poisoned when freed)
+ * 	- Every replaced and removed value is freed after synchronize
+ */
+// ****************************************************************************************
+#define RCU_READERS         (3)
+#define RCU_KEYS            (64)
+#define RCU_ALIVE           (0x600DCAFE)
+
+RcuHashMap *rcu_map;
+int rcu_stop;
+int rcu_freed;
+
+void poison_value(void *value){
+    *(unsigned int *)value = 0xDEAD;
+    free(value);
+    __atomic_add_fetch(&rcu_freed, 1, __ATOMIC_RELAXED);
+}
+
+void * rcu_reader_worker(void *arg){
+    RcuReader *reader = rcu_hash_map_register_reader(rcu_map);
+    char key_buff[16];
+    uintptr_t bad = 0;
+    (void)arg;
+    for (unsigned int i = 0; !__atomic_load_n(&rcu_stop, __ATOMIC_ACQUIRE); ++i){
+        sprintf(key_buff, "k%u", i % RCU_KEYS);
+        unsigned int *value = rcu_hash_map_get(rcu_map, key_buff);
+        bad += value && *value != RCU_ALIVE;
+        if (i % 16 == 0)
+            rcu_hash_map_quiescent(rcu_map, reader);
+    }
+    rcu_hash_map_unregister_reader(rcu_map, reader);
+    return (void *)bad;
+}
+
+unsigned int * alive_value(void){
+    unsigned int *value = malloc(sizeof(unsigned int));
+    *value = RCU_ALIVE;
+    return value;
+}
+
+void test_rcu_hash_map(void){
+    pthread_t threads[RCU_READERS];
+    char key_buff[16];
+    int allocated = 0;
+
+    rcu_map = create_rcu_hash_map(1, poison_value);
+    TEST_ASSERT_NOT_NULL(rcu_map);
+    rcu_stop = 0;
+    rcu_freed = 0;
+    for (int t = 0; t < RCU_READERS; ++t)
+        pthread_create(&threads[t], NULL, rcu_reader_worker, NULL);
+
+    for (int i = 0; i < 20000; ++i){
+        sprintf(key_buff, "k%d", (i * 7) % RCU_KEYS);
+        if (i % 5 == 4){
+            rcu_hash_map_remove(rcu_map, key_buff);
+        } else {
+            TEST_ASSERT_EQUAL_INT(CLIB_OK, rcu_hash_map_set(rcu_map, key_buff, alive_value()));
+            allocated++;
+        }
+    }
+    __atomic_store_n(&rcu_stop, 1, __ATOMIC_RELEASE);
+    for (int t = 0; t < RCU_READERS; ++t){
+        void *bad;
+        pthread_join(threads[t], &bad);
+        TEST_ASSERT_NULL(bad);
+    }
+
+    rcu_hash_map_synchronize(rcu_map);
+    TEST_ASSERT_EQUAL_INT(allocated - (int)rcu_map->count, rcu_freed);
+    TEST_ASSERT_TRUE(rcu_map->table != NULL);
+    sprintf(key_buff, "k%d", (19998 * 7) % RCU_KEYS);   // Last set key
+    TEST_ASSERT_NOT_NULL(rcu_hash_map_get(rcu_map, key_buff));
+    rcu_hash_map_destroy(rcu_map);
+    TEST_ASSERT_EQUAL_INT(allocated, rcu_freed);
+}
+
+// ****************************************************************************************
+// test_hash_map_iterator
+// ****************************************************************************************
+/**
+ *  Check iterator and foreach visit every pair once on both engines
+ *
+ * Function under testing:
+ *  #hash_map_iter_begin
+ *  #hash_map_iter_next
+ *  #hash_map_foreach
+ *
+ * Check:
+ * 	- Every pair is visited exactly once, including during a pending incremental rehash
+ * 	- Removed pairs and emptied entries are not visited
+ * 	- Empty map yields no pair
+ */
+// ****************************************************************************************
+void sum_visitor(const char *key, size_t key_len, void *value, void *ctx){
+    (void)key;
+    (void)key_len;
+    *(long *)ctx += *(int *)value;
+}
+
+void test_hash_map_iterator(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    enum { N = 3000 };
+    static int values[N];
+    static bool seen[N];
+    char key_buff[32];
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        HashMap *iter_map = create_hash_map_engine(1, engines[e]);
+        HashMapIter it;
+        long sum = 0, expected = 0;
+
+        hash_map_iter_begin(iter_map, &it);
+        TEST_ASSERT_FALSE(hash_map_iter_next(&it));
+
+        for (int i = 0; i < N; ++i){
+            values[i] = i;
+            sprintf(key_buff, "key-%d", i);
+            hash_map_set(iter_map, key_buff, &values[i]);
+        }
+        for (int i = 0; i < N; i += 3){
+            sprintf(key_buff, "key-%d", i);
+            hash_map_remove(iter_map, key_buff, NULL);
+        }
+        for (int i = 0; i < N; ++i)
+            expected += i % 3 ? i : 0;
+
+        // Foreach first, it must also visit entries of a pending rehash
+        hash_map_foreach(iter_map, sum_visitor, &sum);
+        TEST_ASSERT_EQUAL_INT((int)expected, (int)sum);
+
+        memset(seen, 0, sizeof(seen));
+        unsigned int visited = 0;
+        hash_map_iter_begin(iter_map, &it);
+        while (hash_map_iter_next(&it)){
+            int i = *(int *)it.value;
+            sprintf(key_buff, "key-%d", i);
+            TEST_ASSERT_EQUAL_STRING(key_buff, it.key);
+            TEST_ASSERT_EQUAL_UINT(strlen(key_buff), it.key_len);
+            TEST_ASSERT_FALSE(seen[i]);
+            TEST_ASSERT_TRUE(i % 3);
+            seen[i] = true;
+            visited++;
+        }
+        TEST_ASSERT_EQUAL_UINT(iter_map->count, visited);
+        TEST_ASSERT_FALSE(hash_map_iter_next(&it));
+        hash_map_destroy(iter_map, NULL);
+    }
+}
+
+// ****************************************************************************************
+// test_hash_map_stats
+// ****************************************************************************************
+/**
+ *  Check table occupancy and operation counters reported for both engines
+ *
+ * Function under testing:
+ *  #hash_map_stats
+ *
+ * Check:
+ * 	- Histogram accounts for every entry (chained) or pair (swiss)
+ * 	- Counters are only reported when built with CLIB_HASH_MAP_STATS
+ */
+// ****************************************************************************************
+void test_hash_map_stats(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    char key_buff[32];
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        HashMap *stats_map = create_hash_map_engine(64, engines[e]);
+        HashMapStats stats;
+        unsigned int total = 0, pairs = 0;
+
+        for (int i = 0; i < 1000; ++i){
+            sprintf(key_buff, "key-%d", i);
+            hash_map_set(stats_map, key_buff, &test_nums[1]);
+        }
+        for (int i = 0; i < 2000; ++i){
+            sprintf(key_buff, "key-%d", i);
+            hash_map_get(stats_map, key_buff);
+        }
+        hash_map_reserve(stats_map, 1000);      // Finish any pending rehash
+        hash_map_stats(stats_map, &stats);
+
+        TEST_ASSERT_EQUAL_UINT(1000, stats.count);
+        TEST_ASSERT_EQUAL_INT(stats_map->size, stats.size);
+        TEST_ASSERT_TRUE(stats.load_factor > 0 && stats.load_factor <= 1.0f);
+        TEST_ASSERT_TRUE(stats.max_chain >= 1);
+        for (int i = 0; i < HASH_MAP_STATS_HISTOGRAM; ++i){
+            total += stats.chain_histogram[i];
+            pairs += stats.chain_histogram[i] * (unsigned int)i;
+        }
+        if (engines[e] == HASH_MAP_CHAINED){
+            TEST_ASSERT_EQUAL_UINT((unsigned int)stats.size, total);
+            if (stats.max_chain < HASH_MAP_STATS_HISTOGRAM)
+                TEST_ASSERT_EQUAL_UINT(1000, pairs);
+        } else {
+            TEST_ASSERT_EQUAL_UINT(1000, total);
+        }
+
+#ifdef CLIB_HASH_MAP_STATS
+        TEST_ASSERT_TRUE(stats.counters);
+        TEST_ASSERT_EQUAL_UINT(2000, stats.gets);
+        TEST_ASSERT_EQUAL_UINT(1000, stats.sets);
+        // Half of the gets hit, and a hit compares its key at least once
+        TEST_ASSERT_TRUE(stats.compares_per_get >= 0.5 && stats.compares_per_get < 0.6);
+        TEST_ASSERT_TRUE(stats.probes_per_get >= stats.compares_per_get);
+        TEST_ASSERT_TRUE(stats.compares_per_set < 0.1);
+#else
+        TEST_ASSERT_FALSE(stats.counters);
+        TEST_ASSERT_EQUAL_UINT(0, stats.gets);
+#endif
+        hash_map_destroy(stats_map, NULL);
+    }
+}
+
+// ****************************************************************************************
+// test_hash_map_mapped
+// ****************************************************************************************
+/**
+ *  Save maps of both engines and answer lookups from the mapped image
+ *
+ * Function under testing:
+ *  #hash_map_save
+ *  #hash_map_open_mapped
+ *
+ * Check:
+ * 	- Every pair is found with its encoded value, missing keys are not
+ * 	- Mapped map is read only
+ * 	- Files which are not images are rejected
+ */
+// ****************************************************************************************
+void test_hash_map_mapped(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    static const char *path = "hash-map-tests.img";
+    char key_buff[64], value_buff[64];
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        HashMap *source = create_hash_map_engine(16, engines[e]);
+        for (int i = 0; i < 3000; ++i){
+            sprintf(key_buff, i % 2 ? "key-%d" : "a-much-longer-key-than-inline-%d", i);
+            sprintf(value_buff, "value-%d", i);
+            hash_map_set(source, key_buff, strdup(value_buff));
+        }
+        hash_map_set_len(source, "bin\0key", 7, strdup("binary"));
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_save(source, path, &VALUE_CODEC_STRING));
+
+        HashMap *mapped = hash_map_open_mapped(path);
+        TEST_ASSERT_NOT_NULL(mapped);
+        TEST_ASSERT_EQUAL_INT(HASH_MAP_MAPPED, mapped->engine);
+        TEST_ASSERT_EQUAL_UINT(3001, mapped->count);
+        for (int i = 0; i < 3000; ++i){
+            sprintf(key_buff, i % 2 ? "key-%d" : "a-much-longer-key-than-inline-%d", i);
+            sprintf(value_buff, "value-%d", i);
+            char *value = hash_map_get(mapped, key_buff);
+            TEST_ASSERT_NOT_NULL(value);
+            TEST_ASSERT_EQUAL_STRING(value_buff, value);
+            TEST_ASSERT_EQUAL_INT(0, (int)((uintptr_t)value % 8));
+        }
+        TEST_ASSERT_EQUAL_STRING("binary", hash_map_get_len(mapped, "bin\0key", 7));
+        TEST_ASSERT_NULL(hash_map_get(mapped, "bin"));
+        TEST_ASSERT_NULL(hash_map_get(mapped, "key-3000"));
+
+        // Batched lookups and iteration read the image too
+        const char *keys[2] = { "key-1", "missing" };
+        void *values[2];
+        hash_map_get_many(mapped, keys, 2, values);
+        TEST_ASSERT_EQUAL_STRING("value-1", values[0]);
+        TEST_ASSERT_NULL(values[1]);
+        HashMapIter it;
+        unsigned int visited = 0;
+        hash_map_iter_begin(mapped, &it);
+        while (hash_map_iter_next(&it)){
+            TEST_ASSERT_EQUAL_PTR(it.value, hash_map_get_len(mapped, it.key, it.key_len));
+            visited++;
+        }
+        TEST_ASSERT_EQUAL_UINT(3001, visited);
+
+        // Read only
+        TEST_ASSERT_NULL(hash_map_set(mapped, "new", &test_nums[0]));
+        TEST_ASSERT_NULL(hash_map_get(mapped, "new"));
+        TEST_ASSERT_EQUAL_INT(CLIB_ERROR, hash_map_remove(mapped, "key-1", NULL));
+        TEST_ASSERT_NULL(hash_map_pop(mapped, "key-1"));
+        TEST_ASSERT_EQUAL_UINT(3001, mapped->count);
+
+        hash_map_destroy(mapped, NULL);
+        hash_map_destroy(source, free);
+    }
+
+    // Empty maps and keys only images
+    HashMap *empty = create_hash_map(4);
+    TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_save(empty, path, NULL));
+    HashMap *mapped = hash_map_open_mapped(path);
+    TEST_ASSERT_NOT_NULL(mapped);
+    TEST_ASSERT_EQUAL_UINT(0, mapped->count);
+    TEST_ASSERT_NULL(hash_map_get(mapped, "key"));
+    hash_map_destroy(mapped, NULL);
+    hash_map_destroy(empty, NULL);
+
+    // Not an image
+    FILE *file = fopen(path, "wb");
+    fputs("definitely not a hash map image, but long enough to hold a header......", file);
+    fclose(file);
+    TEST_ASSERT_NULL(hash_map_open_mapped(path));
+    remove(path);
+    TEST_ASSERT_NULL(hash_map_open_mapped(path));
+}
+
+// ****************************************************************************************
+// test_hash_map_compact
+// ****************************************************************************************
+/**
+ *  Check compact engine iterates pairs in insertion order
+ *
+ * Function under testing:
+ *  #create_hash_map_engine with #HASH_MAP_COMPACT
+ *
+ * Check:
+ * 	- Iteration follows insertion order across growth and removals
+ * 	- Updating a key keeps its place, removing and setting it again moves it to the end
+ * 	- Removed entries are compacted without losing pairs
+ */
+// ****************************************************************************************
+void test_hash_map_compact(void){
+    HashMap *compact = create_hash_map_engine(1, HASH_MAP_COMPACT);
+    char key_buff[32];
+    HashMapIter it;
+    int expected = 0;
+
+    for (int i = 0; i < 1000; ++i){
+        sprintf(key_buff, "%d", i);
+        hash_map_set(compact, key_buff, &test_nums[0]);
+    }
+    // Remove odd keys, update key 0 and move key 2 to the end
+    for (int i = 1; i < 1000; i += 2){
+        sprintf(key_buff, "%d", i);
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_remove(compact, key_buff, NULL));
+    }
+    TEST_ASSERT_EQUAL_PTR(&test_nums[0], hash_map_set(compact, "0", &test_nums[1]));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[0], hash_map_pop(compact, "2"));
+    hash_map_set(compact, "2", &test_nums[2]);
+    TEST_ASSERT_EQUAL_UINT(500, compact->count);
+
+    hash_map_iter_begin(compact, &it);
+    for (int i = 0; i < 1000; i += 2){
+        if (i == 2)
+            continue;
+        sprintf(key_buff, "%d", i);
+        TEST_ASSERT_TRUE(hash_map_iter_next(&it));
+        TEST_ASSERT_EQUAL_STRING(key_buff, it.key);
+    }
+    TEST_ASSERT_TRUE(hash_map_iter_next(&it));
+    TEST_ASSERT_EQUAL_STRING("2", it.key);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[2], it.value);
+    TEST_ASSERT_FALSE(hash_map_iter_next(&it));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[1], hash_map_get(compact, "0"));
+
+    // Refill the holes left by removals: array is compacted and order is kept
+    for (int i = 1000; i < 2000; ++i){
+        sprintf(key_buff, "%d", i);
+        hash_map_set(compact, key_buff, &test_nums[3]);
+    }
+    for (int i = 0; i < 2000; ++i){
+        sprintf(key_buff, "%d", i);
+        if (i < 1000 && i % 2)
+            TEST_ASSERT_NULL(hash_map_get(compact, key_buff));
+        else
+            TEST_ASSERT_NOT_NULL(hash_map_get(compact, key_buff));
+    }
+    hash_map_iter_begin(compact, &it);
+    while (hash_map_iter_next(&it)){
+        if (strcmp(it.key, "2") == 0)
+            expected = 1000;
+        else if (expected >= 1000){
+            sprintf(key_buff, "%d", expected++);
+            TEST_ASSERT_EQUAL_STRING(key_buff, it.key);
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(2000, expected);
+    hash_map_destroy(compact, NULL);
+}
+
+// ****************************************************************************************
+// test_hash_map_freeze
+// ****************************************************************************************
+/**
+ *  Freeze maps of every engine into a minimal perfect hash table
+ *
+ * Function under testing:
+ *  #hash_map_freeze
+ *
+ * Check:
+ * 	- Every pair is found after freezing, missing keys are not
+ * 	- Frozen map is read only and has one slot per pair
+ * 	- Mapped maps can not be frozen
+ */
+// ****************************************************************************************
+void test_hash_map_freeze(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    static const int counts[] = { 0, 1, 2, 5000 };
+    char key_buff[64];
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c){
+            HashMap *frozen = create_hash_map_engine(4, engines[e]);
+            HashMapStats stats;
+            for (int i = 0; i < counts[c]; ++i){
+                sprintf(key_buff, i % 3 ? "kw-%d" : "a-keyword-longer-than-a-node-%d", i);
+                hash_map_set(frozen, key_buff, &test_nums[i % 5]);
+            }
+            hash_map_set_len(frozen, "nul\0key", 7, &test_nums[0]);
+            TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_freeze(frozen));
+            TEST_ASSERT_EQUAL_INT(HASH_MAP_FROZEN, frozen->engine);
+            TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_freeze(frozen));
+
+            for (int i = 0; i < counts[c]; ++i){
+                sprintf(key_buff, i % 3 ? "kw-%d" : "a-keyword-longer-than-a-node-%d", i);
+                TEST_ASSERT_EQUAL_PTR(&test_nums[i % 5], hash_map_get(frozen, key_buff));
+            }
+            TEST_ASSERT_EQUAL_PTR(&test_nums[0], hash_map_get_len(frozen, "nul\0key", 7));
+            TEST_ASSERT_NULL(hash_map_get(frozen, "nul"));
+            for (int i = 0; i < 100; ++i){
+                sprintf(key_buff, "kw-%d", counts[c] + i);
+                TEST_ASSERT_NULL(hash_map_get(frozen, key_buff));
+            }
+            TEST_ASSERT_NULL(hash_map_get(frozen, ""));
+
+            // Read only, one slot per pair
+            TEST_ASSERT_NULL(hash_map_set(frozen, "new", &test_nums[0]));
+            TEST_ASSERT_NULL(hash_map_get(frozen, "new"));
+            TEST_ASSERT_EQUAL_INT(CLIB_ERROR, hash_map_remove(frozen, "nul", NULL));
+            TEST_ASSERT_EQUAL_UINT((unsigned int)counts[c] + 1, frozen->count);
+            hash_map_stats(frozen, &stats);
+            TEST_ASSERT_EQUAL_INT(counts[c] + 1, stats.size);
+            TEST_ASSERT_EQUAL_UINT(1, stats.max_chain);
+
+            unsigned int visited = 0;
+            HashMapIter it;
+            hash_map_iter_begin(frozen, &it);
+            while (hash_map_iter_next(&it)){
+                TEST_ASSERT_EQUAL_PTR(it.value, hash_map_get_len(frozen, it.key, it.key_len));
+                visited++;
+            }
+            TEST_ASSERT_EQUAL_UINT(frozen->count, visited);
+            hash_map_destroy(frozen, NULL);
+        }
+    }
+
+    HashMap *source = create_hash_map(4);
+    hash_map_set(source, "key", &test_nums[0]);
+    TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_save(source, "hash-map-tests.img", NULL));
+    HashMap *mapped = hash_map_open_mapped("hash-map-tests.img");
+    TEST_ASSERT_EQUAL_INT(CLIB_ERROR, hash_map_freeze(mapped));
+    TEST_ASSERT_NOT_NULL(hash_map_get(mapped, "key"));
+    hash_map_destroy(mapped, NULL);
+    hash_map_destroy(source, NULL);
+    remove("hash-map-tests.img");
+}
+
+// ****************************************************************************************
+// test_hash_map_cuckoo
+// ****************************************************************************************
+/**
+ *  Check cuckoo engine keeps every key on its two buckets or the stash
+ *
+ * Function under testing:
+ *  #create_hash_map_engine with #HASH_MAP_CUCKOO
+ *
+ * Check:
+ * 	- Pairs survive displacements and growth from the smallest table
+ * 	- No pair is further than its alternate bucket or the stash
+ * 	- Removed keys are not found and their slots are reused
+ */
+// ****************************************************************************************
+void test_hash_map_cuckoo(void){
+    HashMap *cuckoo = create_hash_map_engine(1, HASH_MAP_CUCKOO);
+    HashMapStats stats;
+    char key_buff[32];
+
+    for (int i = 0; i < 20000; ++i){
+        sprintf(key_buff, "cuckoo-%d", i);
+        TEST_ASSERT_NULL(hash_map_set(cuckoo, key_buff, &test_nums[i % 5]));
+    }
+    TEST_ASSERT_EQUAL_UINT(20000, cuckoo->count);
+    for (int i = 0; i < 20000; ++i){
+        sprintf(key_buff, "cuckoo-%d", i);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i % 5], hash_map_get(cuckoo, key_buff));
+    }
+    hash_map_stats(cuckoo, &stats);
+    TEST_ASSERT_TRUE(stats.max_chain <= 3);
+    TEST_ASSERT_EQUAL_UINT(20000, stats.chain_histogram[0] + stats.chain_histogram[1] + stats.chain_histogram[2]);
+    TEST_ASSERT_TRUE(stats.load_factor > 0.4f);
+
+    // Remove half of the keys and set them again: the table does not need to grow
+    int size = cuckoo->size;
+    for (int i = 0; i < 20000; i += 2){
+        sprintf(key_buff, "cuckoo-%d", i);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i % 5], hash_map_pop(cuckoo, key_buff));
+        TEST_ASSERT_NULL(hash_map_get(cuckoo, key_buff));
+    }
+    TEST_ASSERT_EQUAL_UINT(10000, cuckoo->count);
+    for (int i = 0; i < 20000; i += 2){
+        sprintf(key_buff, "cuckoo-%d", i);
+        hash_map_set(cuckoo, key_buff, &test_nums[0]);
+    }
+    TEST_ASSERT_EQUAL_INT(size, cuckoo->size);
+    for (int i = 0; i < 20000; ++i){
+        sprintf(key_buff, "cuckoo-%d", i);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i % 2 ? i % 5 : 0], hash_map_get(cuckoo, key_buff));
+    }
+    hash_map_destroy(cuckoo, NULL);
+}
+
+// ****************************************************************************************
+// test_hash_map_filter
+// ****************************************************************************************
+/**
+ *  Guard maps of every engine with a Bloom filter of their keys
+ *
+ * Function under testing:
+ *  #hash_map_enable_filter
+ *
+ * Check:
+ * 	- Keys set before and after enabling the filter are always found
+ * 	- Removed keys are not found, also after the filter is rebuilt
+ * 	- Most absent keys are rejected, and stats report the filter
+ */
+// ****************************************************************************************
+void test_hash_map_filter(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    char key_buff[32];
+    const char *keys[4];
+    void *values[4];
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        HashMap *filtered = create_hash_map_engine(4, engines[e]);
+        HashMapStats stats;
+        unsigned int passed = 0;
+
+        for (int i = 0; i < 1000; ++i){
+            sprintf(key_buff, "key-%d", i);
+            hash_map_set(filtered, key_buff, &test_nums[i % 5]);
+        }
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_enable_filter(filtered, HASH_MAP_FILTER_BITS_PER_KEY));
+        // Filter grows with the map
+        for (int i = 1000; i < 10000; ++i){
+            sprintf(key_buff, "key-%d", i);
+            if (i % 2)
+                hash_map_set(filtered, key_buff, &test_nums[i % 5]);
+            else
+                *hash_map_get_or_insert(filtered, key_buff) = &test_nums[i % 5];
+        }
+        for (int i = 0; i < 10000; ++i){
+            sprintf(key_buff, "key-%d", i);
+            TEST_ASSERT_EQUAL_PTR(&test_nums[i % 5], hash_map_get(filtered, key_buff));
+        }
+        for (int i = 0; i < 10000; ++i){
+            sprintf(key_buff, "absent-%d", i);
+            passed += hash_map_get(filtered, key_buff) == NULL ? 0 : 1;
+            TEST_ASSERT_EQUAL_INT(CLIB_ERROR, hash_map_remove(filtered, key_buff, NULL));
+        }
+        TEST_ASSERT_EQUAL_UINT(0, passed);
+
+        hash_map_stats(filtered, &stats);
+        TEST_ASSERT_TRUE(stats.filter_bytes >= 10000 * HASH_MAP_FILTER_BITS_PER_KEY / 8);
+        TEST_ASSERT_TRUE(stats.filter_fpr > 0 && stats.filter_fpr < 0.03);
+#ifdef CLIB_HASH_MAP_STATS
+        TEST_ASSERT_TRUE(stats.filter_rejects > 9000);
+        TEST_ASSERT_TRUE(stats.filter_measured_fpr < 0.05);
+#else
+        TEST_ASSERT_EQUAL_UINT(0, stats.filter_rejects);
+#endif
+
+        // Removals rebuild the filter: remaining keys stay, removed ones go
+        for (int i = 0; i < 10000; i += 4){
+            sprintf(key_buff, "key-%d", i);
+            TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_remove(filtered, key_buff, NULL));
+        }
+        for (int i = 0; i < 10000; i += 4){
+            sprintf(key_buff, "key-%d", i);
+            TEST_ASSERT_NULL(hash_map_pop(filtered, key_buff));
+        }
+        keys[0] = "key-1"; keys[1] = "key-4"; keys[2] = "absent-1"; keys[3] = "key-9999";
+        hash_map_get_many(filtered, keys, 4, values);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[1], values[0]);
+        TEST_ASSERT_NULL(values[1]);
+        TEST_ASSERT_NULL(values[2]);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[4], values[3]);
+        for (int i = 0; i < 10000; ++i){
+            sprintf(key_buff, "key-%d", i);
+            if (i % 4)
+                TEST_ASSERT_EQUAL_PTR(&test_nums[i % 5], hash_map_get(filtered, key_buff));
+            else
+                TEST_ASSERT_NULL(hash_map_get(filtered, key_buff));
+        }
+
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_enable_filter(filtered, 0));
+        hash_map_stats(filtered, &stats);
+        TEST_ASSERT_EQUAL_UINT(0, stats.filter_bytes);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[1], hash_map_get(filtered, "key-1"));
+        hash_map_destroy(filtered, NULL);
+    }
+}
+
+// ****************************************************************************************
+// test_hash_map_build
+// ****************************************************************************************
+/**
+ *  Build maps in bulk with several thread counts
+ *
+ * Function under testing:
+ *  #hash_map_build
+ *
+ * Check:
+ * 	- Every pair is found, with the last value of repeated keys
+ * 	- Built maps keep working as regular maps (set, remove, growth)
+ * 	- Short keys live inside their node, long keys on the arena
+ */
+// ****************************************************************************************
+void test_hash_map_build(void){
+    static const int threads[] = { 1, 3, 8 };
+    static const size_t counts[] = { 0, 1, 100, 20000 };
+    char (*key_buff)[48] = malloc(20000 * sizeof(*key_buff)), new_key[32];
+    const char **keys = malloc(20000 * sizeof(char *));
+    void **values = malloc(20000 * sizeof(void *));
+
+    for (size_t i = 0; i < 20000; ++i){
+        // Every tenth key repeats the key before it, with another value
+        size_t key = i % 10 == 9 ? i - 1 : i;
+        snprintf(key_buff[i], sizeof(key_buff[i]), key % 2 ? "k%zu" : "a key longer than a node %zu", key);
+        keys[i] = key_buff[i];
+        values[i] = &test_nums[i % 5];
+    }
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t){
+        for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c){
+            size_t n = counts[c];
+            HashMap *built = hash_map_build(keys, values, n, threads[t]);
+            TEST_ASSERT_NOT_NULL(built);
+            TEST_ASSERT_EQUAL_UINT(n - n / 10, built->count);
+            for (size_t i = 0; i < n; ++i)
+                TEST_ASSERT_EQUAL_PTR(i % 10 == 8 && i + 1 < n ? values[i + 1] : values[i],
+                                      hash_map_get(built, keys[i]));
+            TEST_ASSERT_NULL(hash_map_get(built, "missing"));
+
+            for (int i = 0; i < built->size; ++i){
+                for (MapNode *node = built->list[i]; node; node = node->next)
+                    TEST_ASSERT_TRUE((node->key == node->key_data) == (node->key_len < MAP_NODE_INLINE_KEY));
+            }
+            // Built nodes and new ones are removed and freed alike
+            for (size_t i = 0; i < n; i += 2)
+                hash_map_remove(built, keys[i], NULL);
+            for (int i = 0; i < 1000; ++i){
+                snprintf(new_key, sizeof(new_key), "new-%d", i);
+                hash_map_set(built, new_key, &test_nums[0]);
+            }
+            for (size_t i = 1; i < n; i += 2){
+                if (i % 10 == 9)
+                    TEST_ASSERT_NULL(hash_map_get(built, keys[i]));
+                else
+                    TEST_ASSERT_NOT_NULL(hash_map_get(built, keys[i]));
+            }
+            TEST_ASSERT_EQUAL_PTR(&test_nums[0], hash_map_get(built, "new-999"));
+            hash_map_destroy(built, NULL);
+        }
+    }
+    free(values);
+    free(keys);
+    free(key_buff);
+}
+
+/// Combine checking values come in (a, b) order
+static void * join_combine(const char *key, size_t key_len, void *a_value, void *b_value){
+    (void)key;
+    (void)key_len;
+    return a_value == &test_nums[0] && b_value == &test_nums[1] ? &test_nums[2] : &test_nums[3];
+}
+
+/// Visitor counting matches of #hash_map_join on the counter given on #ctx
+static void join_visitor(const char *key, size_t key_len, void *a_value, void *b_value, void *ctx){
+    (void)key;
+    (void)key_len;
+    if (a_value == &test_nums[0] && b_value == &test_nums[1])
+        __atomic_fetch_add((unsigned int *)ctx, 1, __ATOMIC_RELAXED);
+}
+
+// ****************************************************************************************
+// test_hash_map_join
+// ****************************************************************************************
+/**
+ *  Intersect, unite and join maps of every engine with several thread counts
+ *
+ * Function under testing:
+ *  #hash_map_intersect
+ *  #hash_map_union
+ *  #hash_map_join
+ *
+ * Check:
+ * 	- Results hold the right keys, with combined values on common keys
+ * 	- Values reach the combine function in (a, b) order whichever map is smaller
+ * 	- Binary keys, filtered maps and maps with a pending rehash are handled
+ */
+// ****************************************************************************************
+void test_hash_map_join(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    static const int threads[] = { 1, 8 };
+    static const unsigned int b_counts[] = { 0, 100, 30000 };
+    char key_buff[48];
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        for (size_t c = 0; c < sizeof(b_counts) / sizeof(b_counts[0]); ++c){
+            // #a holds keys 0..19999 and a binary key, #b keys 10000.. and the same binary key
+            HashMap *a = create_hash_map(16);
+            HashMap *b = create_hash_map_engine(16, engines[e]);
+            for (int i = 0; i < 20000; ++i){
+                snprintf(key_buff, sizeof(key_buff), i % 2 ? "k%d" : "a key longer than a node %d", i);
+                hash_map_set(a, key_buff, &test_nums[0]);
+            }
+            hash_map_set_len(a, "bin\0key", 7, &test_nums[0]);
+            for (unsigned int i = 10000; i < 10000 + b_counts[c]; ++i){
+                snprintf(key_buff, sizeof(key_buff), i % 2 ? "k%u" : "a key longer than a node %u", i);
+                hash_map_set(b, key_buff, &test_nums[1]);
+            }
+            hash_map_set_len(b, "bin\0key", 7, &test_nums[1]);
+            if (c == 1)
+                TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_enable_filter(b, HASH_MAP_FILTER_BITS_PER_KEY));
+
+            unsigned int common = (b_counts[c] < 10000 ? b_counts[c] : 10000) + 1;
+            for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t){
+                HashMap *both = hash_map_intersect(a, b, join_combine, threads[t]);
+                TEST_ASSERT_NOT_NULL(both);
+                TEST_ASSERT_EQUAL_UINT(common, both->count);
+                TEST_ASSERT_EQUAL_PTR(&test_nums[2], hash_map_get_len(both, "bin\0key", 7));
+                TEST_ASSERT_NULL(hash_map_get(both, "bin"));
+                TEST_ASSERT_NULL(hash_map_get(both, "k9999"));
+                if (b_counts[c])
+                    TEST_ASSERT_EQUAL_PTR(&test_nums[2], hash_map_get(both, "k10001"));
+                hash_map_destroy(both, NULL);
+
+                // Without combine, keys take their value on #a
+                both = hash_map_intersect(b, a, NULL, threads[t]);
+                TEST_ASSERT_EQUAL_UINT(common, both->count);
+                TEST_ASSERT_EQUAL_PTR(&test_nums[1], hash_map_get_len(both, "bin\0key", 7));
+                hash_map_destroy(both, NULL);
+
+                HashMap *any = hash_map_union(a, b, join_combine, threads[t]);
+                TEST_ASSERT_NOT_NULL(any);
+                TEST_ASSERT_EQUAL_UINT(20001 + b_counts[c] + 1 - common, any->count);
+                TEST_ASSERT_EQUAL_PTR(&test_nums[0], hash_map_get(any, "k9999"));
+                TEST_ASSERT_EQUAL_PTR(&test_nums[2], hash_map_get_len(any, "bin\0key", 7));
+                if (b_counts[c] == 30000){
+                    TEST_ASSERT_EQUAL_PTR(&test_nums[2], hash_map_get(any, "k19999"));
+                    TEST_ASSERT_EQUAL_PTR(&test_nums[1], hash_map_get(any, "k20001"));
+                }
+                hash_map_destroy(any, NULL);
+
+                unsigned int visited = 0;
+                TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_join(a, b, join_visitor, &visited, threads[t]));
+                TEST_ASSERT_EQUAL_UINT(common, visited);
+            }
+            hash_map_destroy(a, NULL);
+            hash_map_destroy(b, NULL);
+        }
+    }
+}
+
+// ****************************************************************************************
+// test_hash_map_compact_storage
+// ****************************************************************************************
+/**
+ *  Compact maps of every engine after removing most of their pairs
+ *
+ * Function under testing:
+ *  #hash_map_compact
+ *  #hash_map_set_min_load_factor
+ *
+ * Check:
+ * 	- Table shrinks and every remaining pair is found
+ * 	- Chained nodes end on a single slab, and the map keeps working afterwards
+ * 	- Removals shrink the table once it is under the min load factor
+ */
+// ****************************************************************************************
+void test_hash_map_compact_storage(void){
+    static const HashMapEngine engines[] = { HASH_MAP_CHAINED, HASH_MAP_SWISS, HASH_MAP_COMPACT, HASH_MAP_CUCKOO };
+    char key_buff[64];
+    for (size_t e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e){
+        HashMap *shrunk = create_hash_map_engine(1, engines[e]);
+        for (int i = 0; i < 10000; ++i){
+            snprintf(key_buff, sizeof(key_buff), i % 2 ? "%d" : "a long key that must live on the arena %d", i);
+            hash_map_set(shrunk, key_buff, &test_nums[i % 5]);
+        }
+        int size = shrunk->size;
+        for (int i = 0; i < 10000; ++i){
+            snprintf(key_buff, sizeof(key_buff), i % 2 ? "%d" : "a long key that must live on the arena %d", i);
+            if (i % 10)
+                hash_map_remove(shrunk, key_buff, NULL);
+        }
+        TEST_ASSERT_EQUAL_INT(size, shrunk->size);
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_compact(shrunk));
+        TEST_ASSERT_TRUE(shrunk->size <= size / 8);
+        TEST_ASSERT_EQUAL_UINT(1000, shrunk->count);
+        if (engines[e] == HASH_MAP_CHAINED){
+            for (int i = 0; i < shrunk->size; ++i){
+                for (MapNode *node = shrunk->list[i]; node; node = node->next)
+                    TEST_ASSERT_TRUE(node->flags & MAP_NODE_SLAB);
+            }
+        }
+        for (int i = 0; i < 10000; ++i){
+            snprintf(key_buff, sizeof(key_buff), i % 2 ? "%d" : "a long key that must live on the arena %d", i);
+            if (i % 10)
+                TEST_ASSERT_NULL(hash_map_get(shrunk, key_buff));
+            else
+                TEST_ASSERT_EQUAL_PTR(&test_nums[i % 5], hash_map_get(shrunk, key_buff));
+        }
+        // Compacted maps keep growing and removing as usual
+        for (int i = 0; i < 10000; i += 20){
+            snprintf(key_buff, sizeof(key_buff), "a long key that must live on the arena %d", i);
+            TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_remove(shrunk, key_buff, NULL));
+        }
+        for (int i = 0; i < 5000; ++i){
+            snprintf(key_buff, sizeof(key_buff), "new-%d", i);
+            hash_map_set(shrunk, key_buff, &test_nums[0]);
+        }
+        TEST_ASSERT_EQUAL_UINT(5500, shrunk->count);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[0], hash_map_get(shrunk, "new-4999"));
+        TEST_ASSERT_EQUAL_PTR(&test_nums[0], hash_map_get(shrunk, "a long key that must live on the arena 10"));
+
+        // Automatic shrink
+        TEST_ASSERT_EQUAL_INT(CLIB_ERROR, hash_map_set_min_load_factor(shrunk, shrunk->max_load_factor));
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, hash_map_set_min_load_factor(shrunk, 0.1f));
+        size = shrunk->size;
+        for (int i = 0; i < 5000; ++i){
+            snprintf(key_buff, sizeof(key_buff), "new-%d", i);
+            hash_map_remove(shrunk, key_buff, NULL);
+        }
+        hash_map_reserve(shrunk, 0);        // Finish any pending rehash
+        TEST_ASSERT_TRUE(shrunk->size < size);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[0], hash_map_get(shrunk, "a long key that must live on the arena 10"));
+        TEST_ASSERT_NULL(hash_map_get(shrunk, "new-0"));
+        hash_map_destroy(shrunk, NULL);
+    }
+}
+
 // Needed by Unity test framework. This functions will be executed before and after each test.
 void setUp(void){
     map = create_hash_map(5);
@@ -146,6 +1631,30 @@ int main (){
     /*RUN_TEST(test_hash_map_get);*/
     RUN_TEST(test_hash_map_pop);
     /*RUN_TEST(test_hash_map_remove);*/
+    RUN_TEST(test_hash_bytes);
+    RUN_TEST(test_hash_map_cached_hash);
+    RUN_TEST(test_hash_map_growth);
+    RUN_TEST(test_hash_map_reserve);
+    RUN_TEST(test_hash_map_swiss_engine);
+    RUN_TEST(test_hash_map_len_keys);
+    RUN_TEST(test_hash_map_key_storage);
+    RUN_TEST(test_hash_map_key_churn);
+    RUN_TEST(test_generic_hash_map);
+    RUN_TEST(test_int_hash_map);
+    RUN_TEST(test_hash_map_upsert);
+    RUN_TEST(test_hash_map_many);
+    RUN_TEST(test_concurrent_hash_map);
+    RUN_TEST(test_rcu_hash_map);
+    RUN_TEST(test_hash_map_iterator);
+    RUN_TEST(test_hash_map_stats);
+    RUN_TEST(test_hash_map_mapped);
+    RUN_TEST(test_hash_map_compact);
+    RUN_TEST(test_hash_map_freeze);
+    RUN_TEST(test_hash_map_cuckoo);
+    RUN_TEST(test_hash_map_filter);
+    RUN_TEST(test_hash_map_build);
+    RUN_TEST(test_hash_map_compact_storage);
+    RUN_TEST(test_hash_map_join);
     return UNITY_END();
 
 }
@@ -0,0 +1,192 @@
+// ****************************************************************************************
+/**
+ * @file   intrusive-list-tests.c
+ * @brief  Unit tests of intrusive list structure
+ *
+ * @details
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+#include "Clib.h"
+#include <stdio.h>
+#include "unity.h"
+
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+#define TEST_LEN            (16)
+
+/// Object linked on two lists at once, link on the middle so CONTAINER_OF has to move back
+typedef struct {
+    int id;
+    ListLink link;
+    double payload;
+    ListLink other;
+} Item;
+
+IntrusiveList list;
+Item items[TEST_LEN];
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+/// Id of the item owning #link, -1 if there is no link
+int item_id(ListLink *link){
+    return link ? CONTAINER_OF(link, Item, link)->id : -1;
+}
+
+/// Check #list holds items with #ids on order, walking it both ways
+void check_ids(const int *ids, unsigned int count){
+    TEST_ASSERT_EQUAL_UINT(count, intrusive_list_get_size(&list));
+    ListLink *link = intrusive_list_get_first(&list);
+    for (unsigned int i = 0; i < count; ++i, link = intrusive_list_next(&list, link))
+        TEST_ASSERT_EQUAL_INT(ids[i], item_id(link));
+    TEST_ASSERT_NULL(link);
+    link = intrusive_list_get_last(&list);
+    for (unsigned int i = count; i > 0; --i, link = intrusive_list_prev(&list, link))
+        TEST_ASSERT_EQUAL_INT(ids[i - 1], item_id(link));
+    TEST_ASSERT_NULL(link);
+}
+
+
+/******************************************************************************/
+/******************** Public Test Function Implementations ********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// test_intrusive_list_init
+// ****************************************************************************************
+/**
+ *  Check initialization of intrusive list
+ *
+ * Function under testing:
+ *  #intrusive_list_init
+ *
+ * Check:
+ * 	- List is empty and has no links to return
+ * 	- CONTAINER_OF gives back the object of a link
+ */
+// ****************************************************************************************
+void test_intrusive_list_init(void){
+    TEST_ASSERT_TRUE(intrusive_list_is_empty(&list));
+    TEST_ASSERT_EQUAL_UINT(0, intrusive_list_get_size(&list));
+    TEST_ASSERT_NULL(intrusive_list_get_first(&list));
+    TEST_ASSERT_NULL(intrusive_list_get_last(&list));
+    TEST_ASSERT_NULL(intrusive_list_pop_front(&list));
+    TEST_ASSERT_NULL(intrusive_list_pop_back(&list));
+    TEST_ASSERT_EQUAL_PTR(&items[3], CONTAINER_OF(&items[3].other, Item, other));
+}
+
+
+// ****************************************************************************************
+// test_intrusive_list_push_pop
+// ****************************************************************************************
+/**
+ *  Check push and pop functions used as FIFO and LIFO
+ *
+ * Function under testing:
+ *  #intrusive_list_push_front
+ *  #intrusive_list_push_back
+ *  #intrusive_list_pop_front
+ *  #intrusive_list_pop_back
+ *
+ * Check:
+ * 	- Items keep push order from the back and reverse order from the front
+ * 	- Popped links are cleared, and the list works again once empty
+ */
+// ****************************************************************************************
+void test_intrusive_list_push_pop(void){
+    int ids[TEST_LEN];
+    for (unsigned int i = 0; i < TEST_LEN; ++i){
+        intrusive_list_push_back(&list, &items[i].link);
+        ids[i] = (int)i;
+    }
+    check_ids(ids, TEST_LEN);
+    for (unsigned int i = 0; i < TEST_LEN / 2; ++i){
+        ListLink *link = intrusive_list_pop_front(&list);
+        TEST_ASSERT_EQUAL_INT(i, item_id(link));
+        TEST_ASSERT_NULL(link->next);
+        TEST_ASSERT_NULL(link->prev);
+    }
+    for (unsigned int i = TEST_LEN; i > TEST_LEN / 2; --i)
+        TEST_ASSERT_EQUAL_INT(i - 1, item_id(intrusive_list_pop_back(&list)));
+    TEST_ASSERT_TRUE(intrusive_list_is_empty(&list));
+
+    for (unsigned int i = 0; i < TEST_LEN; ++i){
+        intrusive_list_push_front(&list, &items[i].link);
+        ids[TEST_LEN - 1 - i] = (int)i;
+    }
+    check_ids(ids, TEST_LEN);
+}
+
+
+// ****************************************************************************************
+// test_intrusive_list_remove
+// ****************************************************************************************
+/**
+ *  Check removal of known items, with items linked on two lists
+ *
+ * Function under testing:
+ *  #intrusive_list_remove
+ *
+ * Check:
+ * 	- First, middle and last items are unlinked keeping the order of the others
+ * 	- Removing from one list does not change the other list of the item
+ */
+// ****************************************************************************************
+void test_intrusive_list_remove(void){
+    IntrusiveList odd;
+    intrusive_list_init(&odd);
+    for (int i = 0; i < 6; ++i){
+        intrusive_list_push_back(&list, &items[i].link);
+        if (i % 2)
+            intrusive_list_push_back(&odd, &items[i].other);
+    }
+
+    intrusive_list_remove(&list, &items[3].link);
+    intrusive_list_remove(&list, &items[0].link);
+    intrusive_list_remove(&list, &items[5].link);
+    check_ids((const int[]){ 1, 2, 4 }, 3);
+
+    TEST_ASSERT_EQUAL_UINT(3, intrusive_list_get_size(&odd));
+    TEST_ASSERT_EQUAL_PTR(&items[1], CONTAINER_OF(intrusive_list_get_first(&odd), Item, other));
+    intrusive_list_remove(&odd, &items[3].other);
+    TEST_ASSERT_EQUAL_PTR(&items[5], CONTAINER_OF(intrusive_list_next(&odd, &items[1].other), Item, other));
+
+    // Removed items can be linked again
+    intrusive_list_push_front(&list, &items[5].link);
+    check_ids((const int[]){ 5, 1, 2, 4 }, 4);
+}
+
+
+// Needed by Unity test framework. This functions will be executed before and after each test.
+void setUp(void){
+    for (int i = 0; i < TEST_LEN; ++i)
+        items[i].id = i;
+    intrusive_list_init(&list);
+}
+
+void tearDown(void){
+}
+
+
+int main (void){
+    UNITY_BEGIN();
+    RUN_TEST(test_intrusive_list_init);
+    RUN_TEST(test_intrusive_list_push_pop);
+    RUN_TEST(test_intrusive_list_remove);
+    return UNITY_END();
+
+}
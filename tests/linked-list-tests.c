@@ -65,12 +65,10 @@ void test_create_linked_list(void){
 
     TEST_ASSERT_NOT_NULL(list);
     TEST_ASSERT_EQUAL_INT(0, list->size);
-    TEST_ASSERT_NOT_NULL(list->head);
-    TEST_ASSERT_NOT_NULL(list->tail);
-    TEST_ASSERT_NULL(list->head->next);
-    TEST_ASSERT_NULL(list->tail->prev);
-    TEST_ASSERT_EQUAL_PTR(list->head->prev, list->tail);
-    TEST_ASSERT_EQUAL_PTR(list->tail->next, list->head);
+    TEST_ASSERT_NULL(list->head.next);
+    TEST_ASSERT_NULL(list->tail.prev);
+    TEST_ASSERT_EQUAL_PTR(list->head.prev, &list->tail);
+    TEST_ASSERT_EQUAL_PTR(list->tail.next, &list->head);
 
     list_destroy(list);
 }
@@ -78,8 +76,8 @@ void test_create_linked_list(void){
 // TODO cant assign pointer to null
 void test_destroy_linked_list(void){
     LinkedList *list = create_linked_list();
-    ListNode *head = list->head;
-    ListNode *tail = list->tail;
+    ListNode *head = &list->head;
+    ListNode *tail = &list->tail;
 
     list_destroy(list);
 
@@ -92,6 +90,50 @@ void test_destroy_linked_list(void){
 }
 
 
+// ****************************************************************************************
+// test_list_init
+// ****************************************************************************************
+/**
+ *  Check linked lists on caller owned storage
+ *
+ * Function under testing:
+ *  #list_init
+ *  #list_clear
+ *
+ * Check:
+ * 	- Initialiced list is empty, with joint sentinels
+ * 	- Values can be pushed and popped on lists embedded on an array
+ * 	- Cleared list is empty and can be used again
+ */
+// ****************************************************************************************
+void test_list_init(void){
+    LinkedList lists[3];
+    int size = sizeof(test_nums)/sizeof(int);
+
+    for (int l = 0; l < 3; ++l){
+        list_init(&lists[l]);
+        TEST_ASSERT_TRUE(list_is_empty(&lists[l]));
+        TEST_ASSERT_EQUAL_PTR(&lists[l].tail, lists[l].head.prev);
+        TEST_ASSERT_EQUAL_PTR(&lists[l].head, lists[l].tail.next);
+        TEST_ASSERT_NULL(list_get_first(&lists[l]));
+        TEST_ASSERT_NULL(list_pop_back(&lists[l]));
+    }
+    for (int i = 0; i < size; ++i)
+        list_push_back(&lists[i % 3], &test_nums[i]);
+    for (int i = 0; i < 3; ++i)
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i], list_pop_front(&lists[i]));
+
+    for (int l = 0; l < 3; ++l){
+        list_clear(&lists[l]);
+        TEST_ASSERT_EQUAL_UINT(0, list_get_size(&lists[l]));
+        TEST_ASSERT_NULL(list_get_last(&lists[l]));
+        list_push_front(&lists[l], &test_nums[l]);
+        TEST_ASSERT_EQUAL_PTR(&test_nums[l], list_get_element(&lists[l], 0));
+        list_clear(&lists[l]);
+    }
+}
+
+
 // ****************************************************************************************
 // test_list_push_back
 // ****************************************************************************************
@@ -115,12 +157,12 @@ void test_list_push_back(void){
         // Check size is increasing on every push
         TEST_ASSERT_EQUAL(i + 1, list->size);
         // Check last element on the list is the element already inserted
-        TEST_ASSERT_EQUAL_INT(test_nums[i], *(int*)list->tail->next->content);
+        TEST_ASSERT_EQUAL_INT(test_nums[i], *(int*)list->tail.next->content);
 
     }
 
     // Second iteration
-    ListNode *node = list->head->prev;
+    ListNode *node = list->head.prev;
     int num = 0;
 
     // Check if node is tail node
@@ -159,12 +201,12 @@ void test_list_push_front(void){
         // Check size is increasing on every push
         TEST_ASSERT_EQUAL(i + 1, list->size);
         // Check last element on the list is the element already inserted
-        TEST_ASSERT_EQUAL_INT(test_nums[i], *(int*)list->head->prev->content);
+        TEST_ASSERT_EQUAL_INT(test_nums[i], *(int*)list->head.prev->content);
 
     }
 
     // Second iteration
-    ListNode *node = list->head->prev;
+    ListNode *node = list->head.prev;
     int num = 0;
 
     // Check if node is tail node
@@ -384,6 +426,227 @@ void test_list_find_node(void){
 }
 
 
+
+// ****************************************************************************************
+// test_list_remove_node
+// ****************************************************************************************
+/**
+ *  Check removal of nodes given by reference
+ *
+ * Function under testing:
+ *  #list_remove_node
+ *
+ * Check:
+ * 	- Content of removed node is returned and size decreases
+ * 	- First, middle and last nodes are unlinked keeping the order of the others
+ */
+// ****************************************************************************************
+void test_list_remove_node(void){
+    int size = sizeof(test_nums)/sizeof(int);
+
+    for (int i = 0; i < size; ++i){
+        // Populate list
+        list_push_back(list, &test_nums[i]);
+    }
+
+    TEST_ASSERT_EQUAL_PTR(&test_nums[5], list_remove_node(list, list_find_node(list, &test_nums[5], COMPARE_INT)));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[0], list_remove_node(list, list_find_node(list, &test_nums[0], COMPARE_INT)));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[size - 1], list_remove_node(list, list_find_node(list, &test_nums[size - 1], COMPARE_INT)));
+    TEST_ASSERT_EQUAL_UINT(size - 3, list_get_size(list));
+    TEST_ASSERT_EQUAL_INT(1, *(int*)list_get_first(list));
+    TEST_ASSERT_EQUAL_INT(size - 2, *(int*)list_get_last(list));
+    TEST_ASSERT_EQUAL_INT(4, *(int*)list_get_element(list, 3));
+    TEST_ASSERT_EQUAL_INT(6, *(int*)list_get_element(list, 4));
+}
+
+
+// ****************************************************************************************
+// test_list_move_front
+// ****************************************************************************************
+/**
+ *  Check moving nodes to the first position
+ *
+ * Function under testing:
+ *  #list_move_front
+ *
+ * Check:
+ * 	- Moved node becomes first, others keep their order and size does not change
+ * 	- Moving the first node leaves the list unchanged
+ */
+// ****************************************************************************************
+void test_list_move_front(void){
+    int size = sizeof(test_nums)/sizeof(int);
+
+    for (int i = 0; i < size; ++i){
+        // Populate list
+        list_push_back(list, &test_nums[i]);
+    }
+
+    list_move_front(list, list_find_node(list, &test_nums[size - 1], COMPARE_INT));
+    list_move_front(list, list_find_node(list, &test_nums[3], COMPARE_INT));
+    list_move_front(list, list_find_node(list, &test_nums[3], COMPARE_INT));
+    TEST_ASSERT_EQUAL_UINT(size, list_get_size(list));
+    TEST_ASSERT_EQUAL_INT(3, *(int*)list_get_element(list, 0));
+    TEST_ASSERT_EQUAL_INT(size - 1, *(int*)list_get_element(list, 1));
+    TEST_ASSERT_EQUAL_INT(0, *(int*)list_get_element(list, 2));
+    TEST_ASSERT_EQUAL_INT(4, *(int*)list_get_element(list, 5));
+    TEST_ASSERT_EQUAL_INT(size - 2, *(int*)list_get_last(list));
+}
+
+
+// ****************************************************************************************
+// test_list_get_element_finger
+// ****************************************************************************************
+/**
+ *  Check get element function keeps working while the list changes between calls
+ *
+ * Function under testing:
+ *  #list_get_element
+ *  #list_append_before
+ *  #list_append_after
+ *
+ * Check:
+ * 	- Elements got in order, backwards and skipping are correct
+ * 	- Pushes, pops and appends between gets do not return stale elements
+ * 	- Appends increase size
+ */
+// ****************************************************************************************
+void test_list_get_element_finger(void){
+    unsigned int size = sizeof(test_nums)/sizeof(int);
+
+    for (unsigned int i = 1; i < size - 1; ++i){
+        // Populate list with every number but the first and the last
+        list_push_back(list, &test_nums[i]);
+    }
+    for (unsigned int i = 0; i < size - 2; ++i)
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i + 1], list_get_element(list, i));
+    for (int i = (int)size - 3; i >= 0; i -= 3)
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i + 1], list_get_element(list, (unsigned int)i));
+
+    TEST_ASSERT_EQUAL_PTR(&test_nums[6], list_get_element(list, 5));
+    list_push_front(list, &test_nums[0]);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[6], list_get_element(list, 6));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[7], list_get_element(list, 7));
+    list_pop_front(list);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[7], list_get_element(list, 6));
+    list_push_back(list, &test_nums[size - 1]);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[6], list_get_element(list, 5));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[size - 1], list_get_element(list, size - 2));
+    list_pop_back(list);
+    TEST_ASSERT_NULL(list_get_element(list, size - 2));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[size - 2], list_get_element(list, size - 3));
+
+    // Remove 5 and put it back on both sides of 6
+    ListNode *six = list_find_node(list, &test_nums[6], COMPARE_INT);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[6], list_get_element(list, 5));
+    list_remove_node(list, list_find_node(list, &test_nums[5], COMPARE_INT));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[7], list_get_element(list, 5));
+    list_append_before(list, six, &test_nums[5]);
+    TEST_ASSERT_EQUAL_UINT(size - 2, list_get_size(list));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[5], list_get_element(list, 4));
+    list_append_after(list, six, &test_nums[5]);
+    TEST_ASSERT_EQUAL_UINT(size - 1, list_get_size(list));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[6], list_get_element(list, 5));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[5], list_get_element(list, 6));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[size - 2], list_get_last(list));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[size - 2], list_get_element(list, size - 2));
+}
+
+
+// ****************************************************************************************
+// test_list_iter
+// ****************************************************************************************
+/**
+ *  Check iteration over list nodes on both directions
+ *
+ * Function under testing:
+ *  #list_iter_begin
+ *  #list_iter_end
+ *  #list_iter_next
+ *  #list_iter_prev
+ *  #list_iter_remove
+ *
+ * Check:
+ * 	- Empty list has no nodes to visit
+ * 	- Nodes are visited on list order forwards and backwards
+ * 	- Removing while iterating drops the current node and goes on with the next one
+ * 	- Removing while iterating backwards goes on with the previous one
+ */
+// ****************************************************************************************
+void test_list_iter(void){
+    int size = sizeof(test_nums)/sizeof(int);
+    ListIterator it;
+
+    list_iter_begin(list, &it);
+    TEST_ASSERT_FALSE(list_iter_next(&it));
+    TEST_ASSERT_NULL(list_iter_remove(&it));
+    list_iter_end(list, &it);
+    TEST_ASSERT_FALSE(list_iter_prev(&it));
+
+    for (int i = 0; i < size; ++i){
+        // Populate list
+        list_push_back(list, &test_nums[i]);
+    }
+
+    int visited = 0;
+    list_iter_begin(list, &it);
+    while (list_iter_next(&it))
+        TEST_ASSERT_EQUAL_PTR(&test_nums[visited++], it.value);
+    TEST_ASSERT_EQUAL_INT(size, visited);
+    // Iterator stays past the last node, and walks back from there
+    TEST_ASSERT_FALSE(list_iter_next(&it));
+    TEST_ASSERT_TRUE(list_iter_prev(&it));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[size - 1], it.value);
+
+    list_iter_end(list, &it);
+    while (list_iter_prev(&it))
+        TEST_ASSERT_EQUAL_PTR(&test_nums[--visited], it.value);
+    TEST_ASSERT_EQUAL_INT(0, visited);
+
+    // Remove odd numbers, first and last nodes included
+    list_push_back(list, &test_nums[1]);
+    list_push_front(list, &test_nums[3]);
+    list_iter_begin(list, &it);
+    while (list_iter_next(&it)){
+        if (*(int*)it.value % 2)
+            TEST_ASSERT_NOT_NULL(list_iter_remove(&it));
+    }
+    TEST_ASSERT_EQUAL_UINT((size + 1) / 2, list_get_size(list));
+    list_iter_begin(list, &it);
+    while (list_iter_next(&it))
+        TEST_ASSERT_EQUAL_PTR(&test_nums[2 * visited++], it.value);
+    TEST_ASSERT_EQUAL_INT((size + 1) / 2, visited);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[0], list_get_first(list));
+
+    // Remove multiples of 4 walking backwards, every node is still visited
+    list_iter_end(list, &it);
+    while (list_iter_prev(&it)){
+        TEST_ASSERT_EQUAL_PTR(&test_nums[2 * --visited], it.value);
+        if (*(int*)it.value % 4 == 0){
+            TEST_ASSERT_NOT_NULL(list_iter_remove(&it));
+            TEST_ASSERT_NULL(list_iter_remove(&it));
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, visited);
+    TEST_ASSERT_EQUAL_UINT(size / 4, list_get_size(list));
+
+    // Removal leaves the iterator between both neighbours, for any direction
+    list_iter_begin(list, &it);
+    list_iter_next(&it);
+    list_iter_next(&it);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[6], list_iter_remove(&it));
+    TEST_ASSERT_TRUE(list_iter_prev(&it));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[2], it.value);
+    TEST_ASSERT_TRUE(list_iter_next(&it));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[10], it.value);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[10], list_iter_remove(&it));
+    TEST_ASSERT_TRUE(list_iter_prev(&it));
+    TEST_ASSERT_EQUAL_PTR(&test_nums[2], it.value);
+    TEST_ASSERT_FALSE(list_iter_prev(&it));
+}
+
+
+
 // Needed by Unity test framework. This functions will be executed before and after each test.
 void setUp(void){
     list = create_linked_list();
@@ -399,6 +662,7 @@ int main (){
     UNITY_BEGIN();
     RUN_TEST(test_create_linked_list);
     RUN_TEST(test_destroy_linked_list);
+    RUN_TEST(test_list_init);
     RUN_TEST(test_list_push_back);
     RUN_TEST(test_list_pop_back);
     RUN_TEST(test_list_pop_front);
@@ -407,6 +671,10 @@ int main (){
 
     RUN_TEST(test_list_get_element);
     RUN_TEST(test_list_find_node);
+    RUN_TEST(test_list_remove_node);
+    RUN_TEST(test_list_move_front);
+    RUN_TEST(test_list_get_element_finger);
+    RUN_TEST(test_list_iter);
     return UNITY_END();
 
 }
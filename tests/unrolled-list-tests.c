@@ -0,0 +1,294 @@
+// ****************************************************************************************
+/**
+ * @file   unrolled-list-tests.c
+ * @brief  Unit tests of unrolled list structure
+ *
+ * @details
+ *
+ * <h2> Release History </h2>
+ *
+ * <hr>
+ * @version 1.0
+ * @date    18 Oct 2026
+ * @details
+ *	    - Initial release.
+ *
+ * <hr>
+ */
+// ****************************************************************************************
+
+#include "Clib.h"
+#include <stdio.h>
+#include "unity.h"
+
+
+// ****************************************************************************************
+// ****************************** Definitions & Constants *********************************
+// ****************************************************************************************
+/// Values spanning several chunks, with partial chunks on both ends
+#define TEST_LEN            (500)
+
+UnrolledList *list;
+int test_nums[TEST_LEN];
+
+/******************************************************************************/
+/***************** Private Auxiliary Functions Implementations ****************/
+/******************************************************************************/
+
+int printed;
+
+void print_int(void *value){
+    // Check values are printed on list order
+    TEST_ASSERT_EQUAL_INT(printed++, *(int*)value);
+}
+
+int freed;
+
+void free_int(void *value){
+    (void)value;
+    freed++;
+}
+
+
+/******************************************************************************/
+/******************** Public Test Function Implementations ********************/
+/******************************************************************************/
+
+// ****************************************************************************************
+// test_create_unrolled_list
+// ****************************************************************************************
+/**
+ *  Check creation of unrolled list
+ *
+ * Function under testing:
+ *  #create_unrolled_list
+ *
+ * Check:
+ * 	- List return pointer not null
+ * 	- List is empty, without chunks
+ */
+// ****************************************************************************************
+void test_create_unrolled_list(void){
+    TEST_ASSERT_NOT_NULL(list);
+    TEST_ASSERT_EQUAL_UINT(0, unrolled_list_get_size(list));
+    TEST_ASSERT_TRUE(unrolled_list_is_empty(list));
+    TEST_ASSERT_NULL(list->first);
+    TEST_ASSERT_NULL(list->last);
+    TEST_ASSERT_NULL(unrolled_list_get_first(list));
+    TEST_ASSERT_NULL(unrolled_list_get_last(list));
+    TEST_ASSERT_NULL(unrolled_list_pop_front(list));
+    TEST_ASSERT_NULL(unrolled_list_pop_back(list));
+    TEST_ASSERT_EQUAL(UNROLLED_LIST_CHUNK_BYTES, sizeof(UnrolledChunk));
+}
+
+
+// ****************************************************************************************
+// test_unrolled_list_push_back
+// ****************************************************************************************
+/**
+ *  Check push back function on sucessive calls
+ *
+ * Function under testing:
+ *  #unrolled_list_push_back
+ *
+ * Check:
+ * 	- Size increase whith every push, and last element is the one pushed
+ * 	- Chunks are only partially filled at the ends of the list
+ */
+// ****************************************************************************************
+void test_unrolled_list_push_back(void){
+    for (int i = 0; i < TEST_LEN; ++i){
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, unrolled_list_push_back(list, &test_nums[i]));
+        TEST_ASSERT_EQUAL_UINT(i + 1, unrolled_list_get_size(list));
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i], unrolled_list_get_last(list));
+        TEST_ASSERT_EQUAL_PTR(&test_nums[0], unrolled_list_get_first(list));
+    }
+
+    unsigned int count = 0;
+    for (UnrolledChunk *chunk = list->first; chunk; chunk = chunk->next){
+        if (chunk != list->last)
+            TEST_ASSERT_EQUAL_UINT(UNROLLED_LIST_CHUNK_ITEMS, chunk->count);
+        TEST_ASSERT_TRUE(chunk->next == NULL || chunk->next->prev == chunk);
+        count += chunk->count;
+    }
+    TEST_ASSERT_EQUAL_UINT(TEST_LEN, count);
+}
+
+
+// ****************************************************************************************
+// test_unrolled_list_push_front
+// ****************************************************************************************
+/**
+ *  Check push front function on sucessive calls
+ *
+ * Function under testing:
+ *  #unrolled_list_push_front
+ *
+ * Check:
+ * 	- Size increase whith every push, and first element is the one pushed
+ * 	- Elements end in reverse push order
+ */
+// ****************************************************************************************
+void test_unrolled_list_push_front(void){
+    for (int i = 0; i < TEST_LEN; ++i){
+        TEST_ASSERT_EQUAL_INT(CLIB_OK, unrolled_list_push_front(list, &test_nums[i]));
+        TEST_ASSERT_EQUAL_UINT(i + 1, unrolled_list_get_size(list));
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i], unrolled_list_get_first(list));
+        TEST_ASSERT_EQUAL_PTR(&test_nums[0], unrolled_list_get_last(list));
+    }
+    for (unsigned int i = 0; i < TEST_LEN; ++i)
+        TEST_ASSERT_EQUAL_PTR(&test_nums[TEST_LEN - 1 - i], unrolled_list_get_element(list, i));
+}
+
+
+// ****************************************************************************************
+// test_unrolled_list_pop
+// ****************************************************************************************
+/**
+ *  Check pop functions used as FIFO and LIFO
+ *
+ * Function under testing:
+ *  #unrolled_list_pop_front
+ *  #unrolled_list_pop_back
+ *
+ * Check:
+ * 	- Elements are popped in FIFO order from the front and LIFO order from the back
+ * 	- Emptied chunks are kept as spare, and the list works again once empty
+ */
+// ****************************************************************************************
+void test_unrolled_list_pop(void){
+    for (int round = 0; round < 2; ++round){
+        for (int i = 0; i < TEST_LEN; ++i)
+            unrolled_list_push_back(list, &test_nums[i]);
+        for (int i = 0; i < TEST_LEN / 2; ++i){
+            TEST_ASSERT_EQUAL_PTR(&test_nums[i], unrolled_list_pop_front(list));
+            TEST_ASSERT_EQUAL_UINT(TEST_LEN - i - 1, unrolled_list_get_size(list));
+        }
+        for (int i = TEST_LEN - 1; i >= TEST_LEN / 2; --i)
+            TEST_ASSERT_EQUAL_PTR(&test_nums[i], unrolled_list_pop_back(list));
+        TEST_ASSERT_TRUE(unrolled_list_is_empty(list));
+        TEST_ASSERT_NULL(list->first);
+        TEST_ASSERT_NULL(list->last);
+        TEST_ASSERT_NOT_NULL(list->spare);
+        TEST_ASSERT_NULL(unrolled_list_pop_front(list));
+    }
+
+    // Pushing and popping on a chunk boundary reuses the spare chunk
+    unrolled_list_push_back(list, &test_nums[0]);
+    UnrolledChunk *spare = list->spare;
+    TEST_ASSERT_NULL(spare);
+    TEST_ASSERT_EQUAL_PTR(&test_nums[0], unrolled_list_pop_back(list));
+    spare = list->spare;
+    unrolled_list_push_front(list, &test_nums[1]);
+    TEST_ASSERT_EQUAL_PTR(spare, list->first);
+}
+
+
+// ****************************************************************************************
+// test_unrolled_list_mixed
+// ****************************************************************************************
+/**
+ *  Check pushes and pops on both ends mixed
+ *
+ * Function under testing:
+ *  #unrolled_list_push_front
+ *  #unrolled_list_push_back
+ *  #unrolled_list_pop_front
+ *  #unrolled_list_pop_back
+ *  #unrolled_list_get_element
+ *
+ * Check:
+ * 	- List keeps the same order than a reference array on every step
+ */
+// ****************************************************************************************
+void test_unrolled_list_mixed(void){
+    int reference[4 * TEST_LEN];
+    int low = 2 * TEST_LEN, high = 2 * TEST_LEN;   // Reference holds [low, high)
+    unsigned int state = 3;
+
+    for (int step = 0; step < 4000; ++step){
+        state = state * 1103515245u + 12345u;
+        unsigned int op = (state >> 16) % 4;
+        // Pushes are more likely than pops so the list grows across several chunks
+        if (op == 0 && high < 4 * TEST_LEN){
+            reference[high++] = step % TEST_LEN;
+            unrolled_list_push_back(list, &test_nums[step % TEST_LEN]);
+        } else if (op == 1 && low > 0){
+            reference[--low] = step % TEST_LEN;
+            unrolled_list_push_front(list, &test_nums[step % TEST_LEN]);
+        } else if (op == 2 && (state >> 20) % 3 == 0){
+            int *value = unrolled_list_pop_front(list);
+            TEST_ASSERT_EQUAL_PTR(low < high ? &test_nums[reference[low++]] : NULL, value);
+        } else if (op == 3 && (state >> 20) % 3 == 0){
+            int *value = unrolled_list_pop_back(list);
+            TEST_ASSERT_EQUAL_PTR(low < high ? &test_nums[reference[--high]] : NULL, value);
+        }
+        TEST_ASSERT_EQUAL_UINT(high - low, unrolled_list_get_size(list));
+    }
+    for (int i = low; i < high; ++i)
+        TEST_ASSERT_EQUAL_PTR(&test_nums[reference[i]], unrolled_list_get_element(list, (unsigned int)(i - low)));
+    TEST_ASSERT_NULL(unrolled_list_get_element(list, (unsigned int)(high - low)));
+}
+
+
+// ****************************************************************************************
+// test_unrolled_list_find
+// ****************************************************************************************
+/**
+ *  Check find and print functions
+ *
+ * Function under testing:
+ *  #unrolled_list_find
+ *  #unrolled_list_print
+ *  #unrolled_list_destroy
+ *
+ * Check:
+ * 	- Every value is found, missing values return NULL
+ * 	- Print visits values on list order
+ * 	- Destroy frees every value
+ */
+// ****************************************************************************************
+void test_unrolled_list_find(void){
+    int missing = -1;
+    for (int i = TEST_LEN - 1; i >= 0; --i)
+        unrolled_list_push_front(list, &test_nums[i]);
+    for (int i = 0; i < TEST_LEN; ++i)
+        TEST_ASSERT_EQUAL_PTR(&test_nums[i], unrolled_list_find(list, &test_nums[i], COMPARE_INT));
+    TEST_ASSERT_NULL(unrolled_list_find(list, &missing, COMPARE_INT));
+
+    printed = 0;
+    unrolled_list_print(list, print_int);
+    TEST_ASSERT_EQUAL_INT(TEST_LEN, printed);
+
+    UnrolledList *other = create_unrolled_list();
+    for (int i = 0; i < TEST_LEN; ++i)
+        unrolled_list_push_back(other, &test_nums[i]);
+    freed = 0;
+    unrolled_list_destroy(other, free_int);
+    TEST_ASSERT_EQUAL_INT(TEST_LEN, freed);
+}
+
+
+// Needed by Unity test framework. This functions will be executed before and after each test.
+void setUp(void){
+    for (int i = 0; i < TEST_LEN; ++i)
+        test_nums[i] = i;
+    list = create_unrolled_list();
+}
+
+void tearDown(void){
+    unrolled_list_destroy(list, NULL);
+}
+
+
+int main (void){
+    UNITY_BEGIN();
+    RUN_TEST(test_create_unrolled_list);
+    RUN_TEST(test_unrolled_list_push_back);
+    RUN_TEST(test_unrolled_list_push_front);
+    RUN_TEST(test_unrolled_list_pop);
+    RUN_TEST(test_unrolled_list_mixed);
+    RUN_TEST(test_unrolled_list_find);
+    return UNITY_END();
+
+}